@@ -0,0 +1,79 @@
+/**
+ * @file instrumentation_bench.cpp
+ * Compares the wall time of player code under each instrumentation mode
+ */
+
+#include "drivers/player_driver.h"
+#include "instrumentation/player_loop.h"
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace drivers;
+
+/**
+ * Gets positions for the player loop to walk over
+ *
+ * @param[in]  num_positions  The number of positions
+ *
+ * @return     Flattened x, y pairs
+ */
+std::vector<int64_t> GetPositions(int64_t num_positions) {
+	std::mt19937_64 generator(42);
+	std::uniform_int_distribution<int64_t> distribution(-1000, 1000);
+
+	auto positions = std::vector<int64_t>(2 * num_positions);
+	for (auto &position : positions) {
+		position = distribution(generator);
+	}
+	return positions;
+}
+
+/**
+ * Gets the instruction count of one run of a player loop
+ */
+uint64_t GetInstructionCount(
+    const std::function<int64_t(const std::vector<int64_t> &)> &player_loop,
+    const std::vector<int64_t> &positions) {
+	PlayerDriver::ResetCount();
+	benchmark::DoNotOptimize(player_loop(positions));
+	return PlayerDriver::GetCount();
+}
+
+static void BM_CallMode(benchmark::State &state) {
+	auto positions = GetPositions(state.range(0));
+
+	for (auto _ : state) {
+		PlayerDriver::ResetCount();
+		benchmark::DoNotOptimize(PlayerLoop_call(positions));
+	}
+
+	state.counters["instructions"] =
+	    GetInstructionCount(PlayerLoop_call, positions);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CallMode)->Range(1 << 6, 1 << 16);
+
+static void BM_InlineMode(benchmark::State &state) {
+	auto positions = GetPositions(state.range(0));
+
+	// Both modes have to give the exact same counts
+	auto call_count = GetInstructionCount(PlayerLoop_call, positions);
+	auto inline_count = GetInstructionCount(PlayerLoop_inline, positions);
+	if (call_count != inline_count) {
+		state.SkipWithError("Instruction counts differ between modes");
+	}
+
+	for (auto _ : state) {
+		PlayerDriver::ResetCount();
+		benchmark::DoNotOptimize(PlayerLoop_inline(positions));
+	}
+
+	state.counters["instructions"] = inline_count;
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InlineMode)->Range(1 << 6, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,32 @@
+/**
+ * @file player_loop.cpp
+ * Player loop that's instrumented, built once per instrumentation mode with
+ * PLAYER_LOOP_NAME set to the name of the function to define
+ */
+
+#include "instrumentation/player_loop.h"
+
+int64_t PLAYER_LOOP_NAME(const std::vector<int64_t> &positions) {
+	int64_t closest_distance = INT64_MAX;
+	int64_t closest_index = 0;
+	int64_t checksum = 0;
+
+	for (size_t i = 0; i + 1 < positions.size(); i += 2) {
+		int64_t x = positions[i];
+		int64_t y = positions[i + 1];
+		int64_t distance = x * x + y * y;
+
+		if (distance < closest_distance) {
+			closest_distance = distance;
+			closest_index = i / 2;
+		}
+
+		if (x > y) {
+			checksum += x - y;
+		} else {
+			checksum ^= y;
+		}
+	}
+
+	return checksum + closest_index;
+}
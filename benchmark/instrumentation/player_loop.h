@@ -0,0 +1,28 @@
+/**
+ * @file player_loop.h
+ * Declarations for the player loop, instrumented in each mode
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A tight loop of the kind player code runs every turn. Walks the given
+ * positions, finds the one closest to the origin and sums up some
+ * branch dependent values along the way.
+ *
+ * The same source is compiled once per instrumentation mode
+ *
+ * @param[in]  positions  Flattened x, y pairs
+ *
+ * @return     Some value depending on every position
+ */
+int64_t PlayerLoop_call(const std::vector<int64_t> &positions);
+
+/**
+ * @see PlayerLoop_call
+ */
+int64_t PlayerLoop_inline(const std::vector<int64_t> &positions);
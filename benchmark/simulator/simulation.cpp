@@ -0,0 +1,393 @@
+/**
+ * @file simulation.cpp
+ * Defines the game the simulator benchmarks run
+ */
+
+#include "simulator/simulation.h"
+#include "constants/constants.h"
+#include "drivers/transfer_state.h"
+#include "simulator_constants/constants.h"
+#include "state/actor/factory.h"
+#include "state/actor/soldier.h"
+#include "state/actor/villager.h"
+#include "state/map/map.h"
+#include "state/path_planner/path_planner.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace state;
+
+namespace simulator_bench {
+
+namespace {
+
+// Seed for everything random about the benchmarked games, so that every run
+// plays the same games
+const uint64_t SEED = 42;
+
+// Gold mines in the first half of the map, which is mirrored onto the second
+const std::vector<Vec2D> GOLD_MINE_OFFSETS = {
+    Vec2D(4, 10), Vec2D(8, 20), Vec2D(12, 5), Vec2D(9, 13)};
+
+// Number of lakes in the first half of the map
+const int64_t NUM_LAKES = 12;
+
+// Number of turns a unit keeps to the same destination
+const int64_t TURNS_PER_DESTINATION = 20;
+
+/**
+ * Mirrors the first half of the terrain onto the second, so that both
+ * players see the same map
+ */
+void MirrorTerrain(std::vector<std::vector<TerrainType>> &terrain) {
+	for (int64_t x = 0; x < MAP_SIZE; ++x) {
+		for (int64_t y = 0; y < MAP_SIZE; ++y) {
+			if (x * MAP_SIZE + y >= TOTAL_MAP_TILES / 2) {
+				terrain[x][y] = terrain[MAP_SIZE - 1 - x][MAP_SIZE - 1 - y];
+			}
+		}
+	}
+}
+
+Vec2D FlipOffset(Vec2D offset) {
+	return Vec2D(MAP_SIZE - 1 - offset.x, MAP_SIZE - 1 - offset.y);
+}
+
+Vec2D GetTileCentre(Vec2D offset) {
+	return Vec2D(offset.x * ELEMENT_SIZE + ELEMENT_SIZE / 2,
+	             offset.y * ELEMENT_SIZE + ELEMENT_SIZE / 2);
+}
+} // namespace
+
+std::string GetMapLayoutName(MapLayout layout) {
+	switch (layout) {
+	case MapLayout::OPEN:
+		return "open";
+	case MapLayout::LAKES:
+		return "lakes";
+	case MapLayout::CORRIDORS:
+		return "corridors";
+	}
+	return "";
+}
+
+std::vector<std::vector<TerrainType>> BuildMapLayout(MapLayout layout) {
+	auto terrain = std::vector<std::vector<TerrainType>>(
+	    MAP_SIZE, std::vector<TerrainType>(MAP_SIZE, TerrainType::LAND));
+
+	switch (layout) {
+	case MapLayout::OPEN:
+		break;
+	case MapLayout::LAKES: {
+		std::mt19937_64 generator(SEED);
+		std::uniform_int_distribution<int64_t> centre(0, MAP_SIZE - 1);
+		std::uniform_int_distribution<int64_t> radius(1, 3);
+		for (int64_t i = 0; i < NUM_LAKES; ++i) {
+			// Lakes are only drawn on the first half, so that they're whole
+			// after mirroring
+			auto lake_x = centre(generator) / 2;
+			auto lake_y = centre(generator);
+			auto lake_radius = radius(generator);
+			for (int64_t x = std::max<int64_t>(lake_x - lake_radius, 0);
+			     x <= std::min<int64_t>(lake_x + lake_radius, MAP_SIZE - 1);
+			     ++x) {
+				for (int64_t y = std::max<int64_t>(lake_y - lake_radius, 0);
+				     y <=
+				     std::min<int64_t>(lake_y + lake_radius, MAP_SIZE - 1);
+				     ++y) {
+					terrain[x][y] = TerrainType::WATER;
+				}
+			}
+		}
+		break;
+	}
+	case MapLayout::CORRIDORS:
+		// Rows stop short of the middle, as a row next to its own mirror
+		// image, which has its gap on the other side, would cut the map in
+		// two
+		for (int64_t x = 2; x + 2 < MAP_SIZE - 1 - x; x += 4) {
+			auto gap = (x / 4) % 2 == 0 ? 0 : MAP_SIZE - 1;
+			for (int64_t y = 0; y < MAP_SIZE; ++y) {
+				if (y != gap) {
+					terrain[x][y] = TerrainType::WATER;
+				}
+			}
+		}
+		break;
+	}
+
+	for (auto offset : GOLD_MINE_OFFSETS) {
+		terrain[offset.x][offset.y] = TerrainType::GOLD_MINE;
+	}
+	MirrorTerrain(terrain);
+
+	return terrain;
+}
+
+std::shared_ptr<const PathGraph> GetPathGraph(MapLayout layout) {
+	static auto path_graphs =
+	    std::map<MapLayout, std::shared_ptr<const PathGraph>>{};
+
+	auto &path_graph = path_graphs[layout];
+	if (!path_graph) {
+		auto map = Map(BuildMapLayout(layout), MAP_SIZE, ELEMENT_SIZE);
+		path_graph = PathPlanner(&map).GetPathGraph();
+	}
+	return path_graph;
+}
+
+std::vector<Vec2D>
+GetLandOffsets(const std::vector<std::vector<TerrainType>> &terrain) {
+	auto land_offsets = std::vector<Vec2D>{};
+	for (int64_t x = 0; x < MAP_SIZE; ++x) {
+		for (int64_t y = 0; y < MAP_SIZE; ++y) {
+			if (terrain[x][y] == TerrainType::LAND) {
+				land_offsets.push_back(Vec2D(x, y));
+			}
+		}
+	}
+
+	std::shuffle(land_offsets.begin(), land_offsets.end(),
+	             std::mt19937_64(SEED));
+	return land_offsets;
+}
+
+CountingBuffer::CountingBuffer() : num_bytes(0) {}
+
+CountingBuffer::int_type CountingBuffer::overflow(int_type character) {
+	++num_bytes;
+	return traits_type::not_eof(character);
+}
+
+std::streamsize CountingBuffer::xsputn(const char *, std::streamsize count) {
+	num_bytes += count;
+	return count;
+}
+
+int64_t CountingBuffer::GetNumBytes() const { return num_bytes; }
+
+Simulation::Simulation(MapLayout layout, int64_t fill_percent,
+                       bool stream_game_log)
+    : state(nullptr), command_giver(nullptr), logger(), state_syncer(),
+      player_states(), destinations(), log_buffer(), log_stream(&log_buffer),
+      turn_no(0) {
+	Actor::SetActorIdIncrement();
+
+	auto terrain = BuildMapLayout(layout);
+	auto land_offsets = GetLandOffsets(terrain);
+	for (auto offset : land_offsets) {
+		destinations.push_back(GetTileCentre(offset));
+	}
+
+	auto map = std::make_unique<Map>(terrain, MAP_SIZE, ELEMENT_SIZE);
+	auto path_planner =
+	    std::make_unique<PathPlanner>(map.get(), GetPathGraph(layout));
+	auto gold_manager = std::make_unique<GoldManager>(
+	    std::array<int64_t, 2>{GOLD_START, GOLD_START}, GOLD_MAX,
+	    SOLDIER_KILL_REWARD_AMOUNT, VILLAGER_KILL_REWARD_AMOUNT,
+	    FACTORY_KILL_REWARD_AMOUNT, FACTORY_SUICIDE_PENALTY, VILLAGER_COST,
+	    SOLDIER_COST, FACTORY_COST, MINING_REWARD);
+	auto score_manager = std::make_unique<ScoreManager>(
+	    std::array<int64_t, 2>{0, 0}, score_constants::VILLAGER_KILL_REWARD,
+	    score_constants::SOLDIER_KILL_REWARD,
+	    score_constants::FACTORY_KILL_REWARD,
+	    score_constants::FACTORY_CONSTRUCTION_REWARD,
+	    score_constants::UNIT_AGE_LEVELS, score_constants::VILLAGER_AGE_REWARDS,
+	    score_constants::SOLDIER_AGE_REWARDS,
+	    score_constants::FACTORY_AGE_LEVELS,
+	    score_constants::FACTORY_AGE_REWARDS,
+	    score_constants::GOLD_REWARD_RATIO);
+
+	auto model_villager = Villager(
+	    0, PlayerId::PLAYER1, ActorType::VILLAGER, VILLAGER_MAX_HP,
+	    VILLAGER_MAX_HP, ACTOR_START_POSITIONS[0], gold_manager.get(),
+	    score_manager.get(), path_planner.get(), VILLAGER_SPEED,
+	    VILLAGER_ATTACK_RANGE, VILLAGER_ATTACK_DAMAGE, VILLAGER_BUILD_EFFORT,
+	    VILLAGER_BUILD_RANGE, VILLAGER_MINE_RANGE);
+	auto model_soldier =
+	    Soldier(0, PlayerId::PLAYER1, ActorType::SOLDIER, SOLDIER_MAX_HP,
+	            SOLDIER_MAX_HP, ACTOR_START_POSITIONS[0], gold_manager.get(),
+	            score_manager.get(), path_planner.get(), SOLDIER_SPEED,
+	            SOLDIER_ATTACK_RANGE, SOLDIER_ATTACK_DAMAGE);
+	auto model_factory = Factory(
+	    0, PlayerId::PLAYER1, ActorType::FACTORY, FACTORY_BASE_HP,
+	    FACTORY_MAX_HP, ACTOR_START_POSITIONS[0], gold_manager.get(),
+	    score_manager.get(), 0, FACTORY_CONSTRUCTION_TOTAL, ActorType::VILLAGER,
+	    FACTORY_VILLAGER_FREQUENCY, FACTORY_SOLDIER_FREQUENCY,
+	    UnitProductionCallback{});
+
+	auto soldiers = std::array<std::vector<std::unique_ptr<Soldier>>, 2>{};
+	auto villagers = std::array<std::vector<std::unique_ptr<Villager>>, 2>{};
+	auto factories = std::array<std::vector<std::unique_ptr<Factory>>, 2>{};
+
+	// Player 2's actors are where player 1's would be on the flipped map, so
+	// that neither player has it easier
+	size_t next_land_offset = 0;
+	auto get_positions = [&]() {
+		auto offset = land_offsets[next_land_offset++ % land_offsets.size()];
+		return std::array<DoubleVec2D, 2>{
+		    GetTileCentre(offset).to_double(),
+		    GetTileCentre(FlipOffset(offset)).to_double()};
+	};
+
+	for (size_t i = 0; i < MAX_NUM_SOLDIERS * fill_percent / 100; ++i) {
+		auto positions = get_positions();
+		for (int player_id = 0; player_id < 2; ++player_id) {
+			soldiers[player_id].push_back(std::make_unique<Soldier>(
+			    Actor::GetNextActorId(), static_cast<PlayerId>(player_id),
+			    ActorType::SOLDIER, SOLDIER_MAX_HP, SOLDIER_MAX_HP,
+			    positions[player_id], gold_manager.get(),
+			    score_manager.get(), path_planner.get(), SOLDIER_SPEED,
+			    SOLDIER_ATTACK_RANGE, SOLDIER_ATTACK_DAMAGE));
+		}
+	}
+
+	for (size_t i = 0; i < MAX_NUM_VILLAGERS * fill_percent / 100; ++i) {
+		auto positions = get_positions();
+		for (int player_id = 0; player_id < 2; ++player_id) {
+			villagers[player_id].push_back(std::make_unique<Villager>(
+			    Actor::GetNextActorId(), static_cast<PlayerId>(player_id),
+			    ActorType::VILLAGER, VILLAGER_MAX_HP, VILLAGER_MAX_HP,
+			    positions[player_id], gold_manager.get(),
+			    score_manager.get(), path_planner.get(), VILLAGER_SPEED,
+			    VILLAGER_ATTACK_RANGE, VILLAGER_ATTACK_DAMAGE,
+			    VILLAGER_BUILD_EFFORT, VILLAGER_BUILD_RANGE,
+			    VILLAGER_MINE_RANGE));
+		}
+	}
+
+	// Factories get tiles of their own, and produce nothing
+	auto produce_nothing = [](PlayerId, ActorType, DoubleVec2D) {};
+	next_land_offset = land_offsets.size() / 2;
+	for (size_t i = 0; i < MAX_NUM_FACTORIES * fill_percent / 100; ++i) {
+		auto positions = get_positions();
+		for (int player_id = 0; player_id < 2; ++player_id) {
+			factories[player_id].push_back(std::make_unique<Factory>(
+			    Actor::GetNextActorId(), static_cast<PlayerId>(player_id),
+			    ActorType::FACTORY, FACTORY_MAX_HP, FACTORY_MAX_HP,
+			    positions[player_id], gold_manager.get(),
+			    score_manager.get(), FACTORY_CONSTRUCTION_TOTAL,
+			    FACTORY_CONSTRUCTION_TOTAL,
+			    i % 2 == 0 ? ActorType::VILLAGER : ActorType::SOLDIER,
+			    FACTORY_VILLAGER_FREQUENCY, FACTORY_SOLDIER_FREQUENCY,
+			    produce_nothing));
+		}
+	}
+
+	auto main_state = std::make_unique<State>(
+	    std::move(map), std::move(gold_manager), std::move(score_manager),
+	    std::move(path_planner), std::move(soldiers), std::move(villagers),
+	    std::move(factories), std::move(model_villager),
+	    std::move(model_soldier), std::move(model_factory),
+	    INTEREST_THRESHOLD);
+	state = main_state.get();
+
+	logger = std::make_unique<logger::Logger>(
+	    state, PLAYER_INSTRUCTION_LIMIT_TURN, PLAYER_INSTRUCTION_LIMIT_GAME,
+	    SOLDIER_MAX_HP, VILLAGER_MAX_HP, FACTORY_MAX_HP, stream_game_log);
+	logger->BeginGame(log_stream);
+
+	auto main_command_giver =
+	    std::make_unique<CommandGiver>(state, logger.get());
+	command_giver = main_command_giver.get();
+	state_syncer = std::make_unique<StateSyncer>(
+	    std::move(main_command_giver), std::move(main_state), logger.get());
+}
+
+void Simulation::SyncPlayerStates() {
+	state_syncer->UpdatePlayerStates(player_states);
+}
+
+void Simulation::GiveOrders() {
+	auto destination_no = turn_no / TURNS_PER_DESTINATION;
+	auto get_destination = [&](size_t i) {
+		return destinations[(i + destination_no) % destinations.size()];
+	};
+
+	for (auto &player_state : player_states) {
+		// Every other soldier goes after an enemy soldier, the rest move
+		auto &enemy_soldiers = player_state.enemy_soldiers;
+		for (size_t i = 0; i < player_state.soldiers.size(); ++i) {
+			auto &soldier = player_state.soldiers[i];
+			if (i % 2 == 0 && !enemy_soldiers.empty()) {
+				soldier.attack(enemy_soldiers[i % enemy_soldiers.size()]);
+			} else {
+				soldier.move(get_destination(i));
+			}
+		}
+
+		// Villagers split between mining, attacking and moving
+		auto &gold_mines = player_state.gold_mine_offsets;
+		auto &enemy_villagers = player_state.enemy_villagers;
+		for (size_t i = 0; i < player_state.villagers.size(); ++i) {
+			auto &villager = player_state.villagers[i];
+			if (i % 3 == 0 && !gold_mines.empty()) {
+				villager.mine(gold_mines[i % gold_mines.size()]);
+			} else if (i % 3 == 1 && !enemy_villagers.empty()) {
+				villager.attack(enemy_villagers[i % enemy_villagers.size()]);
+			} else {
+				villager.move(get_destination(i));
+			}
+		}
+
+		for (auto &factory : player_state.factories) {
+			if (turn_no % TURNS_PER_DESTINATION == 0) {
+				factory.toggle_production();
+			}
+		}
+	}
+}
+
+void Simulation::RunCommands() {
+	command_giver->RunCommands(player_states, {false, false});
+}
+
+void Simulation::UpdateState() {
+	state->Update();
+	++turn_no;
+}
+
+void Simulation::LogState() { logger->LogState(); }
+
+void Simulation::PlayTurn() {
+	SyncPlayerStates();
+	for (auto &player_state : player_states) {
+		auto sent_state = transfer_state::ConvertToTransferState(player_state);
+		player_state = transfer_state::ConvertToPlayerState(sent_state);
+	}
+	GiveOrders();
+	state_syncer->UpdateMainState(player_states, {false, false});
+	++turn_no;
+	LogState();
+}
+
+void Simulation::WriteGame() {
+	auto scores = state->GetScores(true);
+	auto winner =
+	    scores[0] >= scores[1] ? PlayerId::PLAYER1 : PlayerId::PLAYER2;
+	logger->LogFinalGameParams(winner, false, scores);
+	logger->WriteGame(log_stream);
+}
+
+int64_t Simulation::GetTurnNo() const { return turn_no; }
+
+int64_t Simulation::GetNumActors() const {
+	int64_t num_actors = 0;
+	for (int player_id = 0; player_id < 2; ++player_id) {
+		num_actors += state->GetSoldiers()[player_id].size() +
+		              state->GetVillagers()[player_id].size() +
+		              state->GetFactories()[player_id].size();
+	}
+	return num_actors;
+}
+
+int64_t Simulation::GetLogBytes() const { return log_buffer.GetNumBytes(); }
+
+std::array<player_state::State, 2> &Simulation::GetPlayerStates() {
+	return player_states;
+}
+
+StateSyncer *Simulation::GetStateSyncer() { return state_syncer.get(); }
+} // namespace simulator_bench
@@ -0,0 +1,218 @@
+/**
+ * @file simulation.h
+ * Declarations for the game the simulator benchmarks run, with a scripted
+ * player in place of player code
+ */
+
+#pragma once
+
+#include "logger/logger.h"
+#include "physics/vector.hpp"
+#include "state/command_giver.h"
+#include "state/path_planner/path_graph.h"
+#include "state/player_state.h"
+#include "state/state.h"
+#include "state/state_syncer.h"
+#include "state/utilities.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace simulator_bench {
+
+/**
+ * Terrain the benchmarks are run on. Every layout looks the same to both
+ * players
+ */
+enum class MapLayout {
+	/**
+	 * All land, with a few gold mines
+	 */
+	OPEN,
+
+	/**
+	 * Land broken up by lakes of water
+	 */
+	LAKES,
+
+	/**
+	 * Rows of water with a single gap each, on alternating sides, so that
+	 * paths across the map are as long as they get
+	 */
+	CORRIDORS
+};
+
+/**
+ * Number of map layouts, for iterating over them
+ */
+const int64_t NUM_MAP_LAYOUTS = 3;
+
+/**
+ * Returns the name of a map layout, for benchmark labels
+ */
+std::string GetMapLayoutName(MapLayout layout);
+
+/**
+ * Builds the terrain of a map layout
+ */
+std::vector<std::vector<state::TerrainType>> BuildMapLayout(MapLayout layout);
+
+/**
+ * Returns the path graph of a map layout. It's only built the first time
+ * it's asked for
+ */
+std::shared_ptr<const state::PathGraph> GetPathGraph(MapLayout layout);
+
+/**
+ * Returns the offsets of every land tile in the terrain, in a fixed random
+ * order
+ */
+std::vector<Vec2D>
+GetLandOffsets(const std::vector<std::vector<state::TerrainType>> &terrain);
+
+/**
+ * Stream buffer that throws away what's written to it, only counting it
+ */
+class CountingBuffer : public std::streambuf {
+  private:
+	/**
+	 * Number of bytes written so far
+	 */
+	int64_t num_bytes;
+
+  protected:
+	int_type overflow(int_type character) override;
+
+	std::streamsize xsputn(const char *data, std::streamsize count) override;
+
+  public:
+	CountingBuffer();
+
+	/**
+	 * Returns the number of bytes written so far
+	 */
+	int64_t GetNumBytes() const;
+};
+
+/**
+ * A game between two scripted players, which every part of a turn can be run
+ * on separately
+ *
+ * Both players start with the given share of the most soldiers, villagers
+ * and factories they can have, spread over the land. Factories are built
+ * already, and produce nothing, so that the number of actors only changes
+ * as they get killed
+ */
+class Simulation {
+  private:
+	/**
+	 * The main state, owned by the state syncer
+	 */
+	state::State *state;
+
+	/**
+	 * The command giver, owned by the state syncer
+	 */
+	state::CommandGiver *command_giver;
+
+	/**
+	 * Logger of the game
+	 */
+	std::unique_ptr<logger::Logger> logger;
+
+	std::unique_ptr<state::StateSyncer> state_syncer;
+
+	/**
+	 * The state each player sees, and gives orders in
+	 */
+	std::array<player_state::State, 2> player_states;
+
+	/**
+	 * Centres of the land tiles, which the players move their units to
+	 */
+	std::vector<Vec2D> destinations;
+
+	/**
+	 * Where the game log is written to
+	 */
+	CountingBuffer log_buffer;
+
+	std::ostream log_stream;
+
+	/**
+	 * Number of turns the state has been updated for
+	 */
+	int64_t turn_no;
+
+  public:
+	/**
+	 * Constructor for Simulation
+	 *
+	 * @param[in]  layout          Terrain to play on
+	 * @param[in]  fill_percent    Percentage of the most actors of each kind
+	 *                             that each player starts with
+	 * @param[in]  stream_game_log true to stream the game log as the game
+	 *                             goes on, false to hold it whole
+	 */
+	Simulation(MapLayout layout, int64_t fill_percent, bool stream_game_log);
+
+	/**
+	 * Updates the players' states from the main state
+	 */
+	void SyncPlayerStates();
+
+	/**
+	 * Has both players order every one of their actors about
+	 */
+	void GiveOrders();
+
+	/**
+	 * Passes both players' orders to the main state
+	 */
+	void RunCommands();
+
+	/**
+	 * Updates the main state by a turn
+	 */
+	void UpdateState();
+
+	/**
+	 * Logs the main state
+	 */
+	void LogState();
+
+	/**
+	 * Plays a whole turn, the way the main driver does. The players' states
+	 * are sent through transfer states, like they are to player processes
+	 */
+	void PlayTurn();
+
+	/**
+	 * Writes out the rest of the game log
+	 */
+	void WriteGame();
+
+	/**
+	 * Returns the number of turns the state has been updated for
+	 */
+	int64_t GetTurnNo() const;
+
+	/**
+	 * Returns the number of actors both players have left
+	 */
+	int64_t GetNumActors() const;
+
+	/**
+	 * Returns the number of bytes of game log written so far
+	 */
+	int64_t GetLogBytes() const;
+
+	std::array<player_state::State, 2> &GetPlayerStates();
+
+	state::StateSyncer *GetStateSyncer();
+};
+} // namespace simulator_bench
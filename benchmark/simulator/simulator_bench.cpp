@@ -0,0 +1,389 @@
+/**
+ * @file simulator_bench.cpp
+ * Benchmarks the parts of the simulator that run every turn, and whole
+ * turns and games, over each map layout and up to the most actors each
+ * player can have
+ */
+
+#include "constants/constants.h"
+#include "drivers/transfer_state.h"
+#include "simulator/simulation.h"
+#include "simulator_constants/constants.h"
+#include "state/map/map.h"
+#include "state/path_planner/path_planner.h"
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace simulator_bench;
+
+namespace {
+
+// Turns after which a benchmarked game starts over, so that the players
+// don't run out of actors and whole game logs don't grow without bound
+const int64_t TURNS_PER_GAME = 100;
+
+// Number of paths looked up in each iteration of the path benchmarks
+const size_t NUM_PATH_QUERIES = 1024;
+
+// Number of games written out by the game log benchmark. Each takes a game
+// to be played first, which isn't timed, so letting the benchmark run until
+// enough time has been measured takes too long
+const int64_t WRITE_GAME_ITERATIONS = 20;
+
+// File results are written to as JSON, unless --benchmark_out says otherwise
+const auto DEFAULT_OUT_FILE = "simulator_bench.json";
+
+// Percentages of the most actors of each kind that players start with
+const std::vector<int64_t> FILL_PERCENTS = {25, 50, 100};
+
+MapLayout GetLayout(benchmark::State &bench_state) {
+	auto layout = static_cast<MapLayout>(bench_state.range(0));
+	bench_state.SetLabel(GetMapLayoutName(layout));
+	return layout;
+}
+
+/**
+ * Gets pairs of land offsets to find paths between
+ */
+std::vector<std::pair<Vec2D, Vec2D>> GetPathQueries(MapLayout layout) {
+	auto land_offsets = GetLandOffsets(BuildMapLayout(layout));
+
+	auto queries = std::vector<std::pair<Vec2D, Vec2D>>{};
+	for (size_t i = 0; i < NUM_PATH_QUERIES; ++i) {
+		queries.emplace_back(
+		    land_offsets[i % land_offsets.size()],
+		    land_offsets[(i * 7 + 3) % land_offsets.size()]);
+	}
+	return queries;
+}
+
+/**
+ * Starts the game over if it has gone on for long enough
+ */
+void RestartIfOver(std::unique_ptr<Simulation> &simulation, MapLayout layout,
+                   int64_t fill_percent, bool stream_game_log) {
+	if (simulation->GetTurnNo() == TURNS_PER_GAME) {
+		simulation = std::make_unique<Simulation>(layout, fill_percent,
+		                                          stream_game_log);
+	}
+}
+
+/**
+ * Gets both players' orders for the next turn, without running them
+ */
+void PrepareTurn(Simulation *simulation) {
+	simulation->SyncPlayerStates();
+	simulation->GiveOrders();
+}
+
+void SetActorCounters(benchmark::State &bench_state, int64_t fill_percent) {
+	bench_state.counters["actors"] =
+	    2 * (MAX_NUM_SOLDIERS + MAX_NUM_VILLAGERS + MAX_NUM_FACTORIES) *
+	    fill_percent / 100;
+}
+} // namespace
+
+static void BM_PathGraphPrecompute(benchmark::State &bench_state) {
+	auto map = state::Map(BuildMapLayout(GetLayout(bench_state)), MAP_SIZE,
+	                      ELEMENT_SIZE);
+
+	for (auto _ : bench_state) {
+		auto path_planner = state::PathPlanner(&map);
+		benchmark::DoNotOptimize(path_planner.GetPathGraph());
+	}
+}
+BENCHMARK(BM_PathGraphPrecompute)
+    ->DenseRange(0, NUM_MAP_LAYOUTS - 1)
+    ->ArgName("layout")
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_PathGraphGetNextNode(benchmark::State &bench_state) {
+	auto layout = GetLayout(bench_state);
+	auto path_graph = GetPathGraph(layout);
+	auto queries = GetPathQueries(layout);
+
+	for (auto _ : bench_state) {
+		for (auto const &query : queries) {
+			benchmark::DoNotOptimize(
+			    path_graph->GetNextNode(query.first, query.second));
+		}
+	}
+
+	bench_state.SetItemsProcessed(bench_state.iterations() * queries.size());
+}
+BENCHMARK(BM_PathGraphGetNextNode)
+    ->DenseRange(0, NUM_MAP_LAYOUTS - 1)
+    ->ArgName("layout");
+
+static void BM_PathPlannerGetNextPosition(benchmark::State &bench_state) {
+	auto layout = GetLayout(bench_state);
+	auto map = state::Map(BuildMapLayout(layout), MAP_SIZE, ELEMENT_SIZE);
+	auto path_planner = state::PathPlanner(&map, GetPathGraph(layout));
+
+	// Start and end off the centres of the tiles, the way units usually are
+	auto queries = std::vector<std::pair<DoubleVec2D, DoubleVec2D>>{};
+	for (auto const &query : GetPathQueries(layout)) {
+		queries.emplace_back(
+		    DoubleVec2D(query.first.x * ELEMENT_SIZE + 2,
+		                query.first.y * ELEMENT_SIZE + 7),
+		    DoubleVec2D(query.second.x * ELEMENT_SIZE + 6,
+		                query.second.y * ELEMENT_SIZE + 3));
+	}
+
+	for (auto _ : bench_state) {
+		for (auto const &query : queries) {
+			benchmark::DoNotOptimize(path_planner.GetNextPosition(
+			    query.first, query.second, SOLDIER_SPEED));
+		}
+	}
+
+	bench_state.SetItemsProcessed(bench_state.iterations() * queries.size());
+}
+BENCHMARK(BM_PathPlannerGetNextPosition)
+    ->DenseRange(0, NUM_MAP_LAYOUTS - 1)
+    ->ArgName("layout");
+
+static void BM_StateUpdate(benchmark::State &bench_state) {
+	auto layout = GetLayout(bench_state);
+	auto fill_percent = bench_state.range(1);
+	auto simulation =
+	    std::make_unique<Simulation>(layout, fill_percent, STREAM_GAME_LOG);
+
+	for (auto _ : bench_state) {
+		bench_state.PauseTiming();
+		RestartIfOver(simulation, layout, fill_percent, STREAM_GAME_LOG);
+		PrepareTurn(simulation.get());
+		simulation->RunCommands();
+		bench_state.ResumeTiming();
+
+		simulation->UpdateState();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+}
+BENCHMARK(BM_StateUpdate)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUM_MAP_LAYOUTS - 1, 1),
+                   FILL_PERCENTS})
+    ->ArgNames({"layout", "fill"});
+
+static void BM_CommandGiverRunCommands(benchmark::State &bench_state) {
+	auto layout = GetLayout(bench_state);
+	auto fill_percent = bench_state.range(1);
+	auto simulation =
+	    std::make_unique<Simulation>(layout, fill_percent, STREAM_GAME_LOG);
+
+	for (auto _ : bench_state) {
+		bench_state.PauseTiming();
+		RestartIfOver(simulation, layout, fill_percent, STREAM_GAME_LOG);
+		PrepareTurn(simulation.get());
+		bench_state.ResumeTiming();
+
+		simulation->RunCommands();
+
+		bench_state.PauseTiming();
+		simulation->UpdateState();
+		bench_state.ResumeTiming();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+}
+BENCHMARK(BM_CommandGiverRunCommands)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUM_MAP_LAYOUTS - 1, 1),
+                   FILL_PERCENTS})
+    ->ArgNames({"layout", "fill"});
+
+static void BM_StateSyncerUpdatePlayerStates(benchmark::State &bench_state) {
+	auto fill_percent = bench_state.range(0);
+	auto simulation = std::make_unique<Simulation>(
+	    MapLayout::OPEN, fill_percent, STREAM_GAME_LOG);
+	simulation->PlayTurn();
+
+	auto &player_states = simulation->GetPlayerStates();
+	for (auto _ : bench_state) {
+		simulation->GetStateSyncer()->UpdatePlayerStates(player_states);
+		benchmark::ClobberMemory();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+}
+BENCHMARK(BM_StateSyncerUpdatePlayerStates)
+    ->ArgsProduct({FILL_PERCENTS})
+    ->ArgName("fill");
+
+static void BM_ConvertToTransferState(benchmark::State &bench_state) {
+	auto fill_percent = bench_state.range(0);
+	auto simulation = std::make_unique<Simulation>(
+	    MapLayout::OPEN, fill_percent, STREAM_GAME_LOG);
+	simulation->PlayTurn();
+	simulation->SyncPlayerStates();
+
+	auto &player_state = simulation->GetPlayerStates()[0];
+	auto sent_state = std::make_unique<transfer_state::State>();
+	for (auto _ : bench_state) {
+		*sent_state = transfer_state::ConvertToTransferState(player_state);
+		benchmark::ClobberMemory();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+}
+BENCHMARK(BM_ConvertToTransferState)
+    ->ArgsProduct({FILL_PERCENTS})
+    ->ArgName("fill");
+
+static void BM_ConvertToPlayerState(benchmark::State &bench_state) {
+	auto fill_percent = bench_state.range(0);
+	auto simulation = std::make_unique<Simulation>(
+	    MapLayout::OPEN, fill_percent, STREAM_GAME_LOG);
+	simulation->PlayTurn();
+	simulation->SyncPlayerStates();
+
+	auto sent_state = std::make_unique<transfer_state::State>(
+	    transfer_state::ConvertToTransferState(
+	        simulation->GetPlayerStates()[0]));
+	auto player_state = player_state::State{};
+	for (auto _ : bench_state) {
+		player_state = transfer_state::ConvertToPlayerState(*sent_state);
+		benchmark::ClobberMemory();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+}
+BENCHMARK(BM_ConvertToPlayerState)
+    ->ArgsProduct({FILL_PERCENTS})
+    ->ArgName("fill");
+
+static void BM_LoggerLogState(benchmark::State &bench_state) {
+	auto fill_percent = bench_state.range(0);
+	auto stream_game_log = bench_state.range(1) != 0;
+	auto simulation = std::make_unique<Simulation>(
+	    MapLayout::OPEN, fill_percent, stream_game_log);
+
+	int64_t log_bytes = 0;
+	for (auto _ : bench_state) {
+		bench_state.PauseTiming();
+		if (simulation->GetTurnNo() == TURNS_PER_GAME) {
+			log_bytes += simulation->GetLogBytes();
+		}
+		RestartIfOver(simulation, MapLayout::OPEN, fill_percent,
+		              stream_game_log);
+		PrepareTurn(simulation.get());
+		simulation->RunCommands();
+		simulation->UpdateState();
+		bench_state.ResumeTiming();
+
+		simulation->LogState();
+	}
+	log_bytes += simulation->GetLogBytes();
+
+	SetActorCounters(bench_state, fill_percent);
+	if (stream_game_log) {
+		bench_state.counters["log_bytes_per_turn"] =
+		    benchmark::Counter(log_bytes, benchmark::Counter::kAvgIterations);
+	}
+}
+BENCHMARK(BM_LoggerLogState)
+    ->ArgsProduct({FILL_PERCENTS, {0, 1}})
+    ->ArgNames({"fill", "stream"});
+
+static void BM_LoggerWriteGame(benchmark::State &bench_state) {
+	auto fill_percent = bench_state.range(0);
+	auto stream_game_log = bench_state.range(1) != 0;
+
+	int64_t log_bytes = 0;
+	for (auto _ : bench_state) {
+		bench_state.PauseTiming();
+		auto simulation = std::make_unique<Simulation>(
+		    MapLayout::OPEN, fill_percent, stream_game_log);
+		for (int64_t turn = 0; turn < TURNS_PER_GAME; ++turn) {
+			simulation->PlayTurn();
+		}
+		bench_state.ResumeTiming();
+
+		simulation->WriteGame();
+
+		bench_state.PauseTiming();
+		log_bytes += simulation->GetLogBytes();
+		simulation.reset();
+		bench_state.ResumeTiming();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+	bench_state.counters["log_bytes"] =
+	    benchmark::Counter(log_bytes, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LoggerWriteGame)
+    ->ArgsProduct({FILL_PERCENTS, {0, 1}})
+    ->ArgNames({"fill", "stream"})
+    ->Iterations(WRITE_GAME_ITERATIONS)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_PlayTurn(benchmark::State &bench_state) {
+	auto layout = GetLayout(bench_state);
+	auto fill_percent = bench_state.range(1);
+	auto simulation =
+	    std::make_unique<Simulation>(layout, fill_percent, STREAM_GAME_LOG);
+
+	for (auto _ : bench_state) {
+		bench_state.PauseTiming();
+		RestartIfOver(simulation, layout, fill_percent, STREAM_GAME_LOG);
+		bench_state.ResumeTiming();
+
+		simulation->PlayTurn();
+	}
+
+	SetActorCounters(bench_state, fill_percent);
+}
+BENCHMARK(BM_PlayTurn)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUM_MAP_LAYOUTS - 1, 1),
+                   FILL_PERCENTS})
+    ->ArgNames({"layout", "fill"});
+
+static void BM_PlayGame(benchmark::State &bench_state) {
+	auto layout = GetLayout(bench_state);
+	auto fill_percent = bench_state.range(1);
+
+	for (auto _ : bench_state) {
+		auto simulation =
+		    std::make_unique<Simulation>(layout, fill_percent, STREAM_GAME_LOG);
+		for (int64_t turn = 0; turn < NUM_TURNS; ++turn) {
+			simulation->PlayTurn();
+		}
+		simulation->WriteGame();
+	}
+
+	bench_state.counters["turns_per_second"] = benchmark::Counter(
+	    NUM_TURNS * bench_state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PlayGame)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, NUM_MAP_LAYOUTS - 1, 1),
+                   {25, 100}})
+    ->ArgNames({"layout", "fill"})
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv) {
+	// Results are always written out as JSON too, so that runs can be
+	// compared, unless they're asked to go somewhere else
+	auto out_arg = std::string("--benchmark_out=") + DEFAULT_OUT_FILE;
+	auto args = std::vector<char *>(argv, argv + argc);
+	auto has_out_arg = std::any_of(args.begin(), args.end(), [](char *arg) {
+		return std::strncmp(arg, "--benchmark_out=", 16) == 0;
+	});
+	if (!has_out_arg) {
+		args.push_back(&out_arg[0]);
+	}
+
+	auto num_args = static_cast<int>(args.size());
+	benchmark::Initialize(&num_args, args.data());
+	if (benchmark::ReportUnrecognizedArguments(num_args, args.data())) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
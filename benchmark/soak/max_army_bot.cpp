@@ -0,0 +1,59 @@
+/**
+ * @file max_army_bot.cpp
+ * Defines a scripted player that keeps its whole army fighting
+ */
+
+#include "soak/max_army_bot.h"
+
+#include <vector>
+
+namespace simulator_soak {
+
+namespace {
+
+/**
+ * Orders a unit to attack the i-th of the first kind of enemy actor that has
+ * any left, returning false if the enemy has nothing left
+ */
+template <typename Unit>
+bool AttackEnemy(Unit &unit, size_t i, player_state::State &state) {
+	if (!state.enemy_soldiers.empty()) {
+		unit.attack(state.enemy_soldiers[i % state.enemy_soldiers.size()]);
+	} else if (!state.enemy_villagers.empty()) {
+		unit.attack(state.enemy_villagers[i % state.enemy_villagers.size()]);
+	} else if (!state.enemy_factories.empty()) {
+		unit.attack(state.enemy_factories[i % state.enemy_factories.size()]);
+	} else {
+		return false;
+	}
+	return true;
+}
+} // namespace
+
+player_state::State MaxArmyBot::Update(player_state::State state) {
+	for (size_t i = 0; i < state.soldiers.size(); ++i) {
+		AttackEnemy(state.soldiers[i], i, state);
+	}
+
+	// Villagers go for the enemy's villagers first, as they're a match for
+	// them, and mine once there's nothing left to fight
+	for (size_t i = 0; i < state.villagers.size(); ++i) {
+		auto &villager = state.villagers[i];
+		if (!state.enemy_villagers.empty()) {
+			villager.attack(
+			    state.enemy_villagers[i % state.enemy_villagers.size()]);
+		} else if (!AttackEnemy(villager, i, state) &&
+		           !state.gold_mine_offsets.empty()) {
+			villager.mine(
+			    state.gold_mine_offsets[i % state.gold_mine_offsets.size()]);
+		}
+	}
+
+	for (auto &factory : state.factories) {
+		factory.produce_soldiers();
+		factory.start();
+	}
+
+	return state;
+}
+} // namespace simulator_soak
@@ -0,0 +1,27 @@
+/**
+ * @file max_army_bot.h
+ * Declarations for a scripted player that keeps its whole army fighting
+ */
+
+#pragma once
+
+#include "state/player_state.h"
+
+namespace simulator_soak {
+
+/**
+ * Player that sends every one of its units after an enemy every turn, and
+ * keeps all its factories making soldiers, so that the simulator has as much
+ * pursuing and attacking to do as a game can have
+ *
+ * Units go after the enemy with the same index, which starts out where the
+ * unit would be on the flipped map, so most chases cross the whole map
+ */
+class MaxArmyBot {
+  public:
+	/**
+	 * Gives the turn's orders, the way player code does
+	 */
+	player_state::State Update(player_state::State state);
+};
+} // namespace simulator_soak
@@ -0,0 +1,282 @@
+/**
+ * @file simulator_soak.cpp
+ * Soaks the simulator at the heaviest load a game can put on it, with both
+ * players holding the most actors they can and sending all of them into the
+ * fight, and fails if turns take too long or the process takes too much
+ * memory
+ */
+
+#include "constants/constants.h"
+#include "drivers/transfer_state.h"
+#include "drivers/turn_profiler.h"
+#include "simulator/simulation.h"
+#include "simulator_constants/constants.h"
+#include "soak/max_army_bot.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace simulator_bench;
+using namespace simulator_soak;
+
+namespace {
+
+/**
+ * Limits the soak fails past, and what it plays
+ */
+struct SoakOptions {
+	MapLayout layout;
+
+	/**
+	 * Number of turns to play, over as many games as it takes
+	 */
+	int64_t num_turns;
+
+	/**
+	 * A new game is started once the players have fewer than this
+	 * percentage of the most actors they can have between them
+	 */
+	int64_t refill_percent;
+
+	bool stream_game_log;
+
+	/**
+	 * Limits on the 99th percentile and the longest turn, in milliseconds
+	 */
+	double max_turn_p99_ms;
+	double max_turn_ms;
+
+	/**
+	 * Limit on the peak resident set size of the process, in MiB
+	 */
+	int64_t max_rss_mib;
+};
+
+/**
+ * Options the soak runs with unless told otherwise. The longest turn may
+ * take the share of the game's duration each turn gets, and most turns must
+ * take well under that, as the players need time to think too.
+ */
+const SoakOptions DEFAULT_OPTIONS = {MapLayout::CORRIDORS,
+                                     5 * NUM_TURNS,
+                                     75,
+                                     STREAM_GAME_LOG,
+                                     GAME_DURATION_MS / NUM_TURNS / 5.0,
+                                     GAME_DURATION_MS / NUM_TURNS,
+                                     512};
+
+/**
+ * Percentiles of the turn latencies that are reported
+ */
+const std::vector<double> TURN_PERCENTILES = {50, 90, 99, 99.9};
+
+void PrintUsage(const char *program) {
+	std::cerr
+	    << "Usage: " << program << " [options]\n"
+	    << "  --layout=<open|lakes|corridors>  Map to play on (default "
+	    << GetMapLayoutName(DEFAULT_OPTIONS.layout) << ")\n"
+	    << "  --turns=<n>            Turns to play (default "
+	    << DEFAULT_OPTIONS.num_turns << ")\n"
+	    << "  --refill-percent=<n>   Start a new game once fewer than n% of "
+	       "the most actors are left (default "
+	    << DEFAULT_OPTIONS.refill_percent << ")\n"
+	    << "  --stream=<0|1>         Stream the game log (default "
+	    << DEFAULT_OPTIONS.stream_game_log << ")\n"
+	    << "  --max-turn-p99-ms=<ms> Fail if the 99th percentile turn is "
+	       "longer (default "
+	    << DEFAULT_OPTIONS.max_turn_p99_ms << ")\n"
+	    << "  --max-turn-ms=<ms>     Fail if any turn is longer (default "
+	    << DEFAULT_OPTIONS.max_turn_ms << ")\n"
+	    << "  --max-rss-mib=<n>      Fail if the peak resident set is larger "
+	       "(default "
+	    << DEFAULT_OPTIONS.max_rss_mib << ")\n";
+}
+
+/**
+ * Parses the command line options, returning false if any are invalid
+ */
+bool ParseOptions(int argc, char *argv[], SoakOptions &options) {
+	options = DEFAULT_OPTIONS;
+	for (int i = 1; i < argc; ++i) {
+		auto arg = std::string(argv[i]);
+		auto equals = arg.find('=');
+		if (arg.compare(0, 2, "--") != 0 || equals == std::string::npos) {
+			return false;
+		}
+		auto name = arg.substr(2, equals - 2);
+		auto value = arg.substr(equals + 1);
+
+		try {
+			if (name == "layout") {
+				auto found = false;
+				for (int64_t layout = 0; layout < NUM_MAP_LAYOUTS; ++layout) {
+					auto map_layout = static_cast<MapLayout>(layout);
+					if (GetMapLayoutName(map_layout) == value) {
+						options.layout = map_layout;
+						found = true;
+					}
+				}
+				if (!found) {
+					return false;
+				}
+			} else if (name == "turns") {
+				options.num_turns = std::stoll(value);
+			} else if (name == "refill-percent") {
+				options.refill_percent = std::stoll(value);
+			} else if (name == "stream") {
+				options.stream_game_log = std::stoll(value) != 0;
+			} else if (name == "max-turn-p99-ms") {
+				options.max_turn_p99_ms = std::stod(value);
+			} else if (name == "max-turn-ms") {
+				options.max_turn_ms = std::stod(value);
+			} else if (name == "max-rss-mib") {
+				options.max_rss_mib = std::stoll(value);
+			} else {
+				return false;
+			}
+		} catch (const std::logic_error &) {
+			return false;
+		}
+	}
+	return options.num_turns > 0;
+}
+
+/**
+ * Returns the most actors both players can have between them
+ */
+int64_t GetMaxNumActors() {
+	return 2 * (MAX_NUM_SOLDIERS + MAX_NUM_VILLAGERS + MAX_NUM_FACTORIES);
+}
+
+/**
+ * Returns the largest the resident set of the process has been, in bytes
+ */
+int64_t GetPeakRss() {
+	auto usage = rusage{};
+	getrusage(RUSAGE_SELF, &usage);
+	// Linux gives it in KiB
+	return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+}
+
+double ToMilliseconds(std::chrono::nanoseconds latency) {
+	return std::chrono::duration<double, std::milli>(latency).count();
+}
+
+/**
+ * Plays a turn the way the main driver does, with the bots in place of
+ * player processes, timing each phase
+ */
+void PlayTurn(Simulation &simulation, std::array<MaxArmyBot, 2> &bots,
+              drivers::TurnProfiler &turn_profiler,
+              drivers::LatencyHistogram &turn_latencies) {
+	using drivers::TurnPhase;
+
+	auto turn_start = drivers::TurnProfiler::Clock::now();
+	auto &player_states = simulation.GetPlayerStates();
+
+	auto phase_start = turn_start;
+	simulation.SyncPlayerStates();
+	phase_start =
+	    turn_profiler.RecordSince(TurnPhase::UPDATE_PLAYER_STATE, phase_start);
+
+	auto sent_states = std::array<transfer_state::State, 2>{};
+	for (int player_id = 0; player_id < 2; ++player_id) {
+		sent_states[player_id] =
+		    transfer_state::ConvertToTransferState(player_states[player_id]);
+		phase_start = turn_profiler.RecordSince(TurnPhase::TO_TRANSFER_STATE,
+		                                        phase_start);
+	}
+
+	auto player_turn_phases = std::array<TurnPhase, 2>{
+	    {TurnPhase::PLAYER_1_TURN, TurnPhase::PLAYER_2_TURN}};
+	for (int player_id = 0; player_id < 2; ++player_id) {
+		player_states[player_id] = bots[player_id].Update(
+		    transfer_state::ConvertToPlayerState(sent_states[player_id]));
+		phase_start = turn_profiler.RecordSince(player_turn_phases[player_id],
+		                                        phase_start);
+	}
+
+	simulation.RunCommands();
+	simulation.UpdateState();
+	phase_start =
+	    turn_profiler.RecordSince(TurnPhase::UPDATE_MAIN_STATE, phase_start);
+
+	simulation.LogState();
+	turn_profiler.RecordSince(TurnPhase::LOG_STATE, phase_start);
+
+	turn_profiler.RecordTurn(turn_start);
+	turn_latencies.Record(drivers::TurnProfiler::Clock::now() - turn_start);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+	auto options = SoakOptions{};
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage(argv[0]);
+		return 2;
+	}
+
+	auto turn_profiler = drivers::TurnProfiler();
+	auto turn_latencies = drivers::LatencyHistogram();
+	auto bots = std::array<MaxArmyBot, 2>{};
+
+	// Games start over once too many actors have been killed, or once they'd
+	// be over, so that the load stays near its heaviest
+	int64_t num_games = 0;
+	int64_t num_actor_turns = 0;
+	auto simulation = std::unique_ptr<Simulation>();
+	for (int64_t turn = 0; turn < options.num_turns; ++turn) {
+		if (!simulation || simulation->GetTurnNo() == NUM_TURNS ||
+		    simulation->GetNumActors() * 100 <
+		        GetMaxNumActors() * options.refill_percent) {
+			if (simulation) {
+				simulation->WriteGame();
+			}
+			simulation = std::make_unique<Simulation>(
+			    options.layout, 100, options.stream_game_log);
+			++num_games;
+		}
+		num_actor_turns += simulation->GetNumActors();
+		PlayTurn(*simulation, bots, turn_profiler, turn_latencies);
+	}
+	simulation->WriteGame();
+
+	std::cout << "SOAK " << GetMapLayoutName(options.layout) << " "
+	          << options.num_turns << " turns " << num_games << " games "
+	          << num_actor_turns / options.num_turns << " actors\n";
+	for (auto const &phase_latencies : turn_profiler.GetProfile()) {
+		std::cout << "PROFILE " << phase_latencies << '\n';
+	}
+	std::cout << "TURN_MS";
+	for (auto percentile : TURN_PERCENTILES) {
+		std::cout << " p" << percentile << "="
+		          << ToMilliseconds(turn_latencies.GetPercentile(percentile));
+	}
+	std::cout << " max=" << ToMilliseconds(turn_latencies.GetMax()) << '\n';
+	auto peak_rss_mib = GetPeakRss() / (1024 * 1024);
+	std::cout << "PEAK_RSS_MIB " << peak_rss_mib << '\n';
+
+	auto passed = true;
+	auto check = [&](const char *name, double value, double limit) {
+		if (value > limit) {
+			std::cout << "FAIL " << name << " " << value
+			          << " over the limit of " << limit << '\n';
+			passed = false;
+		}
+	};
+	check("turn p99 ms", ToMilliseconds(turn_latencies.GetPercentile(99)),
+	      options.max_turn_p99_ms);
+	check("turn max ms", ToMilliseconds(turn_latencies.GetMax()),
+	      options.max_turn_ms);
+	check("peak rss MiB", peak_rss_mib, options.max_rss_mib);
+
+	std::cout << (passed ? "PASS" : "FAIL") << std::endl;
+	return passed ? 0 : 1;
+}
@@ -64,7 +64,8 @@ struct DRIVERS_EXPORT GameResult {
 		RUNTIME_ERROR,
 
 		/**
-		 * One of the players timed out
+		 * One or both of the players ran out of time, either for a single
+		 * turn or for the whole game
 		 */
 		TIMEOUT,
 
@@ -7,14 +7,20 @@
 
 #include "drivers/drivers_export.h"
 #include "drivers/game_result.h"
+#include "drivers/memory_account.h"
 #include "drivers/shared_memory_utils/shared_buffer.h"
 #include "drivers/shared_memory_utils/shared_memory_main.h"
+#include "drivers/task_graph.h"
 #include "drivers/timer.h"
 #include "drivers/transfer_state.h"
+#include "drivers/turn_profiler.h"
 #include "logger/interfaces/i_logger.h"
 #include "state/interfaces/i_state_syncer.h"
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <fstream>
 #include <string>
 #include <thread>
 
@@ -40,11 +46,6 @@ class DRIVERS_EXPORT MainDriver {
 	 */
 	std::vector<SharedBuffer *> shared_buffers;
 
-	/**
-	 * Pointers to transfer state copies
-	 */
-	std::array<transfer_state::State *, 2> transfer_states;
-
 	/**
 	 * Current player states, that are being synced with main state
 	 */
@@ -63,11 +64,6 @@ class DRIVERS_EXPORT MainDriver {
 	 */
 	int64_t max_no_turns;
 
-	/**
-	 * Process IDs of the two player processes
-	 */
-	std::array<int, 2> process_pids;
-
 	/**
 	 * true if the game has timed out without completing and Start has been
 	 * called, false otherwise
@@ -87,11 +83,12 @@ class DRIVERS_EXPORT MainDriver {
 	Timer::Interval game_duration;
 
 	/**
-	 * Blocking function that runs the game
+	 * Time limit for a single player turn.
 	 *
-	 * @return     GameResult object with winner, win type, and player results
+	 * A player that takes longer than this to finish a turn forfeits the
+	 * game, and is left stuck in its turn for the caller to stop.
 	 */
-	const GameResult Run();
+	Timer::Interval turn_duration;
 
 	/**
 	 * Instance of logger to write game to log file
@@ -103,11 +100,167 @@ class DRIVERS_EXPORT MainDriver {
 	 */
 	std::string log_file_name;
 
+	/**
+	 * Game log file, open from the start of the game so that the logger can
+	 * stream turns into it
+	 */
+	std::ofstream log_file;
+
 	/**
 	 * Flag that is set to cancel the game
 	 */
 	std::atomic_bool cancel;
 
+	/**
+	 * If true, both players are released at the start of a turn and run
+	 * side by side. Otherwise player 2 only starts after player 1 is done.
+	 */
+	bool run_players_concurrently;
+
+	/**
+	 * Steps of a turn, which the game goes through in Resume
+	 */
+	enum class Phase {
+		/**
+		 * Nothing of the turn has happened yet
+		 */
+		START_TURN,
+
+		/**
+		 * The current player is about to be let go
+		 */
+		RELEASE_PLAYER,
+
+		/**
+		 * Waiting for the current player to finish its turn
+		 */
+		AWAIT_PLAYER,
+
+		/**
+		 * Both players are done, and their moves are to be applied
+		 */
+		END_TURN,
+
+		/**
+		 * The game is over, and the result is ready
+		 */
+		GAME_OVER
+	};
+
+	/**
+	 * Where the game is at
+	 */
+	Phase phase;
+
+	/**
+	 * Number of turns that have been completed
+	 */
+	int64_t turn_no;
+
+	/**
+	 * Player whose turn is being run or waited on
+	 */
+	int cur_player_id;
+
+	/**
+	 * Points in time by which each player must finish its current turn
+	 */
+	std::array<std::chrono::steady_clock::time_point, 2> turn_deadlines;
+
+	/**
+	 * True for a player that went past the turn instruction limit this
+	 * turn, so that its moves are skipped
+	 */
+	std::array<bool, 2> skip_player_turn;
+
+	/**
+	 * Results of the players so far
+	 */
+	std::array<PlayerResult, 2> player_results;
+
+	/**
+	 * Set when some player has gone past the game instruction limit, or took
+	 * too long over a turn
+	 */
+	bool instruction_count_exceeded, turn_duration_exceeded;
+
+	/**
+	 * Result of the game, valid once the phase is GAME_OVER
+	 */
+	GameResult game_result;
+
+	/**
+	 * Work done on the settled main state at the end of every turn. Each
+	 * player's state is derived and written to its transfer state, while
+	 * the main state is logged, all side by side.
+	 */
+	TaskGraph post_simulation_tasks;
+
+	/**
+	 * Times each phase of the turns
+	 */
+	TurnProfiler turn_profiler;
+
+	/**
+	 * Points in time the current turn, and each player's turn, started at
+	 */
+	TurnProfiler::Clock::time_point turn_start;
+	std::array<TurnProfiler::Clock::time_point, 2> player_turn_starts;
+
+	/**
+	 * Where each post simulation task started and ended this turn. Every
+	 * task only writes its own, and they're all recorded once the tasks are
+	 * done.
+	 */
+	std::array<TurnProfiler::Mark, 5> post_simulation_starts,
+	    post_simulation_ends;
+
+	/**
+	 * If true, the hardware events of each phase are counted along with its
+	 * time, where the kernel allows it
+	 */
+	bool count_perf_events;
+
+	/**
+	 * Memory each subsystem of the game holds
+	 */
+	MemoryAccount memory_account;
+
+	/**
+	 * Measures the memory of the subsystems that grow as the game goes on
+	 */
+	void MeasureMemory();
+
+	/**
+	 * Lets the current player run its turn, and starts its turn deadline
+	 */
+	void ReleasePlayer(int player_id);
+
+	/**
+	 * Checks on the current player. If its turn is over, takes its
+	 * instruction count and moves on to the next step.
+	 *
+	 * @return     false if the player is still running, true otherwise
+	 */
+	bool AwaitPlayer();
+
+	/**
+	 * Applies the players' moves once both are done, and checks whether the
+	 * game is over
+	 */
+	void EndTurn();
+
+	/**
+	 * Ends the trace spans of a turn that the game ends partway through,
+	 * those of the players still in their turn and the turn's own
+	 */
+	void EndTurnTrace();
+
+	/**
+	 * Sets the result and marks the game over
+	 */
+	void Finish(GameResult result);
+
 	/**
 	 * Return the game scores from the state syncer as a PlayerResults array
 	 *
@@ -133,21 +286,78 @@ class DRIVERS_EXPORT MainDriver {
 	           std::vector<std::unique_ptr<SharedMemoryMain>> shared_memories,
 	           int64_t player_instruction_limit_turn,
 	           int64_t player_instruction_limit_game, int64_t max_no_turns,
-	           Timer::Interval game_duration,
+	           Timer::Interval game_duration, Timer::Interval turn_duration,
 	           std::unique_ptr<logger::ILogger> logger,
-	           std::string log_file_name);
-
-	void SetPids(std::array<int, 2> pids);
+	           std::string log_file_name,
+	           bool run_players_concurrently = false,
+	           bool count_perf_events = false);
 
 	/**
 	 * Blocking function that starts the game.
 	 *
-	 * Calls MainDriver::Run after setting up.
+	 * Calls MainDriver::Begin, then MainDriver::Resume until the game is
+	 * over, waiting on the players in between.
 	 *
 	 * @return     GameResult object with winner, win type, and player results
 	 */
 	const GameResult Start();
 
+	/**
+	 * Sets up the shared memories and starts the game timer, without
+	 * running any turns
+	 */
+	void Begin();
+
+	/**
+	 * Runs the game for as long as it can go without blocking, which is up
+	 * to the point where it has to wait on a player, or to the end
+	 *
+	 * Waiting is left to the caller, which watches the buffer returned by
+	 * GetAwaitedBuffer until GetAwaitedDeadline, and resumes the game when
+	 * the buffer is notified. This lets a single thread drive many games.
+	 *
+	 * @return     true if the game is over, false otherwise
+	 */
+	bool Resume();
+
+	/**
+	 * Gets the buffer of the player that the game is waiting on
+	 *
+	 * @return     Buffer that is notified when the game can go on
+	 */
+	SharedBuffer *GetAwaitedBuffer();
+
+	/**
+	 * Gets the point in time by which the game must be resumed, even if
+	 * the awaited buffer isn't notified
+	 *
+	 * @return     Deadline of the awaited player's turn
+	 */
+	std::chrono::steady_clock::time_point GetAwaitedDeadline();
+
+	/**
+	 * Gets the result of a game that is over
+	 *
+	 * @return     GameResult object with winner, win type, and player results
+	 */
+	const GameResult GetResult();
+
+	/**
+	 * Gets how long each phase of the turns played so far took. It's also
+	 * logged at the end of the game.
+	 *
+	 * @return     Latencies of each phase that was timed
+	 */
+	logger::TurnProfile GetTurnProfile() const;
+
+	/**
+	 * Gets the current and peak memory each subsystem of the game holds, as
+	 * of the last turn. May be called from any thread while the game runs.
+	 *
+	 * @return     Memory of each subsystem
+	 */
+	MemoryReport GetMemoryReport() const;
+
 	/**
 	 * Cancels the execution of the main driver.
 	 *
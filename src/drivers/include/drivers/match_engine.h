@@ -0,0 +1,139 @@
+/**
+ * @file match_engine.h
+ * Declarations for an event loop that drives many games from one thread
+ */
+
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include "drivers/game_result.h"
+#include "drivers/main_driver.h"
+#include "drivers/shared_memory_utils/shared_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace drivers {
+
+/**
+ * Runs any number of games on the thread that calls Run
+ *
+ * Each game is a main driver that is resumed whenever the player it waits
+ * on hands its turn back. In between, the engine sleeps on the handoff
+ * futexes of all the games at once, so a game costs no thread of its own.
+ */
+class DRIVERS_EXPORT MatchEngine {
+  public:
+	/**
+	 * Called on the engine thread with the result of a game once it's over
+	 */
+	typedef std::function<void(const GameResult &)> Callback;
+
+	/**
+	 * Maximum number of futexes the engine sleeps on at once
+	 *
+	 * Games beyond this many are still checked on every handoff_wait_slice
+	 */
+	static const size_t max_wait_count = 128;
+
+  private:
+	/**
+	 * A game being run by the engine
+	 */
+	struct Match {
+		/**
+		 * Driver of the game
+		 */
+		MainDriver *driver;
+
+		/**
+		 * Called once the game is over
+		 */
+		Callback callback;
+
+		/**
+		 * Buffer the game was waiting on when it was last resumed
+		 */
+		SharedBuffer *awaited_buffer;
+
+		/**
+		 * Handoff sequence of the awaited buffer, read just before the game
+		 * was resumed
+		 */
+		uint32_t handoff_sequence;
+	};
+
+	/**
+	 * Games added since the engine last checked, guarded by
+	 * new_matches_lock
+	 */
+	std::vector<Match> new_matches;
+
+	/**
+	 * Guards new_matches
+	 */
+	std::mutex new_matches_lock;
+
+	/**
+	 * Games being run. Only touched from the engine thread.
+	 */
+	std::vector<Match> matches;
+
+	/**
+	 * Futex word, incremented to wake the engine up when a game is added or
+	 * the engine is stopped
+	 */
+	std::atomic<uint32_t> wake_sequence;
+
+	/**
+	 * Set to make Run return
+	 */
+	std::atomic_bool is_stopped;
+
+	/**
+	 * Sleeps until any of the awaited buffers or the wake sequence changes,
+	 * or until the deadline, whichever comes first
+	 *
+	 * @param[in]  wake_sequence  Wake sequence read before the games were
+	 *                            resumed
+	 * @param[in]  deadline       Point in time after which sleeping stops
+	 */
+	void WaitForHandoffs(uint32_t wake_sequence,
+	                     std::chrono::steady_clock::time_point deadline);
+
+	/**
+	 * Wakes up the engine thread
+	 */
+	void Wake();
+
+  public:
+	MatchEngine();
+
+	/**
+	 * Adds a game to the engine. Can be called from any thread.
+	 *
+	 * The engine begins the game itself, and calls the callback once it's
+	 * over. The driver must stay alive till then.
+	 *
+	 * @param[in]  driver    Driver of the game, which must not be started
+	 * @param[in]  callback  Called with the result of the game
+	 */
+	void Add(MainDriver *driver, Callback callback);
+
+	/**
+	 * Blocking function that runs the games until Stop is called
+	 *
+	 * Games that are still in progress when the engine stops are dropped,
+	 * without their callbacks being called
+	 */
+	void Run();
+
+	/**
+	 * Makes Run return. Can be called from any thread.
+	 */
+	void Stop();
+};
+} // namespace drivers
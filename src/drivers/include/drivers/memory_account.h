@@ -0,0 +1,137 @@
+/**
+ * @file memory_account.h
+ * Declarations for accounting the memory each subsystem of a game holds
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include "state/player_state.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace drivers {
+
+/**
+ * Subsystems of a game whose memory is accounted for
+ */
+enum class MemorySubsystem {
+	/**
+	 * The path planner, with its graph of the map and the paths cached in it
+	 */
+	PATH_CACHE,
+
+	/**
+	 * The actors of the main state, and the lists that hold them
+	 */
+	ACTORS,
+
+	/**
+	 * The game log, with the snapshots waiting to be logged
+	 */
+	GAME_LOG,
+
+	/**
+	 * The shared memory segments the players' states are passed through
+	 */
+	SHARED_MEMORY,
+
+	/**
+	 * The driver's copies of the players' states
+	 */
+	PLAYER_STATES
+};
+
+/**
+ * Number of subsystems whose memory is accounted for
+ */
+const size_t NUM_MEMORY_SUBSYSTEMS =
+    static_cast<size_t>(MemorySubsystem::PLAYER_STATES) + 1;
+
+/**
+ * Names of the subsystems, by subsystem
+ */
+DRIVERS_EXPORT extern const std::array<const char *, NUM_MEMORY_SUBSYSTEMS>
+    MEMORY_SUBSYSTEM_NAMES;
+
+/**
+ * Memory a subsystem holds
+ */
+struct DRIVERS_EXPORT SubsystemMemory {
+	/**
+	 * Name of the subsystem
+	 */
+	std::string subsystem;
+
+	/**
+	 * Bytes held as of the last measurement, and the most ever measured
+	 */
+	int64_t current_bytes, peak_bytes;
+};
+
+/**
+ * Memory each subsystem holds, in subsystem order
+ */
+typedef std::vector<SubsystemMemory> MemoryReport;
+
+/**
+ * Writes a subsystem's memory as its name, current bytes and peak bytes,
+ * separated by spaces
+ */
+DRIVERS_EXPORT std::ostream &operator<<(std::ostream &os,
+                                        const SubsystemMemory &memory);
+
+/**
+ * Keeps the current and peak bytes each subsystem of a game holds
+ *
+ * Subsystems don't allocate through the account. Instead their sizes are
+ * measured by whoever owns them, at points where they may have grown, and set
+ * here. Only one thread may set sizes, but any thread may get the report.
+ */
+class DRIVERS_EXPORT MemoryAccount {
+  private:
+	/**
+	 * Bytes each subsystem held as of its last measurement
+	 */
+	std::array<std::atomic<int64_t>, NUM_MEMORY_SUBSYSTEMS> current_bytes;
+
+	/**
+	 * Most bytes each subsystem was ever measured to hold
+	 */
+	std::array<std::atomic<int64_t>, NUM_MEMORY_SUBSYSTEMS> peak_bytes;
+
+  public:
+	MemoryAccount();
+
+	/**
+	 * Sets the bytes a subsystem holds, raising its peak if it's past it
+	 */
+	void Set(MemorySubsystem subsystem, int64_t bytes);
+
+	/**
+	 * Gets the bytes a subsystem holds, as of its last measurement
+	 */
+	int64_t Get(MemorySubsystem subsystem) const;
+
+	/**
+	 * Gets the current and peak bytes of every subsystem
+	 *
+	 * @return     Memory of each subsystem, in subsystem order
+	 */
+	MemoryReport GetReport() const;
+
+	/**
+	 * Forgets every size and peak, as for a new game
+	 */
+	void Reset();
+};
+
+/**
+ * Gets the memory a player state holds, with the storage of its lists
+ */
+DRIVERS_EXPORT int64_t GetPlayerStateBytes(const player_state::State &state);
+} // namespace drivers
@@ -0,0 +1,69 @@
+/**
+ * @file perf_counters.h
+ * Declarations for counting hardware events of a thread
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include "logger/turn_profile.h"
+#include <array>
+
+namespace drivers {
+
+/**
+ * Counts the instructions, cycles, cache misses and branch misses of the
+ * thread it was made on, with perf_event_open
+ *
+ * Counting is only done on Linux, and only if the kernel lets the process
+ * count its own events. Otherwise the counters are never open, and nothing
+ * else is affected.
+ */
+class DRIVERS_EXPORT PerfCounters {
+  private:
+	/**
+	 * Number of events counted
+	 */
+	static const int NUM_EVENTS = 4;
+
+	/**
+	 * File descriptors of the events, the first of which leads the group
+	 * they're read as. -1 if the counters aren't open.
+	 */
+	std::array<int, NUM_EVENTS> event_fds;
+
+  public:
+	/**
+	 * Starts counting the events of the calling thread, if it can
+	 */
+	PerfCounters();
+
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters &) = delete;
+
+	PerfCounters &operator=(const PerfCounters &) = delete;
+
+	/**
+	 * Returns true if the events are being counted, false if the kernel
+	 * doesn't allow it or has no such events
+	 */
+	bool IsOpen() const;
+
+	/**
+	 * Reads the counts since the counters were opened. If the counters had
+	 * to share the hardware with others, the counts are scaled up to the
+	 * time they were meant to run for.
+	 *
+	 * @param[out]  counts  The counts, left as is if they can't be read
+	 *
+	 * @return      true if the counts were read, false otherwise
+	 */
+	bool Read(logger::PhaseCounters &counts) const;
+
+	/**
+	 * Gets the counters of the calling thread, which are opened the first
+	 * time the thread asks for them
+	 */
+	static const PerfCounters &GetThreadCounters();
+};
+} // namespace drivers
@@ -26,6 +26,35 @@ class DRIVERS_EXPORT PlayerDriver {
 	 */
 	static std::atomic<uint64_t> instruction_count;
 
+	/**
+	 * Number of LLVM IR instructions executed by player code that was
+	 * instrumented in the inline mode
+	 *
+	 * The instrumentation adds to this directly, without a call or an atomic
+	 * operation. Only the player thread writes to it.
+	 */
+	static uint64_t inline_instruction_count;
+
+	/**
+	 * Number of times player code instrumented in the call mode has added to
+	 * the count. Only the player thread writes to it.
+	 */
+	static uint64_t num_increment_calls;
+
+	/**
+	 * Count beyond which the turn forfeits the game, read from shared memory
+	 * at the start of every turn
+	 *
+	 * Instrumented code compares the count against this at every point where
+	 * it's added to
+	 */
+	static uint64_t instruction_limit;
+
+	/**
+	 * The driver whose player code is running, if any
+	 */
+	static PlayerDriver *running_driver;
+
 	/**
 	 * An instance of the player code wrapper
 	 */
@@ -90,17 +119,39 @@ class DRIVERS_EXPORT PlayerDriver {
 	 */
 	int64_t max_debug_logs_turn_length;
 
+	/**
+	 * File to write the player's trace events to at the end of the game, or
+	 * empty if the player isn't traced
+	 */
+	std::string player_trace_file;
+
 	/**
 	 * Writes the count to shared memory
 	 */
 	void WriteCountToShm();
 
+	/**
+	 * Writes the player's debug logs to the debug log file
+	 */
+	void WriteDebugLogs();
+
+	/**
+	 * Writes the player's trace events to the trace file, if it's traced
+	 */
+	void WriteTraceEvents();
+
 	/**
 	 * Blocking function that runs the player's code
 	 */
 	void Run();
 
   public:
+	/**
+	 * Exit status of a player process that was stopped for going past the
+	 * instruction limit
+	 */
+	static const int exceeded_instruction_limit_exit_code = 3;
+
 	/**
 	 * Constructor
 	 *
@@ -115,6 +166,8 @@ class DRIVERS_EXPORT PlayerDriver {
 	 *                                          exceeded per turn limit
 	 * @param[in]  max_debug_logs_turn_length   Maxiumum length of debug logs
 	 *                                          per turn
+	 * @param[in]  player_trace_file            File to write trace events to,
+	 *                                          or empty to not trace the player
 	 */
 	PlayerDriver(
 	    std::unique_ptr<player_wrapper::PlayerCodeWrapper> player_code_wrapper,
@@ -122,21 +175,51 @@ class DRIVERS_EXPORT PlayerDriver {
 	    Timer::Interval game_duration, std::string player_debug_log_file,
 	    std::string debug_logs_turn_prefix,
 	    std::string debug_logs_truncate_message,
-	    int64_t max_debug_logs_turn_length);
+	    int64_t max_debug_logs_turn_length,
+	    std::string player_trace_file = "");
 
 	/**
 	 * Increment instruction_count by count
 	 *
+	 * Calls ExceedInstructionLimit if the count goes past instruction_limit
+	 *
 	 * @param  count  The count
 	 */
 	static void IncrementCount(uint64_t count);
 
 	/**
-	 * Gets the instruction_count
+	 * Stops the player, when instrumented code finds that the count has gone
+	 * past instruction_limit
+	 *
+	 * Player code can't be stopped midway through a turn and carried on
+	 * with, and the player has forfeited the game anyway. So this writes the
+	 * count to shared memory, hands the turn back to the main driver and
+	 * saves the debug logs, then exits the process with
+	 * exceeded_instruction_limit_exit_code.
+	 */
+	[[noreturn]] static void ExceedInstructionLimit();
+
+	/**
+	 * Gets the number of instructions executed, by player code instrumented
+	 * in either mode
 	 *
 	 * @return     The count.
 	 */
-	uint64_t GetCount();
+	static uint64_t GetCount();
+
+	/**
+	 * Gets the number of calls to IncrementCount, which shows how often the
+	 * instrumentation adds to the count
+	 *
+	 * @return     The number of calls.
+	 */
+	static uint64_t GetNumIncrementCalls();
+
+	/**
+	 * Sets the number of instructions executed, and of calls to
+	 * IncrementCount, back to zero
+	 */
+	static void ResetCount();
 
 	/**
 	 * Starts the player's AI code in a loop
@@ -42,9 +42,15 @@ struct DRIVERS_EXPORT PlayerResult {
 		RUNTIME_ERROR,
 
 		/**
-		 * A player took too long to finish their turn
+		 * The game ran out of time while the player was running its turn
 		 */
-		TIMEOUT
+		TIMEOUT,
+
+		/**
+		 * The player didn't finish a turn within the turn duration, and thus
+		 * forfeited the game
+		 */
+		EXCEEDED_TURN_DURATION
 	};
 
 	/**
@@ -76,6 +82,9 @@ operator<<(std::ostream &ostream, const PlayerResult::Status &status) {
 	case PlayerResult::Status::TIMEOUT:
 		ostream << "TIMEOUT";
 		break;
+	case PlayerResult::Status::EXCEEDED_TURN_DURATION:
+		ostream << "EXCEEDED_TURN_DURATION";
+		break;
 	}
 	return ostream;
 }
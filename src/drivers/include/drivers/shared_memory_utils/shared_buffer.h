@@ -7,36 +7,157 @@
 
 #include "drivers/drivers_export.h"
 #include "drivers/transfer_state.h"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 
 namespace drivers {
 
+/**
+ * Size of a cache line on the targeted hosts
+ */
+const size_t CACHE_LINE_SIZE = 64;
+
 /**
  * Struct for using as buffer in shared memory
+ *
+ * Every control field sits on a cache line of its own, away from the bulk
+ * transfer states, so polling the flags doesn't contend with state writes.
+ * The transfer state is double buffered. The player works on the front
+ * copy, while the main driver fills the back copy and then swaps the two.
  */
 struct DRIVERS_EXPORT SharedBuffer {
 	SharedBuffer(bool is_player_running, bool is_game_complete,
 	             int64_t instruction_counter,
 	             const transfer_state::State &transfer_state);
 
+	/**
+	 * Number of times a waiter polls its condition before going to sleep
+	 *
+	 * Spinning is skipped on single core hosts, where it only delays the
+	 * process that we're waiting on
+	 */
+	static const int64_t handoff_spin_count = 1000;
+
+	/**
+	 * Maximum time a waiter sleeps before checking its condition again
+	 *
+	 * Bounds the latency of noticing changes that weren't followed by a
+	 * Notify, like local timeout or cancellation flags
+	 */
+	static const std::chrono::microseconds handoff_wait_slice;
+
 	/**
 	 * True if the player process is executing its turn, false otherwise
 	 */
-	std::atomic_bool is_player_running;
+	alignas(CACHE_LINE_SIZE) std::atomic_bool is_player_running;
 
 	/**
 	 * True if the game is over by early deathmatch, false otherwise
 	 */
-	std::atomic_bool is_game_complete;
+	alignas(CACHE_LINE_SIZE) std::atomic_bool is_game_complete;
 
 	/**
 	 * Count of the number of instructions executed in the present turn
 	 */
-	std::atomic<int64_t> instruction_counter;
+	alignas(CACHE_LINE_SIZE) std::atomic<int64_t> instruction_counter;
+
+	/**
+	 * Instruction count beyond which a turn forfeits the game. The player
+	 * stops as soon as it gets past this, instead of finishing the turn.
+	 *
+	 * Set by the main driver before the game starts, no limit by default
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic<int64_t> instruction_limit;
+
+	/**
+	 * Futex word, incremented every time one side notifies the other
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> handoff_sequence;
+
+	/**
+	 * Number of processes currently sleeping on handoff_sequence
+	 *
+	 * Lets Notify skip the wake up system call when nobody is waiting
+	 */
+	std::atomic<uint32_t> num_waiters;
+
+	/**
+	 * Index of the front copy in transfer_states
+	 */
+	alignas(CACHE_LINE_SIZE) std::atomic<int32_t> front_index;
+
+	/**
+	 * Front and back copies of the player's state with limited information
+	 */
+	alignas(CACHE_LINE_SIZE) std::array<transfer_state::State, 2>
+	    transfer_states;
+
+	/**
+	 * Gets the copy of the state that the player reads and writes
+	 *
+	 * @return     The front transfer state
+	 */
+	transfer_state::State &GetFrontTransferState();
+
+	/**
+	 * Gets the copy of the state that the player isn't using
+	 *
+	 * @return     The back transfer state
+	 */
+	transfer_state::State &GetBackTransferState();
+
+	/**
+	 * Makes the back copy the front one, and vice versa
+	 *
+	 * Must only be called while the player isn't running
+	 */
+	void SwapTransferStates();
+
+	/**
+	 * Sets is_player_running and wakes up the other side
+	 *
+	 * @param[in]  is_player_running  New value of the flag
+	 */
+	void SetPlayerRunning(bool is_player_running);
+
+	/**
+	 * Sets is_game_complete and wakes up the other side
+	 *
+	 * @param[in]  is_game_complete  New value of the flag
+	 */
+	void SetGameComplete(bool is_game_complete);
+
+	/**
+	 * Wakes up all processes blocked in Wait on this buffer
+	 */
+	void Notify();
+
+	/**
+	 * Blocks until condition returns true
+	 *
+	 * Spins for a short while first, as the other side usually responds
+	 * within microseconds. Then sleeps on a futex till notified, waking up
+	 * every handoff_wait_slice to check the condition again.
+	 *
+	 * @param[in]  condition  Returns true when the wait is over
+	 */
+	void Wait(const std::function<bool()> &condition);
 
 	/**
-	 * Player's copy of the state with limited information
+	 * Blocks until condition returns true or the deadline passes
+	 *
+	 * Same as Wait above, but gives up once the deadline is reached
+	 *
+	 * @param[in]  condition  Returns true when the wait is over
+	 * @param[in]  deadline   Point in time after which waiting stops
+	 *
+	 * @return     true if the condition was met, false if the wait timed out
 	 */
-	transfer_state::State transfer_state;
+	bool Wait(const std::function<bool()> &condition,
+	          std::chrono::steady_clock::time_point deadline);
 };
 } // namespace drivers
@@ -7,15 +7,21 @@
 
 #define BOOST_DATE_TIME_NO_LIB
 
-#include "boost/interprocess/managed_shared_memory.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "boost/interprocess/shared_memory_object.hpp"
 #include "drivers/drivers_export.h"
 #include "drivers/shared_memory_utils/shared_buffer.h"
 #include "drivers/transfer_state.h"
+#include "state/player_state.h"
 
 namespace drivers {
 
 /**
  * Wrapper for shared memory owner
+ *
+ * The segment holds a single SharedBuffer at its page aligned start, followed
+ * by the path tables on the next page boundary, each rounded up to whole
+ * pages. Players map the path tables read only.
  */
 class DRIVERS_EXPORT SharedMemoryMain {
   private:
@@ -24,28 +30,55 @@ class DRIVERS_EXPORT SharedMemoryMain {
 	 */
 	std::string shared_memory_name;
 
+	/**
+	 * Shared memory object backing the buffer
+	 */
+	boost::interprocess::shared_memory_object shared_memory;
+
 	/**
 	 * Mapped region to write to and read from
 	 */
-	boost::interprocess::managed_shared_memory shared_memory;
+	boost::interprocess::mapped_region region;
 
   public:
 	/**
 	 * Creates new shm with given name
 	 *
+	 * All pages of the segment are written to before this returns, so no
+	 * page faults are taken later during the game. Transparent huge pages
+	 * are requested for the mapping where the kernel supports them.
+	 *
 	 * @param[in]  shared_memory_name  The shared memory name
+	 * @param[in]  path_tables         Paths of the game's map to share with
+	 *                                 the player, or null to share no paths
 	 *
 	 * @throw      std::exception      If shm already exists
 	 */
 	SharedMemoryMain(std::string shared_memory_name, bool is_player_running,
 	                 bool is_game_complete, int64_t instruction_counter,
-	                 const transfer_state::State &transfer_state);
+	                 const transfer_state::State &transfer_state,
+	                 const player_state::PathTables *path_tables = nullptr);
 
 	/**
 	 * Removes shm
 	 */
 	~SharedMemoryMain();
 
+	/**
+	 * Gets the size that a segment holding a SharedBuffer and the path
+	 * tables needs
+	 *
+	 * @return     Size in bytes, a multiple of the page size
+	 */
+	static size_t GetSegmentSize();
+
+	/**
+	 * Gets where the path tables start in the segment
+	 *
+	 * @return     Offset in bytes, a multiple of the page size
+	 */
+	static size_t GetPathTablesOffset();
+
 	/**
 	 * Gets pointer to shared memory
 	 *
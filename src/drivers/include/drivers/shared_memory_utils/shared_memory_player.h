@@ -7,9 +7,11 @@
 
 #define BOOST_DATE_TIME_NO_LIB
 
-#include "boost/interprocess/managed_shared_memory.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "boost/interprocess/shared_memory_object.hpp"
 #include "drivers/drivers_export.h"
 #include "drivers/shared_memory_utils/shared_buffer.h"
+#include "state/player_state.h"
 
 namespace drivers {
 
@@ -18,15 +20,27 @@ namespace drivers {
  */
 class DRIVERS_EXPORT SharedMemoryPlayer {
   private:
+	/**
+	 * Shared memory object backing the buffer
+	 */
+	boost::interprocess::shared_memory_object shared_memory;
+
 	/**
 	 * Mapped region to write to and read from
 	 */
-	boost::interprocess::managed_shared_memory shared_memory;
+	boost::interprocess::mapped_region region;
+
+	/**
+	 * Read only mapping of the path tables, after the buffer
+	 */
+	boost::interprocess::mapped_region path_tables_region;
 
   public:
 	/**
 	 * Opens existing shm with given name
 	 *
+	 * The mapping is faulted in before this returns
+	 *
 	 * @param[in]  shared_memory_name  The shared memory name
 	 *
 	 * @throw      std::exception      If shm doesn't already exist
@@ -39,5 +53,13 @@ class DRIVERS_EXPORT SharedMemoryPlayer {
 	 * @return     The pointer
 	 */
 	SharedBuffer *GetBuffer();
+
+	/**
+	 * Gets the path tables of the game's map. Writing to them kills the
+	 * process.
+	 *
+	 * @return     The pointer
+	 */
+	const player_state::PathTables *GetPathTables() const;
 };
 } // namespace drivers
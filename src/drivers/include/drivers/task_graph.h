@@ -0,0 +1,124 @@
+/**
+ * @file task_graph.h
+ * Declarations for a graph of dependent tasks that is run as a whole
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include "drivers/task_pool.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace drivers {
+
+/**
+ * A fixed set of tasks, where some tasks may only start once others are done
+ *
+ * The graph is built once, and then run as many times as needed. Every run
+ * goes through all the tasks, running independent ones side by side on a
+ * task pool, and returns once they're all done.
+ */
+class DRIVERS_EXPORT TaskGraph {
+  public:
+	/**
+	 * Task to run. Tasks must not throw.
+	 */
+	typedef std::function<void(void)> Function;
+
+	/**
+	 * Handle to a task in the graph, used to depend on it
+	 */
+	typedef size_t TaskId;
+
+  private:
+	/**
+	 * A single task and its place in the graph
+	 */
+	struct Task {
+		Function function;
+
+		/**
+		 * Tasks that depend on this one
+		 */
+		std::vector<TaskId> dependents;
+
+		/**
+		 * Number of tasks this one depends on
+		 */
+		size_t num_dependencies;
+
+		/**
+		 * Number of dependencies not yet done in the current run
+		 */
+		std::atomic<size_t> num_pending_dependencies;
+	};
+
+	/**
+	 * All the tasks, in the order they were added
+	 */
+	std::vector<std::unique_ptr<Task>> tasks;
+
+	/**
+	 * Pool that the tasks are run on
+	 */
+	TaskPool *pool;
+
+	/**
+	 * Number of tasks not yet done in the current run. It's only counted
+	 * down while mutex is held.
+	 */
+	std::atomic<size_t> num_unfinished_tasks;
+
+	/**
+	 * Guards done, and the count of unfinished tasks going down
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Signalled when the last task of a run is done
+	 */
+	std::condition_variable done;
+
+	/**
+	 * Runs a task, then the tasks that it was the last dependency of. One of
+	 * those is run right away on the same thread, the rest on the pool.
+	 *
+	 * @param[in]  task_id  The task to run
+	 */
+	void RunTask(TaskId task_id);
+
+  public:
+	/**
+	 * Constructor for TaskGraph
+	 *
+	 * @param[in]  pool  Pool that the tasks are run on
+	 */
+	explicit TaskGraph(TaskPool &pool = TaskPool::GetInstance());
+
+	/**
+	 * Adds a task to the graph
+	 *
+	 * @param[in]  function      The task to run
+	 * @param[in]  dependencies  Tasks that must be done before this one
+	 *                           starts, all of which must be in the graph
+	 *                           already
+	 *
+	 * @return     Handle to the task
+	 */
+	TaskId AddTask(Function function,
+	               const std::vector<TaskId> &dependencies = {});
+
+	/**
+	 * Blocking function that runs every task in the graph once
+	 *
+	 * The calling thread runs tasks too. Without pool workers, the tasks are
+	 * run one after the other in the order they were added.
+	 */
+	void Run();
+};
+} // namespace drivers
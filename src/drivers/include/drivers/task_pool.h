@@ -0,0 +1,107 @@
+/**
+ * @file task_pool.h
+ * Declarations for a process wide pool of worker threads
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace drivers {
+
+/**
+ * Runs short tasks on a fixed set of worker threads
+ *
+ * Tasks are taken off a single queue, in the order they were submitted.
+ * Threads that are waiting on submitted tasks can run queued tasks
+ * themselves with RunPending, instead of sitting idle.
+ */
+class DRIVERS_EXPORT TaskPool {
+  public:
+	/**
+	 * Task to run. Tasks must not throw.
+	 */
+	typedef std::function<void(void)> Task;
+
+  private:
+	/**
+	 * Tasks waiting for a thread
+	 */
+	std::deque<Task> queue;
+
+	/**
+	 * true once the pool is being destroyed
+	 */
+	bool is_stopping;
+
+	/**
+	 * Guards all of the above
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Wakes up the workers when tasks are submitted or on shutdown
+	 */
+	std::condition_variable wake_up;
+
+	/**
+	 * Threads that run the tasks
+	 */
+	std::vector<std::thread> workers;
+
+	/**
+	 * Body of the worker threads
+	 */
+	void Run();
+
+  public:
+	/**
+	 * Constructor for TaskPool. Starts the worker threads.
+	 *
+	 * @param[in]  num_workers  The number of worker threads
+	 */
+	explicit TaskPool(size_t num_workers);
+
+	/**
+	 * Stops the worker threads once the queued tasks are done
+	 */
+	~TaskPool();
+
+	/**
+	 * Gets the pool shared by the whole process
+	 *
+	 * It has a worker for every core but the one the caller runs on, and no
+	 * workers at all on single core hosts.
+	 *
+	 * @return     The task pool instance
+	 */
+	static TaskPool &GetInstance();
+
+	/**
+	 * Gets the number of worker threads
+	 *
+	 * @return     Number of workers, 0 if tasks are never run in parallel
+	 */
+	size_t GetNumWorkers() const;
+
+	/**
+	 * Queues a task to be run on some worker
+	 *
+	 * @param[in]  task  The task to run
+	 */
+	void Submit(Task task);
+
+	/**
+	 * Runs the oldest queued task, if any, on the calling thread
+	 *
+	 * @return     true if a task was run, false if the queue was empty
+	 */
+	bool RunPending();
+};
+} // namespace drivers
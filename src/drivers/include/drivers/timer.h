@@ -5,16 +5,19 @@
 #pragma once
 
 #include "drivers/drivers_export.h"
+#include "drivers/timer_service.h"
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
-#include <thread>
 
 namespace drivers {
 
 /**
  * An asynchronous timer class
+ *
+ * Timers don't own a thread, they're all run by the process wide
+ * TimerService
  */
 class DRIVERS_EXPORT Timer {
   private:
@@ -24,24 +27,11 @@ class DRIVERS_EXPORT Timer {
 	std::atomic_bool is_running;
 
 	/**
-	 * Temporary used by the Cancel method
-	 *
-	 * Set to true by Cancel, and reset to false right before Cancel returns
-	 */
-	std::atomic_bool cancel;
-
-	/**
-	 * Amount of time the timer has been running for
+	 * Handle to this timer in the timer service
 	 *
 	 * Valid if is_running is true
 	 */
-	std::chrono::milliseconds cur_duration;
-
-	/**
-	 * Timer wakes up every timer_wake_up_duration ms to check if it has been
-	 * cancelled
-	 */
-	std::chrono::milliseconds timer_wake_up_duration;
+	std::atomic<TimerService::TimerId> timer_id;
 
   public:
 	/**
@@ -59,11 +49,14 @@ class DRIVERS_EXPORT Timer {
 	 */
 	Timer();
 
+	/**
+	 * Destructor. Cancels the timer if it's still running.
+	 */
+	~Timer();
+
 	/**
 	 * Starts this timer. Works only if is_running is false.
 	 *
-	 * Spawns a separate thread for the timer
-	 *
 	 * @param[in]  total_timer_duration  The total timer duration
 	 * @param[in]  callback              The callback when timer expires
 	 *
@@ -74,9 +67,8 @@ class DRIVERS_EXPORT Timer {
 	/**
 	 * Method to cancel the timer
 	 *
-	 * Cancelled timer won't call callback unless it's very close to expiring
-	 * already.
-	 * Blocks for at most timer_wake_up_duration ms
+	 * Cancelled timer won't call callback. Only blocks if the callback is
+	 * running at that moment, until it returns.
 	 */
 	void Cancel();
 };
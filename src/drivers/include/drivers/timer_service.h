@@ -0,0 +1,194 @@
+/**
+ * @file timer_service.h
+ * Declarations for a process wide timer service
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace drivers {
+
+/**
+ * Runs the callbacks of any number of timers from a single thread
+ *
+ * Timers are kept in a hashed timing wheel, so scheduling and cancelling a
+ * timer are both O(1). Deadlines are measured against the monotonic clock,
+ * and the service thread sleeps on a condition variable until the next
+ * occupied slot of the wheel is due.
+ */
+class DRIVERS_EXPORT TimerService {
+  public:
+	/**
+	 * Monotonic clock that all deadlines are measured with
+	 */
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	 * Callback to call when a timer expires
+	 */
+	typedef std::function<void(void)> Callback;
+
+	/**
+	 * Handle to a scheduled timer, used to cancel it
+	 */
+	typedef uint64_t TimerId;
+
+	/**
+	 * Id that never refers to a scheduled timer
+	 */
+	static const TimerId null_timer_id = 0;
+
+  private:
+	/**
+	 * A single scheduled timer
+	 */
+	struct TimerEntry {
+		TimerId id;
+
+		/**
+		 * Tick at or after which this timer fires
+		 */
+		int64_t expiry_tick;
+
+		Callback callback;
+	};
+
+	/**
+	 * Duration of one tick of the wheel. Timers fire at tick boundaries.
+	 */
+	Clock::duration tick_duration;
+
+	/**
+	 * Slots of the wheel. A timer expiring at tick t sits in slot t % size.
+	 */
+	std::vector<std::list<TimerEntry>> wheel;
+
+	/**
+	 * Position of every scheduled timer in the wheel
+	 */
+	std::unordered_map<TimerId, std::list<TimerEntry>::iterator> timers;
+
+	/**
+	 * Time at which tick 0 started
+	 */
+	Clock::time_point start_time;
+
+	/**
+	 * First tick that the service thread hasn't processed yet
+	 */
+	int64_t current_tick;
+
+	/**
+	 * Id to give to the next scheduled timer
+	 */
+	TimerId next_timer_id;
+
+	/**
+	 * Id of the timer whose callback is running right now, null_timer_id if
+	 * none is
+	 */
+	TimerId running_timer_id;
+
+	/**
+	 * true once the service is being destroyed
+	 */
+	bool is_stopping;
+
+	/**
+	 * Guards all of the above
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Wakes up the service thread when timers are added or on shutdown
+	 */
+	std::condition_variable wake_up;
+
+	/**
+	 * Signalled every time a callback returns
+	 */
+	std::condition_variable callback_done;
+
+	/**
+	 * Thread that fires the timers
+	 */
+	std::thread service_thread;
+
+	/**
+	 * Returns the tick that the given time point falls in, rounded down. Used
+	 * for the current time, so that a tick is only processed once it's begun.
+	 */
+	int64_t GetTick(Clock::time_point time_point) const;
+
+	/**
+	 * Returns the first tick starting at or after the given time point, so
+	 * that a timer never fires before its deadline
+	 */
+	int64_t GetExpiryTick(Clock::time_point time_point) const;
+
+	/**
+	 * Returns the earliest tick at which some timer may expire. Must be
+	 * called with the mutex held and at least one timer scheduled.
+	 */
+	int64_t GetNextOccupiedTick() const;
+
+	/**
+	 * Body of the service thread
+	 */
+	void Run();
+
+  public:
+	/**
+	 * Constructor for TimerService. Starts the service thread.
+	 *
+	 * @param[in]  tick_duration  The resolution of the timers
+	 * @param[in]  num_slots      The number of slots in the wheel
+	 */
+	TimerService(Clock::duration tick_duration, size_t num_slots);
+
+	/**
+	 * Stops the service thread. Pending timers are dropped.
+	 */
+	~TimerService();
+
+	/**
+	 * Gets the service shared by the whole process
+	 *
+	 * @return     The timer service instance
+	 */
+	static TimerService &GetInstance();
+
+	/**
+	 * Schedules callback to be called after delay
+	 *
+	 * @param[in]  delay     Time after which the timer expires
+	 * @param[in]  callback  The callback when timer expires
+	 *
+	 * @return     Handle to the timer, for cancelling it
+	 */
+	TimerId Schedule(Clock::duration delay, Callback callback);
+
+	/**
+	 * Cancels a timer
+	 *
+	 * If the timer's callback is running at this moment on the service
+	 * thread, blocks till it returns. Once this returns, the callback is
+	 * guaranteed not to be running or called again.
+	 *
+	 * @param[in]  timer_id  The timer to cancel
+	 *
+	 * @return     true if the timer was pending and is now cancelled, false if
+	 *             it had already fired or was never scheduled
+	 */
+	bool Cancel(TimerId timer_id);
+};
+} // namespace drivers
@@ -0,0 +1,231 @@
+/**
+ * @file tracer.h
+ * Declarations for a process wide tracer of game events
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace drivers {
+
+/**
+ * Records when things happen in a process, for a timeline of the game in the
+ * Chrome trace event format, which chrome://tracing and Perfetto show
+ *
+ * Tracing is off until Enable is called, and then costs a clock read and a
+ * few stores per event. Every thread records into a buffer of its own, which
+ * only it writes to, so recording takes no locks. Once a thread's buffer is
+ * full, its later events are dropped and counted.
+ *
+ * Timestamps are taken on the monotonic clock, which all processes on the
+ * host share, so the events of the main process and the players can be put
+ * on the same timeline. Each process is a track of its own.
+ *
+ * Event names must outlive the tracer, and are best string literals.
+ */
+class DRIVERS_EXPORT Tracer {
+  private:
+	/**
+	 * Number of events a thread can record before it starts dropping them
+	 */
+	static const size_t thread_buffer_size = 1 << 16;
+
+	/**
+	 * Kinds of events, by their phase in the trace event format
+	 */
+	enum class EventType : char {
+		BEGIN = 'B',
+		END = 'E',
+		INSTANT = 'i',
+		ASYNC_BEGIN = 'b',
+		ASYNC_END = 'e'
+	};
+
+	/**
+	 * A single recorded event
+	 */
+	struct Event {
+		const char *name;
+
+		/**
+		 * Time of the event on the monotonic clock, in nanoseconds
+		 */
+		int64_t time_ns;
+
+		/**
+		 * Id tying the ends of an async event together, unused otherwise
+		 */
+		int64_t id;
+
+		EventType type;
+	};
+
+	/**
+	 * Events recorded by one thread
+	 */
+	struct ThreadBuffer {
+		/**
+		 * Number of the thread in the trace, by when it first recorded
+		 */
+		int thread_id;
+
+		std::unique_ptr<Event[]> events;
+
+		/**
+		 * Number of events recorded. Each event is written before the count
+		 * is bumped past it, so readers only see whole events.
+		 */
+		std::atomic<size_t> num_events;
+
+		/**
+		 * Number of events dropped because the buffer was full
+		 */
+		std::atomic<int64_t> num_dropped;
+	};
+
+	/**
+	 * true while events are being recorded
+	 */
+	std::atomic_bool is_enabled;
+
+	/**
+	 * Name the process is shown with
+	 */
+	std::string process_name;
+
+	/**
+	 * Buffers of every thread that has recorded an event. They're kept
+	 * after their threads exit, so that the events can be written.
+	 */
+	std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers;
+
+	/**
+	 * Guards thread_buffers, which only changes the first time a thread
+	 * records an event
+	 */
+	mutable std::mutex thread_buffers_lock;
+
+	Tracer();
+
+	/**
+	 * Gets the calling thread's buffer, making it the first time
+	 */
+	ThreadBuffer &GetThreadBuffer();
+
+	/**
+	 * Records an event on the calling thread, if tracing is on
+	 */
+	void Record(EventType type, const char *name, int64_t id = 0);
+
+	/**
+	 * Writes the events of every thread, each followed by a comma
+	 */
+	void WriteThreadEvents(std::ostream &os) const;
+
+	/**
+	 * Writes the event naming the process's track, with no comma after it
+	 */
+	void WriteProcessName(std::ostream &os) const;
+
+  public:
+	/**
+	 * Gets the tracer of the process
+	 *
+	 * @return     The tracer instance
+	 */
+	static Tracer &GetInstance();
+
+	/**
+	 * Starts recording events, dropping any recorded before. Must not be
+	 * called while other threads are recording.
+	 *
+	 * @param[in]  process_name  Name the process is shown with
+	 */
+	void Enable(std::string process_name);
+
+	/**
+	 * Stops recording events, keeping the ones recorded so far
+	 */
+	void Disable();
+
+	/**
+	 * Returns true if events are being recorded
+	 */
+	bool IsEnabled() const;
+
+	/**
+	 * Records the start of a span on the calling thread. Spans on a thread
+	 * must be nested.
+	 */
+	void Begin(const char *name);
+
+	/**
+	 * Records the end of the innermost span on the calling thread
+	 */
+	void End(const char *name);
+
+	/**
+	 * Records a point in time on the calling thread
+	 */
+	void Instant(const char *name);
+
+	/**
+	 * Records the start of a span that can overlap others, and can end on
+	 * another thread
+	 *
+	 * @param[in]  name  Name of the span
+	 * @param[in]  id    Id telling the span apart from others of its name
+	 */
+	void AsyncBegin(const char *name, int64_t id);
+
+	/**
+	 * Records the end of a span started with AsyncBegin
+	 */
+	void AsyncEnd(const char *name, int64_t id);
+
+	/**
+	 * Writes the events recorded so far, each as a JSON object followed by
+	 * a comma and a new line. The events of several processes can be put in
+	 * one trace with WriteTrace.
+	 *
+	 * @param[in]  os    Stream to write the events to
+	 */
+	void WriteEvents(std::ostream &os) const;
+
+	/**
+	 * Writes a whole trace, of the events recorded so far along with the
+	 * events other processes wrote with WriteEvents
+	 *
+	 * @param[in]  os                Stream to write the trace to
+	 * @param[in]  event_file_names  Files other processes wrote their events
+	 *                               to. Missing files are skipped.
+	 */
+	void WriteTrace(std::ostream &os,
+	                const std::vector<std::string> &event_file_names) const;
+};
+
+/**
+ * Traces a span for as long as it's in scope
+ */
+class DRIVERS_EXPORT TraceScope {
+  private:
+	const char *name;
+
+  public:
+	explicit TraceScope(const char *name);
+
+	~TraceScope();
+
+	TraceScope(const TraceScope &) = delete;
+
+	TraceScope &operator=(const TraceScope &) = delete;
+};
+} // namespace drivers
@@ -0,0 +1,261 @@
+/**
+ * @file turn_profiler.h
+ * Declarations for timing each phase of a game's turns
+ */
+#pragma once
+
+#include "drivers/drivers_export.h"
+#include "logger/turn_profile.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace drivers {
+
+/**
+ * Histogram of latencies, in fixed memory
+ *
+ * Each power of two nanoseconds is split into a few equal buckets, so that
+ * percentiles are off by less than an eighth however long the latencies are
+ */
+class DRIVERS_EXPORT LatencyHistogram {
+  private:
+	/**
+	 * Each power of two is split into 2^SUB_BUCKET_BITS buckets
+	 */
+	static const int SUB_BUCKET_BITS = 3;
+
+	static const int NUM_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+	/**
+	 * Enough buckets for any 64 bit latency
+	 */
+	static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS;
+
+	/**
+	 * Number of latencies that fell in each bucket
+	 */
+	std::array<int64_t, NUM_BUCKETS> bucket_counts;
+
+	/**
+	 * Number of latencies recorded
+	 */
+	int64_t count;
+
+	/**
+	 * Longest latency recorded, in nanoseconds
+	 */
+	int64_t max_ns;
+
+	/**
+	 * Gets the bucket a latency falls in
+	 */
+	static size_t GetBucket(uint64_t latency_ns);
+
+	/**
+	 * Gets the longest latency that falls in a bucket
+	 */
+	static uint64_t GetBucketUpperBound(size_t bucket);
+
+  public:
+	LatencyHistogram();
+
+	/**
+	 * Adds a latency to the histogram
+	 */
+	void Record(std::chrono::nanoseconds latency);
+
+	/**
+	 * Returns the number of latencies recorded
+	 */
+	int64_t GetCount() const;
+
+	/**
+	 * Gets a percentile of the latencies, rounded up to the end of its
+	 * bucket, but never past the longest latency
+	 *
+	 * @param[in]  percentile  Percentile to get, between 0 and 100
+	 *
+	 * @return     The percentile, or 0 if nothing was recorded
+	 */
+	std::chrono::nanoseconds GetPercentile(double percentile) const;
+
+	/**
+	 * Returns the longest latency recorded
+	 */
+	std::chrono::nanoseconds GetMax() const;
+};
+
+/**
+ * Phases of a turn that are timed
+ */
+enum class TurnPhase {
+	/**
+	 * A player's turn, from letting the player go to seeing that it's done.
+	 * This is the player's think time, along with the time the driver takes
+	 * to notice the player is done.
+	 */
+	PLAYER_1_TURN,
+	PLAYER_2_TURN,
+
+	/**
+	 * Converting the transfer states the players wrote into player states
+	 */
+	TO_PLAYER_STATES,
+
+	/**
+	 * Applying the players' moves and updating the main state
+	 */
+	UPDATE_MAIN_STATE,
+
+	/**
+	 * Updating a player's state from the main state, timed for each player
+	 */
+	UPDATE_PLAYER_STATE,
+
+	/**
+	 * Converting a player's state into its transfer state, timed for each
+	 * player
+	 */
+	TO_TRANSFER_STATE,
+
+	/**
+	 * Logging the main state
+	 */
+	LOG_STATE,
+
+	/**
+	 * Everything done once the main state is updated, some of which runs side
+	 * by side. Its hardware events are only those of the thread running the
+	 * game, which may run some of the work itself.
+	 */
+	POST_SIMULATION,
+
+	/**
+	 * The whole turn. Its hardware events are those of the other phases
+	 * that simulate the game, as the thread running the game is mostly
+	 * waiting on the players otherwise.
+	 */
+	TURN
+};
+
+/**
+ * Number of phases of a turn that are timed
+ */
+const size_t NUM_TURN_PHASES = static_cast<size_t>(TurnPhase::TURN) + 1;
+
+/**
+ * Names of the phases of a turn, by phase
+ */
+DRIVERS_EXPORT extern const std::array<const char *, NUM_TURN_PHASES>
+    TURN_PHASE_NAMES;
+
+/**
+ * Times each phase of a game's turns, and optionally counts the hardware
+ * events in them. Recording is cheap enough to be done in every game, and
+ * takes no memory as the game goes on.
+ *
+ * A TurnProfiler may only be used from one thread at a time, except for
+ * GetMark, which any thread may call
+ */
+class DRIVERS_EXPORT TurnProfiler {
+  public:
+	/**
+	 * Clock phases are timed with
+	 */
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	 * Point a phase starts or ends at, on the thread that ran it
+	 */
+	struct Mark {
+		Clock::time_point time;
+
+		/**
+		 * true if the thread's hardware events were counted, in counters
+		 */
+		bool has_counters;
+
+		/**
+		 * Hardware events the thread had counted by the mark
+		 */
+		logger::PhaseCounters counters;
+	};
+
+  private:
+	/**
+	 * Latencies of each phase
+	 */
+	std::array<LatencyHistogram, NUM_TURN_PHASES> histograms;
+
+	/**
+	 * If true, hardware events are counted along with the time
+	 */
+	bool count_events;
+
+	/**
+	 * Hardware events counted in each phase, for the phases marked in
+	 * has_phase_counters
+	 */
+	std::array<logger::PhaseCounters, NUM_TURN_PHASES> phase_counters;
+	std::array<bool, NUM_TURN_PHASES> has_phase_counters;
+
+	/**
+	 * Hardware events counted in the phases of the current turn so far
+	 */
+	logger::PhaseCounters turn_counters;
+	bool has_turn_counters;
+
+  public:
+	/**
+	 * Constructor
+	 *
+	 * @param[in]  count_events  If true, marks count hardware events on
+	 *                           threads where the kernel allows it
+	 */
+	explicit TurnProfiler(bool count_events = false);
+
+	/**
+	 * Records that a phase took some time
+	 */
+	void Record(TurnPhase phase, std::chrono::nanoseconds latency);
+
+	/**
+	 * Records that a phase ran from start until now, without counting
+	 * events, for phases that are spent waiting
+	 *
+	 * @return     The current time, to start timing the next phase from
+	 */
+	Clock::time_point RecordSince(TurnPhase phase, Clock::time_point start);
+
+	/**
+	 * Marks the current point of the calling thread, to time and count
+	 * phases between
+	 */
+	Mark GetMark() const;
+
+	/**
+	 * Records that a phase ran between two marks of the same thread
+	 */
+	void Record(TurnPhase phase, const Mark &start, const Mark &end);
+
+	/**
+	 * Records that a phase ran from a mark until now, on the calling thread
+	 *
+	 * @return     A mark of now, to start the next phase from
+	 */
+	Mark RecordSince(TurnPhase phase, const Mark &start);
+
+	/**
+	 * Records a whole turn that started at start, along with the hardware
+	 * events of its phases
+	 */
+	void RecordTurn(Clock::time_point start);
+
+	/**
+	 * Gets the latencies of each phase that was timed at least once
+	 */
+	logger::TurnProfile GetProfile() const;
+};
+} // namespace drivers
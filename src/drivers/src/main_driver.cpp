@@ -5,8 +5,10 @@
 
 #include "drivers/main_driver.h"
 #include "drivers/game_result.h"
+#include "drivers/tracer.h"
 
-#include <csignal>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 
 namespace drivers {
@@ -16,33 +18,73 @@ MainDriver::MainDriver(
     std::vector<std::unique_ptr<SharedMemoryMain>> shared_memories,
     int64_t player_instruction_limit_turn,
     int64_t player_instruction_limit_game, int64_t max_no_turns,
-    Timer::Interval game_duration, std::unique_ptr<logger::ILogger> logger,
-    std::string log_file_name)
+    Timer::Interval game_duration, Timer::Interval turn_duration,
+    std::unique_ptr<logger::ILogger> logger, std::string log_file_name,
+    bool run_players_concurrently, bool count_perf_events)
     : state_syncer(std::move(state_syncer)),
       shared_memories(std::move(shared_memories)),
       player_instruction_limit_turn(player_instruction_limit_turn),
       player_instruction_limit_game(player_instruction_limit_game),
       max_no_turns(max_no_turns), is_game_timed_out(false), game_timer(),
-      game_duration(game_duration), logger(std::move(logger)),
-      log_file_name(log_file_name), cancel(false) {
+      game_duration(game_duration), turn_duration(turn_duration),
+      logger(std::move(logger)),
+      log_file_name(log_file_name), log_file(), cancel(false),
+      run_players_concurrently(run_players_concurrently),
+      phase(Phase::GAME_OVER), turn_no(0), cur_player_id(0),
+      turn_deadlines(), skip_player_turn{{false, false}},
+      player_results(), instruction_count_exceeded(false),
+      turn_duration_exceeded(false), game_result(), post_simulation_tasks(),
+      turn_profiler(count_perf_events), turn_start(), player_turn_starts(),
+      post_simulation_starts(), post_simulation_ends(),
+      count_perf_events(count_perf_events), memory_account() {
 	for (auto &shared_memory : this->shared_memories) {
 		// Get pointers to shared memory and store
 		SharedBuffer *shared_buffer = shared_memory->GetBuffer();
 		shared_buffers.push_back(shared_buffer);
 	}
 
-	// Store pointers to player state
-	this->transfer_states[0] = &shared_buffers[0]->transfer_state;
-	this->transfer_states[1] = &shared_buffers[1]->transfer_state;
+	// A player's transfer state can be written as soon as its own state is
+	// ready. The back copies are swapped in while the players are paused.
+	// Each task marks its start and end in its own slots, the players' state
+	// updates first, then their conversions, then the log.
+	for (int i = 0; i < 2; ++i) {
+		auto update_player_state = post_simulation_tasks.AddTask([this, i] {
+			TraceScope trace_scope("UPDATE_PLAYER_STATE");
+			post_simulation_starts[i] = turn_profiler.GetMark();
+			this->state_syncer->UpdatePlayerState(
+			    static_cast<state::PlayerId>(i), this->player_states[i]);
+			post_simulation_ends[i] = turn_profiler.GetMark();
+		});
+		post_simulation_tasks.AddTask(
+		    [this, i] {
+			    TraceScope trace_scope("TO_TRANSFER_STATE");
+			    post_simulation_starts[2 + i] = turn_profiler.GetMark();
+			    shared_buffers[i]->GetBackTransferState() =
+			        transfer_state::ConvertToTransferState(player_states[i]);
+			    shared_buffers[i]->SwapTransferStates();
+			    post_simulation_ends[2 + i] = turn_profiler.GetMark();
+		    },
+		    {update_player_state});
+	}
+
+	// The log only reads the main state
+	post_simulation_tasks.AddTask([this] {
+		TraceScope trace_scope("LOG_STATE");
+		post_simulation_starts[4] = turn_profiler.GetMark();
+		this->state_syncer->LogState();
+		post_simulation_ends[4] = turn_profiler.GetMark();
+	});
 }
 
 void MainDriver::/*Avengers:*/ EndGame(state::PlayerId player_id,
                                        bool was_deathmatch,
                                        std::array<int64_t, 2> final_scores) {
-	std::ofstream log_file(log_file_name, std::ios::out | std::ios::binary);
-
+	TraceScope trace_scope("END_GAME");
+	logger->LogTurnProfile(turn_profiler.GetProfile());
 	logger->LogFinalGameParams(player_id, was_deathmatch, final_scores);
 	logger->WriteGame(log_file);
+	log_file.close();
+	MeasureMemory();
 	this->game_timer.Cancel();
 }
 
@@ -60,14 +102,36 @@ std::array<PlayerResult, 2> MainDriver::GetPlayerResults() {
 	return player_results;
 }
 
-void MainDriver::SetPids(std::array<int, 2> pids) { this->process_pids = pids; }
-
 const GameResult MainDriver::Start() {
+	Begin();
+
+	// Wait for the player we're on, the game timer or cancellation, but no
+	// longer than the player's turn duration
+	while (!Resume()) {
+		auto awaited_buffer = GetAwaitedBuffer();
+		awaited_buffer->Wait(
+		    [this, awaited_buffer] {
+			    return !awaited_buffer->is_player_running ||
+			           this->is_game_timed_out || this->cancel;
+		    },
+		    GetAwaitedDeadline());
+	}
+
+	return GetResult();
+}
+
+void MainDriver::Begin() {
+	// Open the log before the first state is logged
+	log_file.open(log_file_name,
+	              std::ios::out | std::ios::binary | std::ios::trunc);
+	logger->BeginGame(log_file);
+
 	// Initialize contents of shared memory
 	for (auto buffer : shared_buffers) {
 		buffer->is_player_running = false;
 		buffer->is_game_complete = false;
 		buffer->instruction_counter = 0;
+		buffer->instruction_limit = this->player_instruction_limit_game;
 	}
 
 	// Initialize player states with contents of main state
@@ -75,29 +139,58 @@ const GameResult MainDriver::Start() {
 
 	// Convert current player states to transfer states
 	for (int i = 0; i < 2; ++i) {
-		*(this->transfer_states[i]) =
+		this->shared_buffers[i]->GetFrontTransferState() =
 		    transfer_state::ConvertToTransferState(this->player_states[i]);
 	}
 
+	// Initializing stuff...
+	this->phase = Phase::START_TURN;
+	this->turn_no = 0;
+	this->cur_player_id = 0;
+	this->skip_player_turn = {false, false};
+	this->player_results = {
+	    PlayerResult{0, PlayerResult::Status::UNDEFINED},
+	    PlayerResult{0, PlayerResult::Status::UNDEFINED}};
+	this->instruction_count_exceeded = false;
+	this->turn_duration_exceeded = false;
+	this->turn_profiler = TurnProfiler(this->count_perf_events);
+
+	// The path cache is sized for the map up front, and the segments never
+	// change size, so they're measured once
+	this->memory_account.Reset();
+	this->memory_account.Set(MemorySubsystem::PATH_CACHE,
+	                         this->state_syncer->GetPathCacheBytes());
+	this->memory_account.Set(MemorySubsystem::SHARED_MEMORY,
+	                         SharedMemoryMain::GetSegmentSize() *
+	                             this->shared_memories.size());
+	MeasureMemory();
+
 	// Start a timer. Game is invalid if it does not complete within the timer
 	// limit
 	this->is_game_timed_out = false;
 	this->game_timer.Start(this->game_duration,
 	                       [this]() { this->is_game_timed_out = true; });
+}
+
+// Name a player's turn is traced with, which is also its phase's name
+const char *GetPlayerTurnName(int player_id) {
+	return player_id == 0 ? "PLAYER_1_TURN" : "PLAYER_2_TURN";
+}
 
-	// Run the game and return results
-	return this->Run();
+bool HasForfeited(PlayerResult player_result) {
+	return player_result.status ==
+	           PlayerResult::Status::EXCEEDED_INSTRUCTION_LIMIT ||
+	       player_result.status == PlayerResult::Status::EXCEEDED_TURN_DURATION;
 }
 
 GameResult::Winner
-GetWinnerByInstCountExceeded(std::array<PlayerResult, 2> player_results) {
-	auto status1 = player_results[0].status;
-	auto status2 = player_results[1].status;
-	auto FAIL = PlayerResult::Status::EXCEEDED_INSTRUCTION_LIMIT;
+GetWinnerByForfeit(std::array<PlayerResult, 2> player_results) {
+	auto forfeit1 = HasForfeited(player_results[0]);
+	auto forfeit2 = HasForfeited(player_results[1]);
 
-	if (status1 == FAIL && status2 == FAIL) {
+	if (forfeit1 && forfeit2) {
 		return GameResult::Winner::TIE;
-	} else if (status1 == FAIL) {
+	} else if (forfeit1) {
 		return GameResult::Winner::PLAYER2;
 	}
 	return GameResult::Winner::PLAYER1;
@@ -138,146 +231,313 @@ state::PlayerId GetPlayerIdFromWinner(GameResult::Winner winner) {
 	}
 }
 
-const GameResult MainDriver::Run() {
-	// Initializing stuff...
-	auto skip_player_turn = std::array<bool, 2>{false, false};
-	auto player_results = std::array<PlayerResult, 2>{
-	    PlayerResult{0, PlayerResult::Status::UNDEFINED},
-	    PlayerResult{0, PlayerResult::Status::UNDEFINED}};
-	auto winner = GameResult::Winner::NONE;
-	auto win_type = GameResult::WinType::NONE;
-	auto player_scores = std::array<int64_t, 2>{0, 0};
-	auto instruction_count_exceeded = false;
-
-	// Main loop that runs every turn
-	for (int i = 0; i < this->max_no_turns; ++i) {
-		// Loop over each player
-		for (int cur_player_id = 0; cur_player_id < 2; ++cur_player_id) {
-			auto current_player_buffer = this->shared_buffers[cur_player_id];
-
-			// Let player do their updates
-			current_player_buffer->is_player_running = true;
-
-			// Wait for updates, the timer or cancellation
-			while (current_player_buffer->is_player_running &&
-			       !this->is_game_timed_out && !this->cancel)
-				;
-
-			// If game has been cancelled, return immediately
-			if (this->cancel) {
-				this->cancel = false;
-				EndGame();
-				return GameResult{winner, win_type, 0, player_results};
+bool MainDriver::Resume() {
+	while (true) {
+		switch (this->phase) {
+		case Phase::START_TURN:
+			// Done with the game once all the turns have been played
+			if (this->turn_no == this->max_no_turns) {
+				// Write scores and complete game
+				auto player_results = GetPlayerResults();
+
+				// Set result parameters
+				auto interest = this->state_syncer->GetInterestingness();
+				auto winner = GetWinnerByScore(player_results);
+
+				// Log the winner
+				auto winner_player_id = GetPlayerIdFromWinner(winner);
+				EndGame(winner_player_id, false,
+				        {player_results[0].score, player_results[1].score});
+
+				Finish(GameResult{winner, GameResult::WinType::SCORE, interest,
+				                  player_results});
+				break;
 			}
 
-			// If the game timed out
-			if (this->is_game_timed_out) {
-
-				// THIS IS AN UGLY HACK! PLEASE CHANGE THIS. TODO.
-				auto success = kill(process_pids[cur_player_id], SIGTERM);
-				return GameResult{};
+			// The players' turns are independent of each other, so they can
+			// be let go at once, and waited on one after the other
+			this->turn_start = TurnProfiler::Clock::now();
+			Tracer::GetInstance().Begin("TURN");
+			this->cur_player_id = 0;
+			if (this->run_players_concurrently) {
+				for (int i = 0; i < 2; ++i) {
+					ReleasePlayer(i);
+				}
+				this->phase = Phase::AWAIT_PLAYER;
+			} else {
+				this->phase = Phase::RELEASE_PLAYER;
 			}
+			break;
 
-			// Check for instruction counter to see if player has
-			// exceeded some limit
-			if (current_player_buffer->instruction_counter >
-			    this->player_instruction_limit_game) {
-				player_results[cur_player_id].status =
-				    PlayerResult::Status::EXCEEDED_INSTRUCTION_LIMIT;
-				instruction_count_exceeded = true;
-			} else if (current_player_buffer->instruction_counter >
-			           this->player_instruction_limit_turn) {
-				skip_player_turn[cur_player_id] = true;
-			} else {
-				skip_player_turn[cur_player_id] = false;
+		case Phase::RELEASE_PLAYER:
+			ReleasePlayer(this->cur_player_id);
+			this->phase = Phase::AWAIT_PLAYER;
+			break;
+
+		case Phase::AWAIT_PLAYER:
+			if (!AwaitPlayer()) {
+				return false;
 			}
+			break;
 
-			// Write the turn's instruction counts
-			logger->LogInstructionCount(
-			    static_cast<state::PlayerId>(cur_player_id),
-			    current_player_buffer->instruction_counter);
-		}
+		case Phase::END_TURN:
+			EndTurn();
+			break;
 
-		// If the game instruction count has been exceeded by some
-		// player, game is forfeit
-		if (instruction_count_exceeded) {
-			EndGame();
-			winner = GetWinnerByInstCountExceeded(player_results);
-			win_type = GameResult::WinType::EXCEEDED_INSTRUCTION_LIMIT;
-			return GameResult{winner, win_type, 0, player_results};
+		case Phase::GAME_OVER:
+			return true;
 		}
+	}
+}
 
-		// If the game timer has expired, the game has to stop
-		if (this->is_game_timed_out) {
-			EndGame();
-			return GameResult{winner, win_type, 0, player_results};
-		}
+void MainDriver::ReleasePlayer(int player_id) {
+	// Let player do their updates
+	Tracer::GetInstance().AsyncBegin(GetPlayerTurnName(player_id),
+	                                 this->turn_no);
+	this->player_turn_starts[player_id] = TurnProfiler::Clock::now();
+	this->turn_deadlines[player_id] =
+	    this->player_turn_starts[player_id] + this->turn_duration;
+	this->shared_buffers[player_id]->SetPlayerRunning(true);
+}
+
+bool MainDriver::AwaitPlayer() {
+	auto current_player_buffer = this->shared_buffers[cur_player_id];
 
-		// If we're here, the game is not yet over
+	// Keep waiting for updates, the game timer or cancellation, but no
+	// longer than the turn duration
+	auto is_turn_complete = !current_player_buffer->is_player_running ||
+	                        this->is_game_timed_out || this->cancel;
+	if (!is_turn_complete && std::chrono::steady_clock::now() <
+	                             this->turn_deadlines[cur_player_id]) {
+		return false;
+	}
 
-		// Validate and run the player's commands. Skips a player if
-		// they have exceeded turn instruction limit
+	// If game has been cancelled, return immediately
+	if (this->cancel) {
+		this->cancel = false;
+		EndTurnTrace();
+		EndGame();
+		Finish(GameResult{GameResult::Winner::NONE, GameResult::WinType::NONE,
+		                  0, player_results});
+		return true;
+	}
 
-		// Convert current transfer states into player states
+	// If the game timed out, it's invalid. Every player still running its
+	// turn, which may be both when they run concurrently, is left as is for
+	// the caller to stop.
+	if (this->is_game_timed_out) {
 		for (int i = 0; i < 2; ++i) {
-			player_states[i] = transfer_state::ConvertToPlayerState(
-			    *(this->transfer_states[i]));
+			if (shared_buffers[i]->is_player_running) {
+				player_results[i].status = PlayerResult::Status::TIMEOUT;
+			}
+		}
+		for (auto buffer : shared_buffers) {
+			buffer->SetGameComplete(true);
 		}
-		this->state_syncer->UpdateMainState(this->player_states,
-		                                    skip_player_turn);
 
-		// Write the updated main state back to the player's state
-		// copies
-		this->state_syncer->UpdatePlayerStates(this->player_states);
+		EndTurnTrace();
+		EndGame();
+		Finish(GameResult{GameResult::Winner::NONE,
+		                  GameResult::WinType::TIMEOUT, 0, player_results});
+		return true;
+	}
 
-		// Convert these player states back into transfer states
-		for (int i = 0; i < 2; ++i) {
-			*(transfer_states[i]) =
-			    transfer_state::ConvertToTransferState(player_states[i]);
+	// A player that didn't finish its turn in time forfeits the game.
+	// Otherwise, check for instruction counter to see if player has exceeded
+	// some limit
+	if (!is_turn_complete) {
+		player_results[cur_player_id].status =
+		    PlayerResult::Status::EXCEEDED_TURN_DURATION;
+		turn_duration_exceeded = true;
+	} else if (current_player_buffer->instruction_counter >
+	           this->player_instruction_limit_game) {
+		player_results[cur_player_id].status =
+		    PlayerResult::Status::EXCEEDED_INSTRUCTION_LIMIT;
+		instruction_count_exceeded = true;
+	} else if (current_player_buffer->instruction_counter >
+	           this->player_instruction_limit_turn) {
+		skip_player_turn[cur_player_id] = true;
+	} else {
+		skip_player_turn[cur_player_id] = false;
+	}
+
+	// The player's turn is only timed if it's over by here, so waiting in
+	// the caller counts towards it too
+	turn_profiler.RecordSince(cur_player_id == 0 ? TurnPhase::PLAYER_1_TURN
+	                                             : TurnPhase::PLAYER_2_TURN,
+	                          this->player_turn_starts[cur_player_id]);
+	Tracer::GetInstance().AsyncEnd(GetPlayerTurnName(cur_player_id),
+	                               this->turn_no);
+
+	// Write the turn's instruction counts
+	logger->LogInstructionCount(static_cast<state::PlayerId>(cur_player_id),
+	                            current_player_buffer->instruction_counter);
+
+	// Move on to the next player, or wrap the turn up
+	++this->cur_player_id;
+	if (this->cur_player_id == 2) {
+		this->phase = Phase::END_TURN;
+	} else if (this->run_players_concurrently) {
+		this->phase = Phase::AWAIT_PLAYER;
+	} else {
+		this->phase = Phase::RELEASE_PLAYER;
+	}
+	return true;
+}
+
+void MainDriver::EndTurn() {
+	// If the game instruction count or the turn duration has been exceeded
+	// by some player, game is forfeit
+	if (instruction_count_exceeded || turn_duration_exceeded) {
+		// Let the players exit. One that was stopped midway through its turn
+		// has exited already, and one that overran its turn is stopped by
+		// the caller.
+		for (auto buffer : shared_buffers) {
+			buffer->SetGameComplete(true);
 		}
 
-		// If the game is over now, some player had all units killed
-		// End the game as a deathmatch
-		state::PlayerId player_winner;
-		if (this->state_syncer->IsGameOver(player_winner)) {
-			// Cancel player drivers as a game over by deathmatch
-			for (auto buffer : shared_buffers) {
-				buffer->is_game_complete = true;
-			}
+		EndTurnTrace();
+		EndGame();
+		auto win_type = turn_duration_exceeded
+		                    ? GameResult::WinType::TIMEOUT
+		                    : GameResult::WinType::EXCEEDED_INSTRUCTION_LIMIT;
+		Finish(GameResult{GetWinnerByForfeit(player_results), win_type, 0,
+		                  player_results});
+		return;
+	}
 
-			player_results = GetPlayerResults();
-			EndGame(player_winner, true,
-			        {player_results[0].score, player_results[1].score});
-			winner = GetWinnerFromPlayerId(player_winner);
-			win_type = GameResult::WinType::DEATHMATCH;
-			auto interest = this->state_syncer->GetInterestingness();
-			return GameResult{winner, win_type, interest, player_results};
+	// If the game timer has expired, the game has to stop
+	if (this->is_game_timed_out) {
+		for (auto buffer : shared_buffers) {
+			buffer->SetGameComplete(true);
 		}
+
+		EndTurnTrace();
+		EndGame();
+		Finish(GameResult{GameResult::Winner::NONE,
+		                  GameResult::WinType::TIMEOUT, 0, player_results});
+		return;
 	}
 
-	// Done with the game now
+	// If we're here, the game is not yet over
+
+	// Validate and run the player's commands. Skips a player if they have
+	// exceeded turn instruction limit
 
-	// Write scores and complete game
-	player_results = GetPlayerResults();
+	// Convert current transfer states into player states
+	auto &tracer = Tracer::GetInstance();
+	tracer.Begin("TO_PLAYER_STATES");
+	auto phase_start = turn_profiler.GetMark();
+	for (int i = 0; i < 2; ++i) {
+		player_states[i] = transfer_state::ConvertToPlayerState(
+		    this->shared_buffers[i]->GetFrontTransferState());
+	}
+	phase_start =
+	    turn_profiler.RecordSince(TurnPhase::TO_PLAYER_STATES, phase_start);
+	tracer.End("TO_PLAYER_STATES");
+
+	tracer.Begin("UPDATE_MAIN_STATE");
+	this->state_syncer->UpdateMainState(this->player_states,
+	                                    skip_player_turn);
+	phase_start =
+	    turn_profiler.RecordSince(TurnPhase::UPDATE_MAIN_STATE, phase_start);
+	tracer.End("UPDATE_MAIN_STATE");
+
+	// Write the updated main state back to the player's state copies, convert
+	// these into transfer states and log the main state
+	tracer.Begin("POST_SIMULATION");
+	this->post_simulation_tasks.Run();
+	turn_profiler.RecordSince(TurnPhase::POST_SIMULATION, phase_start);
+	tracer.End("POST_SIMULATION");
+	for (int i = 0; i < 2; ++i) {
+		turn_profiler.Record(TurnPhase::UPDATE_PLAYER_STATE,
+		                     post_simulation_starts[i],
+		                     post_simulation_ends[i]);
+		turn_profiler.Record(TurnPhase::TO_TRANSFER_STATE,
+		                     post_simulation_starts[2 + i],
+		                     post_simulation_ends[2 + i]);
+	}
+	turn_profiler.Record(TurnPhase::LOG_STATE, post_simulation_starts[4],
+	                     post_simulation_ends[4]);
+
+	// The turn is timed before the game can end, so that it's in the profile
+	turn_profiler.RecordTurn(this->turn_start);
+	tracer.End("TURN");
+	MeasureMemory();
+
+	// If the game is over now, some player had all units killed
+	// End the game as a deathmatch
+	state::PlayerId player_winner;
+	if (this->state_syncer->IsGameOver(player_winner)) {
+		// Cancel player drivers as a game over by deathmatch
+		for (auto buffer : shared_buffers) {
+			buffer->SetGameComplete(true);
+		}
 
-	// Set result parameters
-	auto interest = this->state_syncer->GetInterestingness();
-	winner = GetWinnerByScore(player_results);
-	win_type = GameResult::WinType::SCORE;
+		auto player_results = GetPlayerResults();
+		EndGame(player_winner, true,
+		        {player_results[0].score, player_results[1].score});
+		auto interest = this->state_syncer->GetInterestingness();
+		Finish(GameResult{GetWinnerFromPlayerId(player_winner),
+		                  GameResult::WinType::DEATHMATCH, interest,
+		                  player_results});
+		return;
+	}
 
-	// Log the winner
-	auto winner_player_id = GetPlayerIdFromWinner(winner);
-	EndGame(winner_player_id, false,
-	        {player_results[0].score, player_results[1].score});
+	++this->turn_no;
+	this->phase = Phase::START_TURN;
+}
+
+void MainDriver::EndTurnTrace() {
+	// Players before the current one have ended their turns already, and
+	// only the current one has been let go unless they run concurrently
+	auto &tracer = Tracer::GetInstance();
+	auto num_released = this->run_players_concurrently
+	                        ? 2
+	                        : std::min(this->cur_player_id + 1, 2);
+	for (int i = this->cur_player_id; i < num_released; ++i) {
+		tracer.AsyncEnd(GetPlayerTurnName(i), this->turn_no);
+	}
+	tracer.End("TURN");
+}
+
+void MainDriver::Finish(GameResult result) {
+	this->game_result = result;
+	this->phase = Phase::GAME_OVER;
+}
+
+SharedBuffer *MainDriver::GetAwaitedBuffer() {
+	return this->shared_buffers[this->cur_player_id % 2];
+}
+
+std::chrono::steady_clock::time_point MainDriver::GetAwaitedDeadline() {
+	if (this->phase != Phase::AWAIT_PLAYER) {
+		return std::chrono::steady_clock::now();
+	}
+	return this->turn_deadlines[this->cur_player_id];
+}
+
+const GameResult MainDriver::GetResult() { return this->game_result; }
+
+logger::TurnProfile MainDriver::GetTurnProfile() const {
+	return this->turn_profiler.GetProfile();
+}
+
+void MainDriver::MeasureMemory() {
+	memory_account.Set(MemorySubsystem::ACTORS,
+	                   this->state_syncer->GetActorBytes());
+	memory_account.Set(MemorySubsystem::GAME_LOG, logger->GetLogBytes());
+	memory_account.Set(MemorySubsystem::PLAYER_STATES,
+	                   GetPlayerStateBytes(player_states[0]) +
+	                       GetPlayerStateBytes(player_states[1]));
+}
 
-	return GameResult{winner, win_type, interest, player_results};
+MemoryReport MainDriver::GetMemoryReport() const {
+	return this->memory_account.GetReport();
 }
 
 void MainDriver::Cancel() {
 	this->cancel = true;
-	auto wait_time = std::chrono::seconds(1);
-	auto end_time = std::chrono::system_clock::now() + wait_time;
-	while (std::chrono::system_clock::now() < end_time)
-		;
+	std::this_thread::sleep_for(std::chrono::seconds(1));
 }
 } // namespace drivers
@@ -0,0 +1,146 @@
+/**
+ * @file match_engine.cpp
+ * Definitions for the event loop that drives many games from one thread
+ */
+
+#include "drivers/match_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace drivers {
+
+MatchEngine::MatchEngine()
+    : new_matches(), new_matches_lock(), matches(), wake_sequence(0),
+      is_stopped(false) {}
+
+void MatchEngine::Add(MainDriver *driver, Callback callback) {
+	{
+		std::lock_guard<std::mutex> lock(this->new_matches_lock);
+		this->new_matches.push_back(
+		    Match{driver, std::move(callback), nullptr, 0});
+	}
+	Wake();
+}
+
+void MatchEngine::Stop() {
+	this->is_stopped = true;
+	Wake();
+}
+
+void MatchEngine::Wake() {
+	this->wake_sequence++;
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<uint32_t *>(&this->wake_sequence),
+	        FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void MatchEngine::WaitForHandoffs(
+    uint32_t wake_sequence, std::chrono::steady_clock::time_point deadline) {
+#if defined(__linux__) && defined(SYS_futex_waitv) && defined(FUTEX_32)
+	static_assert(max_wait_count <= FUTEX_WAITV_MAX,
+	              "Too many futexes for a single futex_waitv");
+
+	// The engine's own wake word, and then the awaited buffers' words. Those
+	// are in memory shared with the players, so they're not private.
+	auto waiters = std::array<struct futex_waitv, max_wait_count>{};
+	size_t num_waiters = 0;
+	waiters[num_waiters++] = {
+	    wake_sequence, reinterpret_cast<uintptr_t>(&this->wake_sequence),
+	    FUTEX_32 | FUTEX_PRIVATE_FLAG, 0};
+	for (const auto &match : this->matches) {
+		if (num_waiters == max_wait_count) {
+			break;
+		}
+		auto word = &match.awaited_buffer->handoff_sequence;
+		waiters[num_waiters++] = {match.handoff_sequence,
+		                          reinterpret_cast<uintptr_t>(word), FUTEX_32,
+		                          0};
+	}
+
+	// The timeout is absolute, on the clock that steady_clock reads
+	auto since_epoch = deadline.time_since_epoch();
+	auto seconds =
+	    std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+	auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+	    since_epoch - seconds);
+	struct timespec time_spec = {static_cast<time_t>(seconds.count()),
+	                             static_cast<long>(nanoseconds.count())};
+
+	auto result = syscall(SYS_futex_waitv, waiters.data(), num_waiters, 0,
+	                      &time_spec, CLOCK_MONOTONIC);
+	if (result != -1 || errno != ENOSYS) {
+		return;
+	}
+#endif
+	// Without futex_waitv, the games are polled every slice
+	std::this_thread::sleep_until(deadline);
+}
+
+void MatchEngine::Run() {
+	while (!this->is_stopped) {
+		// Read before the games are looked at, so that adding one in the
+		// meantime doesn't get missed
+		auto wake_sequence = this->wake_sequence.load();
+
+		// Begin the games that were added
+		{
+			std::lock_guard<std::mutex> lock(this->new_matches_lock);
+			for (auto &match : this->new_matches) {
+				match.driver->Begin();
+				this->matches.push_back(std::move(match));
+			}
+			this->new_matches.clear();
+		}
+
+		// Resume every game. What a game waits on is noted beforehand, like
+		// SharedBuffer::Wait does, so that a handoff that comes in while the
+		// game is looked at wakes the engine right up.
+		auto can_sleep = true;
+		auto deadline =
+		    std::chrono::steady_clock::now() + SharedBuffer::handoff_wait_slice;
+		for (auto match = this->matches.begin();
+		     match != this->matches.end();) {
+			match->awaited_buffer = match->driver->GetAwaitedBuffer();
+			match->awaited_buffer->num_waiters++;
+			match->handoff_sequence =
+			    match->awaited_buffer->handoff_sequence.load();
+
+			if (match->driver->Resume()) {
+				// The driver may go away in the callback, buffer and all
+				match->awaited_buffer->num_waiters--;
+				match->callback(match->driver->GetResult());
+				match = this->matches.erase(match);
+				continue;
+			}
+
+			// A game that moved on to another player must be looked at again
+			// before sleeping, as that player's handoffs weren't noted
+			if (match->driver->GetAwaitedBuffer() != match->awaited_buffer) {
+				can_sleep = false;
+			}
+			deadline = std::min(deadline, match->driver->GetAwaitedDeadline());
+			++match;
+		}
+
+		if (can_sleep) {
+			WaitForHandoffs(wake_sequence, deadline);
+		}
+
+		for (auto &match : this->matches) {
+			match.awaited_buffer->num_waiters--;
+		}
+	}
+}
+} // namespace drivers
@@ -0,0 +1,59 @@
+/**
+ * @file memory_account.cpp
+ * Definitions for accounting the memory each subsystem of a game holds
+ */
+
+#include "drivers/memory_account.h"
+
+namespace drivers {
+
+const std::array<const char *, NUM_MEMORY_SUBSYSTEMS> MEMORY_SUBSYSTEM_NAMES =
+    {{"PATH_CACHE", "ACTORS", "GAME_LOG", "SHARED_MEMORY", "PLAYER_STATES"}};
+
+std::ostream &operator<<(std::ostream &os, const SubsystemMemory &memory) {
+	return os << memory.subsystem << " " << memory.current_bytes << " "
+	          << memory.peak_bytes;
+}
+
+MemoryAccount::MemoryAccount() { Reset(); }
+
+void MemoryAccount::Set(MemorySubsystem subsystem, int64_t bytes) {
+	auto index = static_cast<size_t>(subsystem);
+	current_bytes[index] = bytes;
+	if (bytes > peak_bytes[index]) {
+		peak_bytes[index] = bytes;
+	}
+}
+
+int64_t MemoryAccount::Get(MemorySubsystem subsystem) const {
+	return current_bytes[static_cast<size_t>(subsystem)];
+}
+
+MemoryReport MemoryAccount::GetReport() const {
+	auto report = MemoryReport{};
+	for (size_t i = 0; i < NUM_MEMORY_SUBSYSTEMS; ++i) {
+		report.push_back(SubsystemMemory{MEMORY_SUBSYSTEM_NAMES[i],
+		                                 current_bytes[i], peak_bytes[i]});
+	}
+	return report;
+}
+
+void MemoryAccount::Reset() {
+	for (size_t i = 0; i < NUM_MEMORY_SUBSYSTEMS; ++i) {
+		current_bytes[i] = 0;
+		peak_bytes[i] = 0;
+	}
+}
+
+int64_t GetPlayerStateBytes(const player_state::State &state) {
+	auto bytes = sizeof(player_state::State);
+	bytes += (state.soldiers.capacity() + state.enemy_soldiers.capacity()) *
+	         sizeof(player_state::Soldier);
+	bytes += (state.villagers.capacity() + state.enemy_villagers.capacity()) *
+	         sizeof(player_state::Villager);
+	bytes += (state.factories.capacity() + state.enemy_factories.capacity()) *
+	         sizeof(player_state::Factory);
+	bytes += state.gold_mine_offsets.capacity() * sizeof(Vec2D);
+	return static_cast<int64_t>(bytes);
+}
+} // namespace drivers
@@ -0,0 +1,122 @@
+/**
+ * @file perf_counters.cpp
+ * Definitions for counting hardware events of a thread
+ */
+
+#include "drivers/perf_counters.h"
+
+#ifdef __linux__
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace drivers {
+
+#ifdef __linux__
+namespace {
+
+/**
+ * Hardware events counted, in the order of the fields of PhaseCounters
+ */
+const std::array<uint64_t, 4> EVENT_CONFIGS = {
+    {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+     PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES}};
+
+/**
+ * Opens a counter for an event of the calling thread, in user space only so
+ * that an unprivileged process may count it
+ *
+ * @return     The file descriptor of the counter, or -1 if it can't be opened
+ */
+int OpenEvent(uint64_t config, int group_fd) {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+	                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	// The group starts once all of its events are in
+	attr.disabled = group_fd == -1;
+
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd,
+	                    PERF_FLAG_FD_CLOEXEC);
+}
+} // namespace
+#endif
+
+PerfCounters::PerfCounters() {
+	event_fds.fill(-1);
+
+#ifdef __linux__
+	// Either every event is counted, or none are
+	for (int i = 0; i < NUM_EVENTS; ++i) {
+		event_fds[i] = OpenEvent(EVENT_CONFIGS[i], event_fds[0]);
+		if (event_fds[i] == -1) {
+			for (int j = 0; j < i; ++j) {
+				close(event_fds[j]);
+			}
+			event_fds.fill(-1);
+			return;
+		}
+	}
+	ioctl(event_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+	for (auto event_fd : event_fds) {
+		if (event_fd != -1) {
+			close(event_fd);
+		}
+	}
+#endif
+}
+
+bool PerfCounters::IsOpen() const { return event_fds[0] != -1; }
+
+bool PerfCounters::Read(logger::PhaseCounters &counts) const {
+	if (!IsOpen()) {
+		return false;
+	}
+
+#ifdef __linux__
+	// The whole group is read at once, as laid out by its read format
+	struct {
+		uint64_t num_events;
+		uint64_t time_enabled;
+		uint64_t time_running;
+		uint64_t values[NUM_EVENTS];
+	} group;
+	if (read(event_fds[0], &group, sizeof(group)) != sizeof(group) ||
+	    group.num_events != NUM_EVENTS) {
+		return false;
+	}
+
+	auto scale = 1.0;
+	if (group.time_running > 0 && group.time_running < group.time_enabled) {
+		scale = (double)group.time_enabled / group.time_running;
+	}
+	counts.instructions = (int64_t)(group.values[0] * scale);
+	counts.cycles = (int64_t)(group.values[1] * scale);
+	counts.cache_misses = (int64_t)(group.values[2] * scale);
+	counts.branch_misses = (int64_t)(group.values[3] * scale);
+	return true;
+#else
+	return false;
+#endif
+}
+
+const PerfCounters &PerfCounters::GetThreadCounters() {
+	thread_local PerfCounters counters;
+	return counters;
+}
+} // namespace drivers
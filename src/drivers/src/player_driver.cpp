@@ -4,18 +4,30 @@
  */
 
 #include "drivers/player_driver.h"
+#include "drivers/tracer.h"
+#include <cstdlib>
 #include <fstream>
+#include <limits>
 
 namespace drivers {
 
 std::atomic<uint64_t> PlayerDriver::instruction_count(0);
 
+uint64_t PlayerDriver::inline_instruction_count(0);
+
+uint64_t PlayerDriver::num_increment_calls(0);
+
+uint64_t PlayerDriver::instruction_limit(std::numeric_limits<uint64_t>::max());
+
+PlayerDriver *PlayerDriver::running_driver(nullptr);
+
 PlayerDriver::PlayerDriver(
     std::unique_ptr<player_wrapper::PlayerCodeWrapper> player_code_wrapper,
     std::unique_ptr<drivers::SharedMemoryPlayer> shm_player,
     int64_t max_no_turns, Timer::Interval game_duration,
     std::string player_debug_log_file, std::string debug_logs_turn_prefix,
-    std::string debug_logs_truncate_message, int64_t max_debug_logs_turn_length)
+    std::string debug_logs_truncate_message, int64_t max_debug_logs_turn_length,
+    std::string player_trace_file)
     : player_code_wrapper(std::move(player_code_wrapper)),
       shm_player(std::move(shm_player)),
       shared_buffer(this->shm_player->GetBuffer()), max_no_turns(max_no_turns),
@@ -23,19 +35,53 @@ PlayerDriver::PlayerDriver(
       player_debug_log_file(player_debug_log_file),
       debug_logs_turn_prefix(debug_logs_turn_prefix),
       debug_logs_truncate_message(debug_logs_truncate_message),
-      max_debug_logs_turn_length(max_debug_logs_turn_length) {}
+      max_debug_logs_turn_length(max_debug_logs_turn_length),
+      player_trace_file(player_trace_file) {}
 
 void PlayerDriver::IncrementCount(uint64_t count) {
-	instruction_count += count;
+	++num_increment_calls;
+	if ((instruction_count += count) + inline_instruction_count >
+	    instruction_limit) {
+		ExceedInstructionLimit();
+	}
 }
 
-uint64_t PlayerDriver::GetCount() { return instruction_count; }
+void PlayerDriver::ExceedInstructionLimit() {
+	auto driver = running_driver;
+	if (driver != nullptr) {
+		driver->WriteCountToShm();
+		driver->shared_buffer->SetPlayerRunning(false);
+		driver->WriteDebugLogs();
+		driver->WriteTraceEvents();
+	}
+	std::_Exit(exceeded_instruction_limit_exit_code);
+}
+
+uint64_t PlayerDriver::GetCount() {
+	return instruction_count + inline_instruction_count;
+}
+
+uint64_t PlayerDriver::GetNumIncrementCalls() { return num_increment_calls; }
+
+void PlayerDriver::ResetCount() {
+	instruction_count = 0;
+	inline_instruction_count = 0;
+	num_increment_calls = 0;
+}
 
 void PlayerDriver::WriteCountToShm() {
-	this->shared_buffer->instruction_counter = instruction_count;
+	this->shared_buffer->instruction_counter = GetCount();
 }
 
 void PlayerDriver::Start() {
+	// The player's track is named after its trace file
+	if (!this->player_trace_file.empty()) {
+		auto process_name = this->player_trace_file.substr(
+		    this->player_trace_file.find_last_of('/') + 1);
+		Tracer::GetInstance().Enable(
+		    process_name.substr(0, process_name.find('.')));
+	}
+
 	// Start a timer. Game is invalid if it does not complete within the timer
 	// limit
 	this->is_game_timed_out = false;
@@ -43,7 +89,9 @@ void PlayerDriver::Start() {
 	                       [this]() { this->is_game_timed_out = true; });
 
 	// Run the game and return results
-	return this->Run();
+	running_driver = this;
+	this->Run();
+	running_driver = nullptr;
 }
 
 void PlayerDriver::Run() {
@@ -52,10 +100,14 @@ void PlayerDriver::Run() {
 
 		// Wait for the main driver to synchronize states or until the game has
 		// timed out
-		while (!this->shared_buffer->is_player_running &&
-		       !this->shared_buffer->is_game_complete &&
-		       !this->is_game_timed_out)
-			;
+		auto &tracer = Tracer::GetInstance();
+		tracer.Begin("PLAYER_WAIT");
+		this->shared_buffer->Wait([this] {
+			return this->shared_buffer->is_player_running ||
+			       this->shared_buffer->is_game_complete ||
+			       this->is_game_timed_out;
+		});
+		tracer.End("PLAYER_WAIT");
 
 		// If overall game time limit was exceeded,
 		// Or if the game ended by deathmatch, stop player code and exit
@@ -64,9 +116,13 @@ void PlayerDriver::Run() {
 
 		// Run player's code and get number of instructions they used and their
 		// debug logs
-		instruction_count = 0;
+		ResetCount();
+		instruction_limit = this->shared_buffer->instruction_limit;
+		tracer.Begin("PLAYER_UPDATE");
 		auto logs = this->player_code_wrapper->Update(
-		    this->shared_buffer->transfer_state);
+		    this->shared_buffer->GetFrontTransferState(),
+		    this->shm_player->GetPathTables());
+		tracer.End("PLAYER_UPDATE");
 		this->player_debug_logs << this->debug_logs_turn_prefix
 		                        << logs.substr(0, max_debug_logs_turn_length);
 
@@ -78,12 +134,25 @@ void PlayerDriver::Run() {
 		this->WriteCountToShm();
 
 		// Let the main driver synchronize states now
-		this->shared_buffer->is_player_running = false;
+		this->shared_buffer->SetPlayerRunning(false);
 	}
 
+	// The timer is stopped first, so that it's in the trace
+	this->game_timer.Cancel();
+	this->WriteDebugLogs();
+	this->WriteTraceEvents();
+}
+
+void PlayerDriver::WriteDebugLogs() {
 	// Open debug log file and store player's debug logs in it
 	std::ofstream debug_log_file(this->player_debug_log_file);
 	debug_log_file << this->player_debug_logs.str();
-	this->game_timer.Cancel();
+}
+
+void PlayerDriver::WriteTraceEvents() {
+	if (!this->player_trace_file.empty()) {
+		std::ofstream trace_file(this->player_trace_file);
+		Tracer::GetInstance().WriteEvents(trace_file);
+	}
 }
 } // namespace drivers
@@ -4,13 +4,153 @@
  */
 
 #include "drivers/shared_memory_utils/shared_buffer.h"
+#include "drivers/tracer.h"
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace drivers {
 
+const std::chrono::microseconds SharedBuffer::handoff_wait_slice(1000);
+
+/**
+ * Hints to the CPU that we're in a spin loop
+ */
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#else
+	std::this_thread::yield();
+#endif
+}
+
+/**
+ * Sleeps while the futex word still holds the expected value, for at most
+ * the given duration
+ *
+ * The word lives in memory shared between processes, so the private futex
+ * operations can't be used here
+ */
+inline void FutexWait(std::atomic<uint32_t> *word, uint32_t expected,
+                      std::chrono::microseconds timeout) {
+#ifdef __linux__
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+	              "Futex word must be a plain 32 bit integer");
+	auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+	auto nanoseconds =
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds);
+	struct timespec time_spec = {static_cast<time_t>(seconds.count()),
+	                             static_cast<long>(nanoseconds.count())};
+	syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT,
+	        expected, &time_spec, nullptr, 0);
+#else
+	if (word->load() == expected) {
+		std::this_thread::sleep_for(timeout);
+	}
+#endif
+}
+
+/**
+ * Wakes up everyone sleeping on the futex word
+ */
+inline void FutexWakeAll(std::atomic<uint32_t> *word) {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX,
+	        nullptr, nullptr, 0);
+#endif
+}
+
 SharedBuffer::SharedBuffer(bool is_player_running, bool is_game_complete,
                            int64_t instruction_counter,
                            const transfer_state::State &transfer_state)
     : is_player_running(is_player_running), is_game_complete(is_game_complete),
-      instruction_counter(instruction_counter), transfer_state(transfer_state) {
+      instruction_counter(instruction_counter),
+      instruction_limit(std::numeric_limits<int64_t>::max()),
+      handoff_sequence(0), num_waiters(0), front_index(0),
+      transfer_states{{transfer_state, transfer_state}} {}
+
+transfer_state::State &SharedBuffer::GetFrontTransferState() {
+	return this->transfer_states[this->front_index];
+}
+
+transfer_state::State &SharedBuffer::GetBackTransferState() {
+	return this->transfer_states[1 - this->front_index];
+}
+
+void SharedBuffer::SwapTransferStates() {
+	this->front_index = 1 - this->front_index;
+}
+
+void SharedBuffer::SetPlayerRunning(bool is_player_running) {
+	Tracer::GetInstance().Instant(is_player_running ? "HANDOFF_TO_PLAYER"
+	                                                : "HANDOFF_TO_MAIN");
+	this->is_player_running = is_player_running;
+	Notify();
+}
+
+void SharedBuffer::SetGameComplete(bool is_game_complete) {
+	Tracer::GetInstance().Instant("GAME_COMPLETE");
+	this->is_game_complete = is_game_complete;
+	Notify();
+}
+
+void SharedBuffer::Notify() {
+	// Waiters read the sequence before checking their condition, so bumping
+	// it makes any wait that raced with this notification return at once
+	this->handoff_sequence++;
+	if (this->num_waiters > 0) {
+		FutexWakeAll(&this->handoff_sequence);
+	}
+}
+
+void SharedBuffer::Wait(const std::function<bool()> &condition) {
+	Wait(condition, std::chrono::steady_clock::time_point::max());
+}
+
+bool SharedBuffer::Wait(const std::function<bool()> &condition,
+                        std::chrono::steady_clock::time_point deadline) {
+	static const int64_t spin_count =
+	    std::thread::hardware_concurrency() > 1 ? handoff_spin_count : 0;
+
+	// Spin for a bit, turns are usually handed back quickly
+	for (int64_t i = 0; i < spin_count; ++i) {
+		if (condition()) {
+			return true;
+		}
+		CpuRelax();
+	}
+
+	// Sleep until notified, rechecking the condition every slice, and never
+	// sleeping past the deadline
+	while (true) {
+		this->num_waiters++;
+		auto sequence = this->handoff_sequence.load();
+		if (condition()) {
+			this->num_waiters--;
+			return true;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		if (now >= deadline) {
+			this->num_waiters--;
+			return false;
+		}
+
+		auto timeout = std::min<std::chrono::microseconds>(
+		    handoff_wait_slice,
+		    std::chrono::duration_cast<std::chrono::microseconds>(
+		        deadline - now) +
+		        std::chrono::microseconds(1));
+		FutexWait(&this->handoff_sequence, sequence, timeout);
+		this->num_waiters--;
+	}
 }
 } // namespace drivers
@@ -5,31 +5,78 @@
 
 #include "drivers/shared_memory_utils/shared_memory_main.h"
 #include <cstring>
+#include <new>
+
+#include <sys/mman.h>
 
 namespace drivers {
 
 using namespace boost::interprocess;
 
-SharedMemoryMain::SharedMemoryMain(std::string shared_memory_name,
-                                   bool is_player_running,
-                                   bool is_game_complete,
-                                   int64_t instruction_counter,
-                                   const transfer_state::State &transfer_state)
+namespace {
+
+/**
+ * Rounds a size up to whole pages
+ */
+size_t RoundUpToPages(size_t size) {
+	size_t page_size = mapped_region::get_page_size();
+	return ((size + page_size - 1) / page_size) * page_size;
+}
+} // namespace
+
+size_t SharedMemoryMain::GetSegmentSize() {
+	return GetPathTablesOffset() +
+	       RoundUpToPages(sizeof(player_state::PathTables));
+}
+
+size_t SharedMemoryMain::GetPathTablesOffset() {
+	return RoundUpToPages(sizeof(SharedBuffer));
+}
+
+SharedMemoryMain::SharedMemoryMain(
+    std::string shared_memory_name, bool is_player_running,
+    bool is_game_complete, int64_t instruction_counter,
+    const transfer_state::State &transfer_state,
+    const player_state::PathTables *path_tables)
     : shared_memory_name(shared_memory_name),
       // Creating shared memory
-      shared_memory(create_only, shared_memory_name.c_str(), 65536) {
-	// Constructing unique instance of SharedBuffer in shared memory
-	this->shared_memory.construct<SharedBuffer>(unique_instance)(
+      shared_memory(create_only, shared_memory_name.c_str(), read_write) {
+	this->shared_memory.truncate(GetSegmentSize());
+	this->region = mapped_region(this->shared_memory, read_write);
+
+#ifdef MADV_HUGEPAGE
+	// Best effort, the kernel may not back shared memory with huge pages
+	madvise(this->region.get_address(), this->region.get_size(),
+	        MADV_HUGEPAGE);
+#endif
+
+	// Touch every page up front, so that faults don't land during the game
+	std::memset(this->region.get_address(), 0, this->region.get_size());
+
+	// Constructing the SharedBuffer at the start of the page aligned region,
+	// which satisfies its cache line alignment
+	new (this->region.get_address()) SharedBuffer(
 	    is_player_running, is_game_complete, instruction_counter,
 	    transfer_state);
+
+	// Without paths to share, every pair of offsets has none
+	auto shared_path_tables = reinterpret_cast<player_state::PathTables *>(
+	    static_cast<char *>(this->region.get_address()) +
+	    GetPathTablesOffset());
+	if (path_tables != nullptr) {
+		*shared_path_tables = *path_tables;
+	} else {
+		std::memset(shared_path_tables, 0xff,
+		            sizeof(player_state::PathTables));
+	}
 }
 
 SharedBuffer *SharedMemoryMain::GetBuffer() {
-	return this->shared_memory.find<SharedBuffer>(unique_instance).first;
+	return static_cast<SharedBuffer *>(this->region.get_address());
 }
 
 SharedMemoryMain::~SharedMemoryMain() {
-	this->shared_memory.destroy<SharedBuffer>(unique_instance);
+	GetBuffer()->~SharedBuffer();
 	shared_memory_object::remove(shared_memory_name.c_str());
 }
 } // namespace drivers
@@ -4,16 +4,37 @@
  */
 
 #include "drivers/shared_memory_utils/shared_memory_player.h"
+#include "drivers/shared_memory_utils/shared_memory_main.h"
 #include <cstring>
+#include <initializer_list>
 
 namespace drivers {
 
 using namespace boost::interprocess;
 
 SharedMemoryPlayer::SharedMemoryPlayer(std::string shared_memory_name)
-    : shared_memory(open_only, shared_memory_name.c_str()) {}
+    : shared_memory(open_only, shared_memory_name.c_str(), read_write),
+      region(shared_memory, read_write, 0,
+             SharedMemoryMain::GetPathTablesOffset()),
+      path_tables_region(shared_memory, read_only,
+                         SharedMemoryMain::GetPathTablesOffset(),
+                         sizeof(player_state::PathTables)) {
+	// Read a byte from every page to fault the mappings in up front
+	for (auto const *mapping : {&this->region, &this->path_tables_region}) {
+		auto *address = static_cast<volatile char *>(mapping->get_address());
+		for (size_t offset = 0; offset < mapping->get_size();
+		     offset += mapped_region::get_page_size()) {
+			address[offset];
+		}
+	}
+}
 
 SharedBuffer *SharedMemoryPlayer::GetBuffer() {
-	return this->shared_memory.find<SharedBuffer>(unique_instance).first;
+	return static_cast<SharedBuffer *>(this->region.get_address());
+}
+
+const player_state::PathTables *SharedMemoryPlayer::GetPathTables() const {
+	return static_cast<const player_state::PathTables *>(
+	    this->path_tables_region.get_address());
 }
 } // namespace drivers
@@ -0,0 +1,105 @@
+/**
+ * @file task_graph.cpp
+ * Definitions for the graph of dependent tasks
+ */
+
+#include "drivers/task_graph.h"
+
+namespace drivers {
+
+TaskGraph::TaskGraph(TaskPool &pool)
+    : tasks(), pool(&pool), num_unfinished_tasks(0), mutex(), done() {}
+
+TaskGraph::TaskId
+TaskGraph::AddTask(Function function,
+                   const std::vector<TaskId> &dependencies) {
+	auto task_id = tasks.size();
+
+	auto task = std::unique_ptr<Task>(new Task());
+	task->function = std::move(function);
+	task->num_dependencies = dependencies.size();
+	task->num_pending_dependencies = 0;
+	tasks.push_back(std::move(task));
+
+	for (auto dependency : dependencies) {
+		tasks[dependency]->dependents.push_back(task_id);
+	}
+
+	return task_id;
+}
+
+void TaskGraph::Run() {
+	// Tasks only depend on ones added before them, so the order they were
+	// added in is a valid order to run them in
+	if (pool->GetNumWorkers() == 0) {
+		for (auto &task : tasks) {
+			task->function();
+		}
+		return;
+	}
+
+	if (tasks.empty()) {
+		return;
+	}
+
+	auto roots = std::vector<TaskId>{};
+	for (TaskId task_id = 0; task_id < tasks.size(); ++task_id) {
+		auto &task = *tasks[task_id];
+		task.num_pending_dependencies = task.num_dependencies;
+		if (task.num_dependencies == 0) {
+			roots.push_back(task_id);
+		}
+	}
+	num_unfinished_tasks = tasks.size();
+
+	// Hand all but the first root to the pool, and run that one right here
+	for (size_t i = 1; i < roots.size(); ++i) {
+		auto root = roots[i];
+		pool->Submit([this, root] { RunTask(root); });
+	}
+	RunTask(roots[0]);
+
+	// Help out with queued tasks, then wait for the rest to be done
+	while (num_unfinished_tasks > 0 && pool->RunPending()) {
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return num_unfinished_tasks == 0; });
+}
+
+void TaskGraph::RunTask(TaskId task_id) {
+	const auto no_task = tasks.size();
+
+	while (true) {
+		auto &task = *tasks[task_id];
+		task.function();
+
+		// Keep one of the tasks that are now ready for this thread
+		auto next_task_id = no_task;
+		for (auto dependent : task.dependents) {
+			if (--tasks[dependent]->num_pending_dependencies == 0) {
+				if (next_task_id == no_task) {
+					next_task_id = dependent;
+				} else {
+					pool->Submit([this, dependent] { RunTask(dependent); });
+				}
+			}
+		}
+
+		// The graph may go away as soon as its last task is done, so the
+		// count only drops under the lock that Run takes before returning.
+		// That way Run can't return until this thread is done with the graph.
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--num_unfinished_tasks == 0) {
+				done.notify_all();
+				return;
+			}
+		}
+
+		if (next_task_id == no_task) {
+			return;
+		}
+		task_id = next_task_id;
+	}
+}
+} // namespace drivers
@@ -0,0 +1,75 @@
+/**
+ * @file task_pool.cpp
+ * Definitions for the process wide pool of worker threads
+ */
+
+#include "drivers/task_pool.h"
+
+namespace drivers {
+
+TaskPool::TaskPool(size_t num_workers)
+    : queue(), is_stopping(false), mutex(), wake_up(), workers() {
+	for (size_t i = 0; i < num_workers; ++i) {
+		workers.emplace_back([this] { Run(); });
+	}
+}
+
+TaskPool::~TaskPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_stopping = true;
+	}
+	wake_up.notify_all();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+}
+
+TaskPool &TaskPool::GetInstance() {
+	static auto num_cores = std::thread::hardware_concurrency();
+	static TaskPool instance(num_cores > 1 ? num_cores - 1 : 0);
+	return instance;
+}
+
+size_t TaskPool::GetNumWorkers() const { return workers.size(); }
+
+void TaskPool::Submit(Task task) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(std::move(task));
+	}
+	wake_up.notify_one();
+}
+
+bool TaskPool::RunPending() {
+	Task task;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (queue.empty()) {
+			return false;
+		}
+		task = std::move(queue.front());
+		queue.pop_front();
+	}
+	task();
+	return true;
+}
+
+void TaskPool::Run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake_up.wait(lock, [this] { return is_stopping || !queue.empty(); });
+		if (queue.empty()) {
+			return;
+		}
+
+		auto task = std::move(queue.front());
+		queue.pop_front();
+
+		// Run the task without holding the lock
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+} // namespace drivers
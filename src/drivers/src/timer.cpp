@@ -1,39 +1,39 @@
+/**
+ * @file timer.cpp
+ * Definitions for the timer utility
+ */
+
 #include "drivers/timer.h"
+#include "drivers/tracer.h"
 
 namespace drivers {
 
-Timer::Timer()
-    : is_running(false), cancel(false), cur_duration(0),
-      timer_wake_up_duration(10) {}
+Timer::Timer() : is_running(false), timer_id(TimerService::null_timer_id) {}
+
+Timer::~Timer() { Cancel(); }
 
 bool Timer::Start(Interval total_timer_duration, Callback callback) {
-	if (this->is_running) {
+	if (this->is_running.exchange(true)) {
 		return false;
 	}
 
-	this->is_running = true;
-	this->cur_duration = Interval(0);
-
-	std::thread(
-	    [this](Interval total_timer_duration, Callback callback) {
-		    while (this->cur_duration < total_timer_duration && !this->cancel) {
-			    std::this_thread::sleep_for(this->timer_wake_up_duration);
-			    this->cur_duration += this->timer_wake_up_duration;
-		    }
+	Tracer::GetInstance().Instant("TIMER_START");
+	this->timer_id = TimerService::GetInstance().Schedule(
+	    total_timer_duration, [this, callback] {
+		    Tracer::GetInstance().Instant("TIMER_FIRED");
 		    this->is_running = false;
-		    if (!this->cancel)
-			    callback();
-	    },
-	    total_timer_duration, std::ref(callback))
-	    .detach();
+		    callback();
+	    });
 
 	return true;
 }
 
 void Timer::Cancel() {
-	this->cancel = true;
-	while (this->is_running)
-		;
-	this->cancel = false;
+	auto timer_id = this->timer_id.exchange(TimerService::null_timer_id);
+	if (timer_id != TimerService::null_timer_id) {
+		Tracer::GetInstance().Instant("TIMER_CANCEL");
+		TimerService::GetInstance().Cancel(timer_id);
+	}
+	this->is_running = false;
 }
 } // namespace drivers
@@ -0,0 +1,157 @@
+/**
+ * @file timer_service.cpp
+ * Definitions for the process wide timer service
+ */
+
+#include "drivers/timer_service.h"
+
+#include <algorithm>
+
+namespace drivers {
+
+TimerService::TimerService(Clock::duration tick_duration, size_t num_slots)
+    : tick_duration(tick_duration), wheel(num_slots), timers(),
+      start_time(Clock::now()), current_tick(0),
+      next_timer_id(null_timer_id + 1), running_timer_id(null_timer_id),
+      is_stopping(false) {
+	this->service_thread = std::thread([this] { this->Run(); });
+}
+
+TimerService::~TimerService() {
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->is_stopping = true;
+	}
+	this->wake_up.notify_one();
+	this->service_thread.join();
+}
+
+TimerService &TimerService::GetInstance() {
+	// 1ms resolution, with one revolution of the wheel spanning about a second
+	static TimerService timer_service(std::chrono::milliseconds(1), 1024);
+	return timer_service;
+}
+
+int64_t TimerService::GetTick(Clock::time_point time_point) const {
+	auto elapsed = time_point - this->start_time;
+	return elapsed / this->tick_duration;
+}
+
+int64_t TimerService::GetExpiryTick(Clock::time_point time_point) const {
+	auto elapsed = time_point - this->start_time;
+	return (elapsed + this->tick_duration - Clock::duration(1)) /
+	       this->tick_duration;
+}
+
+int64_t TimerService::GetNextOccupiedTick() const {
+	// The first occupied slot from the current position is never later than
+	// the earliest expiry, as every timer due within one revolution sits in
+	// the slot of its own tick
+	int64_t num_slots = this->wheel.size();
+	for (int64_t tick = this->current_tick;
+	     tick < this->current_tick + num_slots; ++tick) {
+		if (!this->wheel[tick % num_slots].empty()) {
+			return tick;
+		}
+	}
+	return this->current_tick + num_slots;
+}
+
+TimerService::TimerId TimerService::Schedule(Clock::duration delay,
+                                             Callback callback) {
+	auto now = Clock::now();
+	TimerId timer_id;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		// The wheel isn't advanced while it's empty, so catch up first
+		if (this->timers.empty()) {
+			this->current_tick = std::max(this->current_tick, GetTick(now));
+		}
+
+		timer_id = this->next_timer_id++;
+		auto expiry_tick = std::max(this->current_tick, GetExpiryTick(now + delay));
+		auto &slot = this->wheel[expiry_tick % this->wheel.size()];
+		slot.push_back(TimerEntry{timer_id, expiry_tick, std::move(callback)});
+		this->timers[timer_id] = std::prev(slot.end());
+	}
+
+	// Let the service thread pick a new wake up time
+	this->wake_up.notify_one();
+	return timer_id;
+}
+
+bool TimerService::Cancel(TimerId timer_id) {
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	auto timer = this->timers.find(timer_id);
+	if (timer != this->timers.end()) {
+		auto entry = timer->second;
+		this->wheel[entry->expiry_tick % this->wheel.size()].erase(entry);
+		this->timers.erase(timer);
+		return true;
+	}
+
+	// Wait for the callback to return if it's running, unless we're being
+	// called from within the callback itself
+	if (std::this_thread::get_id() != this->service_thread.get_id()) {
+		this->callback_done.wait(lock, [this, timer_id] {
+			return this->running_timer_id != timer_id;
+		});
+	}
+	return false;
+}
+
+void TimerService::Run() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	int64_t num_slots = this->wheel.size();
+
+	while (!this->is_stopping) {
+		// Nothing to do, sleep until a timer is scheduled
+		if (this->timers.empty()) {
+			this->wake_up.wait(lock);
+			continue;
+		}
+
+		// Collect the timers that have expired. Each slot needs to be looked
+		// at only once, however far behind we are.
+		auto now_tick = GetTick(Clock::now());
+		auto last_tick = std::min(now_tick, this->current_tick + num_slots - 1);
+		auto expired_timers = std::vector<TimerEntry>{};
+
+		for (auto tick = this->current_tick; tick <= last_tick; ++tick) {
+			auto &slot = this->wheel[tick % num_slots];
+			for (auto entry = slot.begin(); entry != slot.end();) {
+				if (entry->expiry_tick <= now_tick) {
+					this->timers.erase(entry->id);
+					expired_timers.push_back(std::move(*entry));
+					entry = slot.erase(entry);
+				} else {
+					++entry;
+				}
+			}
+		}
+		this->current_tick = std::max(this->current_tick, now_tick + 1);
+
+		// Run callbacks without holding the lock, so that they may schedule
+		// or cancel other timers
+		for (auto &expired_timer : expired_timers) {
+			this->running_timer_id = expired_timer.id;
+			lock.unlock();
+			expired_timer.callback();
+			lock.lock();
+			this->running_timer_id = null_timer_id;
+			this->callback_done.notify_all();
+		}
+
+		if (!expired_timers.empty() || this->timers.empty()) {
+			continue;
+		}
+
+		// Sleep till the next occupied slot is due, or a timer is added
+		auto next_tick = GetNextOccupiedTick();
+		this->wake_up.wait_until(lock, this->start_time +
+		                                   next_tick * this->tick_duration);
+	}
+}
+} // namespace drivers
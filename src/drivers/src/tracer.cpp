@@ -0,0 +1,168 @@
+/**
+ * @file tracer.cpp
+ * Definitions for a process wide tracer of game events
+ */
+
+#include "drivers/tracer.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+namespace drivers {
+
+namespace {
+
+/**
+ * Writes a timestamp in microseconds, which the trace format uses
+ */
+void WriteTimestamp(std::ostream &os, int64_t time_ns) {
+	os << time_ns / 1000 << '.' << std::setw(3) << std::setfill('0')
+	   << time_ns % 1000;
+}
+} // namespace
+
+Tracer::Tracer()
+    : is_enabled(false), process_name(), thread_buffers(),
+      thread_buffers_lock() {}
+
+Tracer &Tracer::GetInstance() {
+	static Tracer instance;
+	return instance;
+}
+
+Tracer::ThreadBuffer &Tracer::GetThreadBuffer() {
+	thread_local ThreadBuffer *thread_buffer = nullptr;
+	if (thread_buffer == nullptr) {
+		std::lock_guard<std::mutex> lock(thread_buffers_lock);
+		thread_buffers.emplace_back(new ThreadBuffer());
+		thread_buffer = thread_buffers.back().get();
+		thread_buffer->thread_id = (int)thread_buffers.size();
+		thread_buffer->events.reset(new Event[thread_buffer_size]);
+		thread_buffer->num_events = 0;
+		thread_buffer->num_dropped = 0;
+	}
+	return *thread_buffer;
+}
+
+void Tracer::Record(EventType type, const char *name, int64_t id) {
+	if (!is_enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                   std::chrono::steady_clock::now().time_since_epoch())
+	                   .count();
+	auto &thread_buffer = GetThreadBuffer();
+	auto num_events = thread_buffer.num_events.load(std::memory_order_relaxed);
+	if (num_events == thread_buffer_size) {
+		thread_buffer.num_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	thread_buffer.events[num_events] = Event{name, time_ns, id, type};
+	thread_buffer.num_events.store(num_events + 1, std::memory_order_release);
+}
+
+void Tracer::Enable(std::string process_name) {
+	std::lock_guard<std::mutex> lock(thread_buffers_lock);
+	this->process_name = std::move(process_name);
+	for (auto &thread_buffer : thread_buffers) {
+		thread_buffer->num_events = 0;
+		thread_buffer->num_dropped = 0;
+	}
+	is_enabled = true;
+}
+
+void Tracer::Disable() { is_enabled = false; }
+
+bool Tracer::IsEnabled() const { return is_enabled; }
+
+void Tracer::Begin(const char *name) { Record(EventType::BEGIN, name); }
+
+void Tracer::End(const char *name) { Record(EventType::END, name); }
+
+void Tracer::Instant(const char *name) { Record(EventType::INSTANT, name); }
+
+void Tracer::AsyncBegin(const char *name, int64_t id) {
+	Record(EventType::ASYNC_BEGIN, name, id);
+}
+
+void Tracer::AsyncEnd(const char *name, int64_t id) {
+	Record(EventType::ASYNC_END, name, id);
+}
+
+void Tracer::WriteThreadEvents(std::ostream &os) const {
+	std::lock_guard<std::mutex> lock(thread_buffers_lock);
+	auto pid = getpid();
+	for (auto const &thread_buffer : thread_buffers) {
+		auto num_events =
+		    thread_buffer->num_events.load(std::memory_order_acquire);
+		for (size_t i = 0; i < num_events; ++i) {
+			auto const &event = thread_buffer->events[i];
+			os << R"({"name":")" << event.name << R"(","ph":")"
+			   << static_cast<char>(event.type) << R"(","ts":)";
+			WriteTimestamp(os, event.time_ns);
+			os << R"(,"pid":)" << pid << R"(,"tid":)"
+			   << thread_buffer->thread_id;
+
+			switch (event.type) {
+			case EventType::ASYNC_BEGIN:
+			case EventType::ASYNC_END:
+				os << R"(,"cat":"game","id":)" << event.id;
+				break;
+			case EventType::INSTANT:
+				os << R"(,"s":"t")";
+				break;
+			case EventType::BEGIN:
+			case EventType::END:
+				break;
+			}
+			os << "},\n";
+		}
+
+		// Say how many events are missing from the thread, if any
+		auto num_dropped = thread_buffer->num_dropped.load();
+		if (num_dropped > 0) {
+			os << R"({"name":"thread_name","ph":"M","pid":)" << pid
+			   << R"(,"tid":)" << thread_buffer->thread_id
+			   << R"(,"args":{"name":")" << num_dropped
+			   << R"( events dropped"}},)" << '\n';
+		}
+	}
+}
+
+void Tracer::WriteProcessName(std::ostream &os) const {
+	os << R"({"name":"process_name","ph":"M","pid":)" << getpid()
+	   << R"(,"tid":0,"args":{"name":")" << process_name << R"("}})";
+}
+
+void Tracer::WriteEvents(std::ostream &os) const {
+	WriteThreadEvents(os);
+	WriteProcessName(os);
+	os << ",\n";
+}
+
+void Tracer::WriteTrace(
+    std::ostream &os, const std::vector<std::string> &event_file_names) const {
+	os << R"({"traceEvents":[)" << '\n';
+	for (auto const &event_file_name : event_file_names) {
+		std::ifstream event_file(event_file_name);
+		if (event_file && event_file.peek() != EOF) {
+			os << event_file.rdbuf();
+		}
+	}
+
+	// Every other event is followed by a comma, so the list ends with the
+	// name of this process
+	WriteThreadEvents(os);
+	WriteProcessName(os);
+	os << "\n]}\n";
+}
+
+TraceScope::TraceScope(const char *name) : name(name) {
+	Tracer::GetInstance().Begin(name);
+}
+
+TraceScope::~TraceScope() { Tracer::GetInstance().End(name); }
+} // namespace drivers
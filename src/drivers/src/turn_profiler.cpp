@@ -0,0 +1,175 @@
+/**
+ * @file turn_profiler.cpp
+ * Definitions for timing each phase of a game's turns
+ */
+
+#include "drivers/turn_profiler.h"
+#include "drivers/perf_counters.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace drivers {
+
+const std::array<const char *, NUM_TURN_PHASES> TURN_PHASE_NAMES = {
+    {"PLAYER_1_TURN", "PLAYER_2_TURN", "TO_PLAYER_STATES", "UPDATE_MAIN_STATE",
+     "UPDATE_PLAYER_STATE", "TO_TRANSFER_STATE", "LOG_STATE",
+     "POST_SIMULATION", "TURN"}};
+
+LatencyHistogram::LatencyHistogram() : bucket_counts(), count(0), max_ns(0) {}
+
+size_t LatencyHistogram::GetBucket(uint64_t latency_ns) {
+	if (latency_ns < NUM_SUB_BUCKETS) {
+		return latency_ns;
+	}
+
+	// Find the power of two the latency falls in, then the bucket within it
+	int shift = 0;
+	while ((latency_ns >> shift) >= 2 * NUM_SUB_BUCKETS) {
+		++shift;
+	}
+	auto sub_bucket = (latency_ns >> shift) & (NUM_SUB_BUCKETS - 1);
+	return (shift + 1) * NUM_SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t bucket) {
+	if (bucket < NUM_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	auto shift = bucket / NUM_SUB_BUCKETS - 1;
+	auto sub_bucket = bucket % NUM_SUB_BUCKETS;
+	auto lower_bound = (uint64_t)(NUM_SUB_BUCKETS + sub_bucket) << shift;
+	return lower_bound + ((uint64_t)1 << shift) - 1;
+}
+
+void LatencyHistogram::Record(std::chrono::nanoseconds latency) {
+	auto latency_ns = std::max<int64_t>(latency.count(), 0);
+	++bucket_counts[GetBucket(latency_ns)];
+	++count;
+	max_ns = std::max(max_ns, latency_ns);
+}
+
+int64_t LatencyHistogram::GetCount() const { return count; }
+
+std::chrono::nanoseconds
+LatencyHistogram::GetPercentile(double percentile) const {
+	if (count == 0) {
+		return std::chrono::nanoseconds(0);
+	}
+
+	// Number of latencies at or below the percentile, at least one
+	auto rank = (int64_t)std::ceil(percentile / 100 * count);
+	rank = std::min(std::max<int64_t>(rank, 1), count);
+
+	int64_t seen = 0;
+	for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+		seen += bucket_counts[bucket];
+		if (seen >= rank) {
+			auto upper_bound = GetBucketUpperBound(bucket);
+			return std::chrono::nanoseconds(
+			    (int64_t)std::min<uint64_t>(upper_bound, max_ns));
+		}
+	}
+	return GetMax();
+}
+
+std::chrono::nanoseconds LatencyHistogram::GetMax() const {
+	return std::chrono::nanoseconds(max_ns);
+}
+
+namespace {
+
+void AddCounters(logger::PhaseCounters &total,
+                 const logger::PhaseCounters &counters) {
+	total.instructions += counters.instructions;
+	total.cycles += counters.cycles;
+	total.cache_misses += counters.cache_misses;
+	total.branch_misses += counters.branch_misses;
+}
+
+logger::PhaseCounters SubtractCounters(const logger::PhaseCounters &end,
+                                       const logger::PhaseCounters &start) {
+	return {end.instructions - start.instructions, end.cycles - start.cycles,
+	        end.cache_misses - start.cache_misses,
+	        end.branch_misses - start.branch_misses};
+}
+} // namespace
+
+TurnProfiler::TurnProfiler(bool count_events)
+    : histograms(), count_events(count_events), phase_counters(),
+      has_phase_counters(), turn_counters(), has_turn_counters(false) {}
+
+void TurnProfiler::Record(TurnPhase phase, std::chrono::nanoseconds latency) {
+	histograms[static_cast<size_t>(phase)].Record(latency);
+}
+
+TurnProfiler::Clock::time_point
+TurnProfiler::RecordSince(TurnPhase phase, Clock::time_point start) {
+	auto now = Clock::now();
+	Record(phase, now - start);
+	return now;
+}
+
+TurnProfiler::Mark TurnProfiler::GetMark() const {
+	auto mark = Mark{Clock::now(), false, {}};
+	if (count_events) {
+		mark.has_counters =
+		    PerfCounters::GetThreadCounters().Read(mark.counters);
+	}
+	return mark;
+}
+
+void TurnProfiler::Record(TurnPhase phase, const Mark &start,
+                          const Mark &end) {
+	Record(phase, end.time - start.time);
+	if (!start.has_counters || !end.has_counters) {
+		return;
+	}
+
+	auto counters = SubtractCounters(end.counters, start.counters);
+	auto phase_index = static_cast<size_t>(phase);
+	AddCounters(phase_counters[phase_index], counters);
+	has_phase_counters[phase_index] = true;
+
+	// The work of the other phases overlaps, so it isn't counted twice
+	if (phase != TurnPhase::POST_SIMULATION) {
+		AddCounters(turn_counters, counters);
+		has_turn_counters = true;
+	}
+}
+
+TurnProfiler::Mark TurnProfiler::RecordSince(TurnPhase phase,
+                                             const Mark &start) {
+	auto now = GetMark();
+	Record(phase, start, now);
+	return now;
+}
+
+void TurnProfiler::RecordTurn(Clock::time_point start) {
+	auto turn_index = static_cast<size_t>(TurnPhase::TURN);
+	RecordSince(TurnPhase::TURN, start);
+	if (has_turn_counters) {
+		AddCounters(phase_counters[turn_index], turn_counters);
+		has_phase_counters[turn_index] = true;
+	}
+	turn_counters = logger::PhaseCounters{};
+	has_turn_counters = false;
+}
+
+logger::TurnProfile TurnProfiler::GetProfile() const {
+	auto turn_profile = logger::TurnProfile{};
+	for (size_t i = 0; i < NUM_TURN_PHASES; ++i) {
+		auto const &histogram = histograms[i];
+		if (histogram.GetCount() == 0) {
+			continue;
+		}
+		turn_profile.push_back(
+		    {TURN_PHASE_NAMES[i], histogram.GetCount(),
+		     histogram.GetPercentile(50).count(),
+		     histogram.GetPercentile(99).count(), histogram.GetMax().count(),
+		     has_phase_counters[i], phase_counters[i]});
+	}
+	return turn_profile;
+}
+} // namespace drivers
@@ -7,9 +7,11 @@
 
 #include "constants/constants.h"
 #include "drivers/main_driver.h"
+#include "drivers/match_engine.h"
 #include "drivers/shared_memory_utils/shared_memory_main.h"
 #include "drivers/timer.h"
 #include "game/game_export.h"
+#include "game/interfaces/i_player_launcher.h"
 #include "logger/logger.h"
 #include "physics/vector.hpp"
 #include "simulator_constants/constants.h"
@@ -25,8 +27,10 @@
 #include "state/state_syncer.h"
 #include "state/utilities.h"
 
+#include <array>
 #include <cstdio>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <random>
@@ -42,8 +46,32 @@ class GAME_EXPORT Game {
 	 */
 	std::unique_ptr<drivers::MainDriver> main_driver;
 
+	/**
+	 * Names of the shared memories the main driver talks to the players on
+	 */
+	std::array<std::string, 2> shm_names;
+
+	/**
+	 * Starts the players' code for the match
+	 */
+	std::unique_ptr<IPlayerLauncher> player_launcher;
+
+	/**
+	 * Engine that runs the main driver, or nullptr to run it on a thread of
+	 * its own
+	 */
+	drivers::MatchEngine *match_engine;
+
   public:
-	Game(std::unique_ptr<drivers::MainDriver> main_driver);
+	/**
+	 * Called with the result of the game once it's over
+	 */
+	typedef std::function<void(const drivers::GameResult &)> Callback;
+
+	Game(std::unique_ptr<drivers::MainDriver> main_driver,
+	     std::array<std::string, 2> shm_names,
+	     std::unique_ptr<IPlayerLauncher> player_launcher,
+	     drivers::MatchEngine *match_engine = nullptr);
 
 	/**
 	 * Static helper method to generate a random string
@@ -56,9 +84,38 @@ class GAME_EXPORT Game {
 	GenerateRandomString(const std::string::size_type length);
 
 	/**
-	 * Creates and starts the main driver
+	 * Launches the players and starts the main driver, without waiting for
+	 * the game to end
+	 *
+	 * The callback is called once the driver is done and both players have
+	 * exited, on the thread that saw the last of them. That's the engine's
+	 * thread if the driver was last. The game must stay alive till then, and
+	 * may be destroyed in the callback.
+	 *
+	 * @param callback Called with the result of the game
+	 */
+	void Start(Callback callback);
+
+	/**
+	 * Launches the players and runs the main driver, and waits for the game
+	 * to end
 	 *
 	 * @return GameResult object with winner, win type, and player results
 	 */
 	const drivers::GameResult Start();
+
+	/**
+	 * Gets how long each phase of the game's turns took
+	 *
+	 * @return Latencies of each phase that was timed
+	 */
+	logger::TurnProfile GetTurnProfile() const;
+
+	/**
+	 * Gets the current and peak memory each subsystem of the game holds. May
+	 * be called from any thread while the game runs.
+	 *
+	 * @return Memory of each subsystem
+	 */
+	drivers::MemoryReport GetMemoryReport() const;
 };
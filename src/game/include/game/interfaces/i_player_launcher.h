@@ -0,0 +1,30 @@
+/**
+ * @file i_player_launcher.h
+ * Declarations for the interface that starts players for a match
+ */
+
+#pragma once
+
+#include "game/game_export.h"
+#include "game/interfaces/i_player_process.h"
+
+#include <memory>
+#include <string>
+
+/**
+ * Interface to start the players' code for a match
+ */
+class GAME_EXPORT IPlayerLauncher {
+  public:
+	virtual ~IPlayerLauncher() {}
+
+	/**
+	 * Starts a player's code, attached to the given shared memory
+	 *
+	 * @param player_id Index of the player, 0 or 1
+	 * @param shm_name Name of the shared memory the player's driver uses
+	 * @return std::unique_ptr<IPlayerProcess> The running player
+	 */
+	virtual std::unique_ptr<IPlayerProcess>
+	Launch(int player_id, const std::string &shm_name) = 0;
+};
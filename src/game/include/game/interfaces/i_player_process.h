@@ -0,0 +1,31 @@
+/**
+ * @file i_player_process.h
+ * Declarations for the interface to a running player
+ */
+
+#pragma once
+
+#include "game/game_export.h"
+
+/**
+ * Interface to a player's code running a match in some process
+ */
+class GAME_EXPORT IPlayerProcess {
+  public:
+	virtual ~IPlayerProcess() {}
+
+	/**
+	 * Get the ID of the process the player runs in
+	 *
+	 * Signals sent to it stop the player
+	 */
+	virtual int GetPid() = 0;
+
+	/**
+	 * Blocks until the player is done with the match
+	 *
+	 * @return 0 if the player finished normally, the process exit code, or
+	 *         128 and the terminating signal if it was killed, otherwise
+	 */
+	virtual int Wait() = 0;
+};
@@ -0,0 +1,98 @@
+/**
+ * @file match_server.h
+ * Declarations for the server that takes match jobs over a Unix socket
+ */
+
+#pragma once
+
+#include "game/game_export.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+
+/**
+ * Serves match jobs on a local Unix socket
+ *
+ * Every connection carries a single job, one line of text, and is answered
+ * with the handler's reply on a line of its own. Jobs are handed to the
+ * handler one after the other, in the order they're accepted, but the handler
+ * only starts them. They run at the same time, and each is replied to
+ * whenever it's done.
+ */
+class GAME_EXPORT MatchServer {
+  public:
+	/**
+	 * Sends the reply to a job. Can be called from any thread, once.
+	 */
+	typedef std::function<void(const std::string &reply)> Reply;
+
+	/**
+	 * Starts a job, without waiting for it to be done, and has the reply
+	 * sent to it when it is
+	 */
+	typedef std::function<void(const std::string &job, Reply reply)> Handler;
+
+  private:
+	/**
+	 * Path of the socket file
+	 */
+	std::string socket_path;
+
+	/**
+	 * Runs every job that comes in
+	 */
+	Handler handler;
+
+	/**
+	 * Listening socket
+	 */
+	int socket_fd;
+
+	/**
+	 * Set to stop serving
+	 */
+	std::atomic_bool is_stopped;
+
+	/**
+	 * Reads a job from a connection and starts it
+	 */
+	void Serve(int connection_fd);
+
+  public:
+	/**
+	 * Maximum length of a job line
+	 */
+	static const size_t max_job_length = 4096;
+
+	/**
+	 * Longest a client may take to send its job, in seconds, as no other
+	 * connection is accepted while it's read
+	 */
+	static const int max_job_read_seconds = 5;
+
+	/**
+	 * Constructor, starts listening on the socket
+	 *
+	 * A stale socket file at socket_path is replaced.
+	 *
+	 * @throw std::system_error If the socket couldn't be set up
+	 */
+	MatchServer(std::string socket_path, Handler handler);
+
+	/**
+	 * Destructor. Closes the socket and removes the socket file.
+	 */
+	~MatchServer();
+
+	/**
+	 * Blocking function that serves jobs until Stop is called
+	 */
+	void Run();
+
+	/**
+	 * Makes Run return once the job being read, if any, is started. Jobs
+	 * still running are replied to when they're done.
+	 */
+	void Stop();
+};
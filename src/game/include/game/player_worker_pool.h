@@ -0,0 +1,88 @@
+/**
+ * @file player_worker_pool.h
+ * Declarations for the pool of warm player worker processes
+ */
+
+#pragma once
+
+#include "game/game_export.h"
+#include "game/interfaces/i_player_launcher.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Pool of warm player worker processes, each used for a single match
+ *
+ * Workers are player_worker processes, started ahead of time so that a match
+ * doesn't wait for one. A worker loads a player's code library for its match
+ * and exits once the match is done. It's never handed another match, as
+ * untrusted player code may leave threads, exit hooks or a library that
+ * won't unload behind in it. Each worker is replaced by a new one as soon as
+ * its match is over.
+ */
+class GAME_EXPORT PlayerWorkerPool {
+  public:
+	/**
+	 * A worker process, and the pipe it takes its job on
+	 */
+	struct Worker;
+
+  private:
+	/**
+	 * Path to the player_worker executable
+	 */
+	std::string worker_path;
+
+	/**
+	 * Workers that are alive and not running a match
+	 */
+	std::vector<std::unique_ptr<Worker>> idle_workers;
+
+	/**
+	 * Guards idle_workers
+	 */
+	std::mutex idle_workers_lock;
+
+	/**
+	 * Starts a new worker process
+	 */
+	std::unique_ptr<Worker> Spawn();
+
+  public:
+	/**
+	 * Constructor, starts num_workers workers
+	 */
+	PlayerWorkerPool(std::string worker_path, size_t num_workers);
+
+	/**
+	 * Destructor. Closes the idle workers' job pipes, letting them exit.
+	 */
+	~PlayerWorkerPool();
+
+	/**
+	 * Takes an idle worker out of the pool, starting one if there are none
+	 */
+	std::unique_ptr<Worker> Acquire();
+
+	/**
+	 * Gets rid of a worker once its match is over, stopping it if it's still
+	 * running, and starts a new one in its place
+	 */
+	void Release(std::unique_ptr<Worker> worker);
+
+	/**
+	 * Get a launcher that runs the given player code libraries for a match,
+	 * on workers from this pool
+	 *
+	 * @param library_paths Paths to the players' code libraries
+	 * @param debug_log_paths Files the players' debug logs are written to
+	 * @return std::unique_ptr<IPlayerLauncher> Launcher for one match
+	 */
+	std::unique_ptr<IPlayerLauncher>
+	GetLauncher(std::array<std::string, 2> library_paths,
+	            std::array<std::string, 2> debug_log_paths);
+};
@@ -0,0 +1,24 @@
+/**
+ * @file process_player_launcher.h
+ * Declarations for the launcher that spawns a process per player
+ */
+
+#pragma once
+
+#include "game/game_export.h"
+#include "game/interfaces/i_player_launcher.h"
+
+/**
+ * Runs each player in a fresh ./player_N process
+ *
+ * The shared memory name is handed over through the player's SHM file, which
+ * the player process removes once it's read
+ */
+class GAME_EXPORT ProcessPlayerLauncher : public IPlayerLauncher {
+  public:
+	/**
+	 * @see IPlayerLauncher#Launch
+	 */
+	std::unique_ptr<IPlayerProcess>
+	Launch(int player_id, const std::string &shm_name) override;
+};
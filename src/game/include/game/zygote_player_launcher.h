@@ -0,0 +1,71 @@
+/**
+ * @file zygote_player_launcher.h
+ * Declarations for the launcher that forks players off zygote processes
+ */
+
+#pragma once
+
+#include "game/game_export.h"
+#include "game/interfaces/i_player_launcher.h"
+
+#include <array>
+#include <memory>
+#include <string>
+
+/**
+ * Runs each player in a process forked off a zygote
+ *
+ * A zygote is a player_worker process started in zygote mode. It's linked
+ * with the drivers and state and fully relocated up front, so a player only
+ * costs a fork and loading its code library. Every match still runs in a
+ * fresh process of its own, and the zygote reports how it exited.
+ *
+ * Each player has its own zygote, which is started as soon as the launcher
+ * is constructed.
+ */
+class GAME_EXPORT ZygotePlayerLauncher : public IPlayerLauncher {
+  public:
+	/**
+	 * A zygote process, and the pipes it takes jobs and gives replies on
+	 */
+	struct Zygote;
+
+  private:
+	/**
+	 * Zygotes of the two players
+	 */
+	std::array<std::unique_ptr<Zygote>, 2> zygotes;
+
+	/**
+	 * Paths to the players' code libraries
+	 */
+	std::array<std::string, 2> library_paths;
+
+	/**
+	 * Files the players' debug logs are written to
+	 */
+	std::array<std::string, 2> debug_log_paths;
+
+  public:
+	/**
+	 * Constructor, starts the zygotes
+	 *
+	 * @param zygote_path Path to the player_worker executable
+	 * @param library_paths Paths to the players' code libraries
+	 * @param debug_log_paths Files the players' debug logs are written to
+	 */
+	ZygotePlayerLauncher(const std::string &zygote_path,
+	                     std::array<std::string, 2> library_paths,
+	                     std::array<std::string, 2> debug_log_paths);
+
+	/**
+	 * Destructor. Closes the zygotes' job pipes, letting them exit.
+	 */
+	~ZygotePlayerLauncher() override;
+
+	/**
+	 * @see IPlayerLauncher#Launch
+	 */
+	std::unique_ptr<IPlayerProcess>
+	Launch(int player_id, const std::string &shm_name) override;
+};
@@ -4,13 +4,22 @@
  */
 
 #include "game/game.h"
-#include "boost/process.hpp"
 #include "drivers/game_result.h"
-
-namespace bp = boost::process;
-
-Game::Game(std::unique_ptr<drivers::MainDriver> main_driver)
-    : main_driver(std::move(main_driver)) {}
+#include "drivers/player_driver.h"
+
+#include <atomic>
+#include <csignal>
+#include <future>
+#include <thread>
+#include <vector>
+
+Game::Game(std::unique_ptr<drivers::MainDriver> main_driver,
+           std::array<std::string, 2> shm_names,
+           std::unique_ptr<IPlayerLauncher> player_launcher,
+           drivers::MatchEngine *match_engine)
+    : main_driver(std::move(main_driver)), shm_names(std::move(shm_names)),
+      player_launcher(std::move(player_launcher)),
+      match_engine(match_engine) {}
 
 std::string Game::GenerateRandomString(const std::string::size_type length) {
 	using namespace std;
@@ -30,86 +39,166 @@ std::string Game::GenerateRandomString(const std::string::size_type length) {
 	return s;
 }
 
-const drivers::GameResult Game::Start() {
-	// Launching player child processes
-	std::vector<bp::child> player_processes;
-	std::vector<std::error_code> player_process_errors(2);
-	for (int i = 0; i < 2; ++i) {
-		player_processes.emplace_back("./player_" + std::to_string(i + 1), "",
-		                              player_process_errors[i]);
-	}
+namespace {
+
+/**
+ * What the main driver and the player monitors of a started game share.
+ * Whichever of them is done last finishes the game.
+ */
+struct GameRun {
+	drivers::MainDriver *main_driver;
+
+	std::vector<std::unique_ptr<IPlayerProcess>> player_processes;
 
-	main_driver->SetPids(
-	    std::array<int, 2>{player_processes[0].id(), player_processes[1].id()});
+	Game::Callback callback;
 
-	// Starting main driver
+	/**
+	 * Result from the main driver, set before it counts itself done
+	 */
 	drivers::GameResult result;
-	std::thread main_runner(
-	    [this, &result] { result = this->main_driver->Start(); });
 
-	// Monitor child processes
-	// If one fails, terminate the rest
+	/**
+	 * Players the driver stopped for running out of time
+	 */
+	std::array<std::atomic_bool, 2> players_stopped;
+
+	/**
+	 * Players that exited with an error
+	 */
+	std::array<std::atomic_bool, 2> players_failed;
+
+	std::atomic_bool any_player_failed;
 
-	std::vector<std::atomic_bool> players_failed(2);
-	std::atomic_bool any_player_failed(false);
-	std::vector<std::thread> player_monitors;
+	/**
+	 * Number of the main driver and the player monitors not done yet
+	 */
+	std::atomic_int num_running;
+};
 
-	// For each player...
+/**
+ * Counts one of the main driver and the player monitors done, and finishes
+ * the game if it was the last one
+ */
+void FinishGameRun(GameRun &run) {
+	if (--run.num_running > 0) {
+		return;
+	}
+
+	auto &result = run.result;
 	for (int player_id = 0; player_id < 2; ++player_id) {
+		if (run.players_failed[player_id]) {
+			result.player_results[player_id].status =
+			    drivers::PlayerResult::Status::RUNTIME_ERROR;
+			result.win_type = drivers::GameResult::WinType::RUNTIME_ERROR;
+		}
+	}
 
-		// Get both processes, including the opponents'
-		auto &process = player_processes[player_id];
-		auto &other_process = player_processes[1 - player_id];
-
-		players_failed[player_id] = false;
-		auto &player_failed = players_failed[player_id];
-
-		// Start the player_monitors
-		player_monitors.emplace_back(
-		    [&process, &other_process, &player_failed, &any_player_failed] {
-			    // Wait for the player processes to exit
-			    process.wait();
-
-			    // If the process did not exit gracefully, suspend the game and
-			    // kill the other player process
-			    if (process.exit_code() != 0 && !any_player_failed) {
-				    player_failed = true;
-				    any_player_failed = true;
-				    kill(other_process.id(), SIGTERM);
-			    }
-		    });
+	// Assign winner
+	if (run.players_failed[0] && run.players_failed[1]) {
+		// This case is currently impossible. Driver quits on Player1 Error
+		result.winner = drivers::GameResult::Winner::TIE;
+	} else if (run.players_failed[0]) {
+		result.winner = drivers::GameResult::Winner::PLAYER2;
+	} else if (run.players_failed[1]) {
+		result.winner = drivers::GameResult::Winner::PLAYER1;
 	}
 
-	for (auto &monitor : player_monitors) {
-		monitor.join();
+	// The processes may refer to the launcher, which the callback may destroy
+	// along with the game
+	run.player_processes.clear();
+	auto callback = std::move(run.callback);
+	callback(result);
+}
+} // namespace
+
+void Game::Start(Callback callback) {
+	auto run = std::make_shared<GameRun>();
+	run->main_driver = this->main_driver.get();
+	run->callback = std::move(callback);
+	run->any_player_failed = false;
+	run->num_running = 3;
+
+	// Launching players
+	for (int i = 0; i < 2; ++i) {
+		run->players_stopped[i] = false;
+		run->players_failed[i] = false;
+		run->player_processes.push_back(
+		    player_launcher->Launch(i, this->shm_names[i]));
 	}
 
-	// If any child process failed, stop the main_driver
-	// Otherwise, simply wait for the main_driver to wrap up
-	if (any_player_failed) {
-		main_driver->Cancel();
-		main_runner.join();
+	// Starting main driver, on the engine if there is one
+	// Players that ran out of time are still stuck in their turn once the
+	// driver is done, so they're stopped here
+	auto on_driver_done = [run](const drivers::GameResult &outcome) {
+		run->result = outcome;
 		for (int player_id = 0; player_id < 2; ++player_id) {
-			if (players_failed[player_id]) {
-				result.player_results[player_id].status =
-				    drivers::PlayerResult::Status::RUNTIME_ERROR;
-				result.win_type = drivers::GameResult::WinType::RUNTIME_ERROR;
+			using Status = drivers::PlayerResult::Status;
+			auto status = run->result.player_results[player_id].status;
+			auto pid = run->player_processes[player_id]->GetPid();
+			if ((status == Status::TIMEOUT ||
+			     status == Status::EXCEEDED_TURN_DURATION) &&
+			    pid > 0) {
+				run->players_stopped[player_id] = true;
+				kill(pid, SIGKILL);
 			}
 		}
+		FinishGameRun(*run);
+	};
 
-		// Assign winner
-		if (players_failed[0] && players_failed[1]) {
-			// This case is currently impossible. Driver quits on Player1 Error
-			result.winner = drivers::GameResult::Winner::TIE;
-		} else if (players_failed[0]) {
-			result.winner = drivers::GameResult::Winner::PLAYER2;
-		} else if (players_failed[1]) {
-			result.winner = drivers::GameResult::Winner::PLAYER1;
-		}
-
+	if (this->match_engine) {
+		this->match_engine->Add(this->main_driver.get(), on_driver_done);
 	} else {
-		main_runner.join();
+		std::thread([run, on_driver_done] {
+			on_driver_done(run->main_driver->Start());
+		}).detach();
 	}
 
-	return result;
+	// Monitor child processes
+	// If one fails, terminate the rest, and stop the main driver
+	// The monitors are detached, as the game may be destroyed by its callback
+	// on any of them
+	for (int player_id = 0; player_id < 2; ++player_id) {
+		std::thread([run, player_id] {
+			// Get both processes, including the opponents'
+			auto &process = *run->player_processes[player_id];
+			auto &other_process = *run->player_processes[1 - player_id];
+
+			// Wait for the players to be done
+			auto exit_code = process.Wait();
+
+			// If the process did not exit gracefully, suspend the game and
+			// kill the other player process. A player that was stopped for
+			// going past the instruction limit or for running out of time is
+			// dealt with by the main driver.
+			auto limit_exit_code =
+			    drivers::PlayerDriver::exceeded_instruction_limit_exit_code;
+			if (exit_code != 0 && exit_code != limit_exit_code &&
+			    !run->players_stopped[player_id] &&
+			    !run->any_player_failed.exchange(true)) {
+				run->players_failed[player_id] = true;
+				if (other_process.GetPid() > 0) {
+					kill(other_process.GetPid(), SIGTERM);
+				}
+				run->main_driver->Cancel();
+			}
+			FinishGameRun(*run);
+		}).detach();
+	}
+}
+
+const drivers::GameResult Game::Start() {
+	auto game_done = std::make_shared<std::promise<drivers::GameResult>>();
+	auto result = game_done->get_future();
+	Start([game_done](const drivers::GameResult &result) {
+		game_done->set_value(result);
+	});
+	return result.get();
+}
+
+logger::TurnProfile Game::GetTurnProfile() const {
+	return main_driver->GetTurnProfile();
+}
+
+drivers::MemoryReport Game::GetMemoryReport() const {
+	return main_driver->GetMemoryReport();
 }
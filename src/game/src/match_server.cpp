@@ -0,0 +1,116 @@
+/**
+ * @file match_server.cpp
+ * Defines the server that takes match jobs over a Unix socket
+ */
+
+#include "game/match_server.h"
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+
+MatchServer::MatchServer(std::string socket_path, Handler handler)
+    : socket_path(std::move(socket_path)), handler(std::move(handler)),
+      socket_fd(-1), is_stopped(false) {
+	auto address = sockaddr_un{};
+	address.sun_family = AF_UNIX;
+	if (this->socket_path.size() >= sizeof(address.sun_path)) {
+		throw std::system_error(ENAMETOOLONG, std::generic_category(),
+		                        "Socket path too long");
+	}
+	std::strcpy(address.sun_path, this->socket_path.c_str());
+
+	socket_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (socket_fd < 0) {
+		throw std::system_error(errno, std::generic_category(),
+		                        "Could not create socket");
+	}
+
+	unlink(this->socket_path.c_str());
+	if (bind(socket_fd, reinterpret_cast<sockaddr *>(&address),
+	         sizeof(address)) < 0 ||
+	    listen(socket_fd, SOMAXCONN) < 0) {
+		auto error = errno;
+		close(socket_fd);
+		throw std::system_error(error, std::generic_category(),
+		                        "Could not listen on " + this->socket_path);
+	}
+}
+
+MatchServer::~MatchServer() {
+	close(socket_fd);
+	unlink(socket_path.c_str());
+}
+
+void MatchServer::Run() {
+	while (not is_stopped) {
+		auto connection_fd = accept4(socket_fd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (connection_fd < 0) {
+			// Stop shuts the socket down, failing the accept
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			break;
+		}
+
+		Serve(connection_fd);
+	}
+}
+
+void MatchServer::Stop() {
+	is_stopped = true;
+	shutdown(socket_fd, SHUT_RDWR);
+}
+
+void MatchServer::Serve(int connection_fd) {
+	// The connection is closed once the reply is sent, or once the handler
+	// drops the job without one
+	auto connection =
+	    std::shared_ptr<int>(new int(connection_fd), [](int *fd) {
+		    close(*fd);
+		    delete fd;
+	    });
+
+	// A client that's slow to send its job mustn't hold up the others
+	auto timeout = timeval{max_job_read_seconds, 0};
+	setsockopt(connection_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+	           sizeof(timeout));
+
+	// Read up to the end of the line
+	auto job = std::string{};
+	char buffer[256];
+	while (job.find('\n') == std::string::npos &&
+	       job.size() < max_job_length) {
+		auto length = read(connection_fd, buffer, sizeof(buffer));
+		if (length < 0 && errno == EINTR) {
+			continue;
+		}
+		if (length <= 0) {
+			break;
+		}
+		job.append(buffer, length);
+	}
+	job = job.substr(0, job.find('\n'));
+
+	handler(job, [connection](const std::string &reply) {
+		auto line = reply + '\n';
+
+		// The client may have gone away already, which is fine
+		for (size_t written = 0; written < line.size();) {
+			auto length = send(*connection, line.data() + written,
+			                   line.size() - written, MSG_NOSIGNAL);
+			if (length < 0 && errno == EINTR) {
+				continue;
+			}
+			if (length <= 0) {
+				break;
+			}
+			written += length;
+		}
+	});
+}
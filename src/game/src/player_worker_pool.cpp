@@ -0,0 +1,156 @@
+/**
+ * @file player_worker_pool.cpp
+ * Defines the pool of reusable player worker processes
+ */
+
+#include "game/player_worker_pool.h"
+#include "boost/process.hpp"
+
+#include <cstdlib>
+#include <sys/wait.h>
+#include <system_error>
+
+namespace bp = boost::process;
+
+struct PlayerWorkerPool::Worker {
+	/**
+	 * Pipe that the worker's one job is written to
+	 */
+	bp::opstream jobs;
+
+	/**
+	 * Error from launching or waiting on the process, if any
+	 */
+	std::error_code error;
+
+	/**
+	 * The worker process
+	 */
+	bp::child process;
+
+	Worker(const std::string &worker_path)
+	    : process(worker_path, bp::std_in < jobs, error) {}
+};
+
+namespace {
+
+/**
+ * A player running a match on a pooled worker
+ */
+class PooledPlayerProcess : public IPlayerProcess {
+	PlayerWorkerPool *pool;
+
+	std::unique_ptr<PlayerWorkerPool::Worker> worker;
+
+  public:
+	PooledPlayerProcess(PlayerWorkerPool *pool,
+	                    std::unique_ptr<PlayerWorkerPool::Worker> worker,
+	                    const std::string &shm_name,
+	                    const std::string &library_path,
+	                    const std::string &debug_log_path)
+	    : pool(pool), worker(std::move(worker)) {
+		this->worker->jobs << shm_name << ' ' << library_path << ' '
+		                   << debug_log_path << std::endl;
+		this->worker->jobs.pipe().close();
+	}
+
+	~PooledPlayerProcess() override { pool->Release(std::move(worker)); }
+
+	int GetPid() override { return worker->process.id(); }
+
+	int Wait() override {
+		// The worker exits with the match's status once it's over. A worker
+		// that was killed is reported apart from any status it could exit
+		// with, as 128 and the signal.
+		worker->process.wait(worker->error);
+		if (worker->error) {
+			return EXIT_FAILURE;
+		}
+		auto status = worker->process.native_exit_code();
+		if (WIFSIGNALED(status)) {
+			return 128 + WTERMSIG(status);
+		}
+		return WEXITSTATUS(status);
+	}
+};
+
+/**
+ * Runs a match's players on workers from the pool
+ */
+class PooledPlayerLauncher : public IPlayerLauncher {
+	PlayerWorkerPool *pool;
+
+	std::array<std::string, 2> library_paths;
+
+	std::array<std::string, 2> debug_log_paths;
+
+  public:
+	PooledPlayerLauncher(PlayerWorkerPool *pool,
+	                     std::array<std::string, 2> library_paths,
+	                     std::array<std::string, 2> debug_log_paths)
+	    : pool(pool), library_paths(std::move(library_paths)),
+	      debug_log_paths(std::move(debug_log_paths)) {}
+
+	std::unique_ptr<IPlayerProcess>
+	Launch(int player_id, const std::string &shm_name) override {
+		return std::make_unique<PooledPlayerProcess>(
+		    pool, pool->Acquire(), shm_name, library_paths[player_id],
+		    debug_log_paths[player_id]);
+	}
+};
+} // namespace
+
+PlayerWorkerPool::PlayerWorkerPool(std::string worker_path,
+                                   size_t num_workers)
+    : worker_path(std::move(worker_path)) {
+	for (size_t i = 0; i < num_workers; ++i) {
+		idle_workers.push_back(Spawn());
+	}
+}
+
+PlayerWorkerPool::~PlayerWorkerPool() {
+	// Idle workers exit once they find they have no job
+	for (auto &worker : idle_workers) {
+		worker->jobs.pipe().close();
+	}
+	for (auto &worker : idle_workers) {
+		worker->process.wait(worker->error);
+	}
+}
+
+std::unique_ptr<PlayerWorkerPool::Worker> PlayerWorkerPool::Spawn() {
+	return std::make_unique<Worker>(worker_path);
+}
+
+std::unique_ptr<PlayerWorkerPool::Worker> PlayerWorkerPool::Acquire() {
+	std::lock_guard<std::mutex> guard(idle_workers_lock);
+
+	// Skip workers that died while waiting for their job
+	while (not idle_workers.empty()) {
+		auto worker = std::move(idle_workers.back());
+		idle_workers.pop_back();
+		if (worker->process.running(worker->error)) {
+			return worker;
+		}
+	}
+
+	return Spawn();
+}
+
+void PlayerWorkerPool::Release(std::unique_ptr<Worker> worker) {
+	// Make sure the worker is gone, and keep the pool warm with a new one
+	if (worker->process.running(worker->error)) {
+		worker->process.terminate(worker->error);
+	}
+	worker = Spawn();
+
+	std::lock_guard<std::mutex> guard(idle_workers_lock);
+	idle_workers.push_back(std::move(worker));
+}
+
+std::unique_ptr<IPlayerLauncher>
+PlayerWorkerPool::GetLauncher(std::array<std::string, 2> library_paths,
+                              std::array<std::string, 2> debug_log_paths) {
+	return std::make_unique<PooledPlayerLauncher>(
+	    this, std::move(library_paths), std::move(debug_log_paths));
+}
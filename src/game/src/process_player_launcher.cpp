@@ -0,0 +1,68 @@
+/**
+ * @file process_player_launcher.cpp
+ * Defines the launcher that spawns a process per player
+ */
+
+#include "game/process_player_launcher.h"
+#include "boost/process.hpp"
+#include "simulator_constants/constants.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sys/wait.h>
+#include <system_error>
+
+namespace bp = boost::process;
+
+namespace {
+
+/**
+ * A player running in a child process of its own
+ */
+class ChildPlayerProcess : public IPlayerProcess {
+	/**
+	 * The player process
+	 */
+	bp::child process;
+
+	/**
+	 * Error from launching or waiting on the process, if any
+	 */
+	std::error_code error;
+
+  public:
+	ChildPlayerProcess(const std::string &executable)
+	    : process(executable, "", error) {}
+
+	int GetPid() override { return process.id(); }
+
+	int Wait() override {
+		if (error) {
+			return EXIT_FAILURE;
+		}
+
+		// A killed player is reported as 128 and the signal, as the signal
+		// alone could pass for an exit code the game treats specially
+		process.wait(error);
+		if (error) {
+			return EXIT_FAILURE;
+		}
+		auto status = process.native_exit_code();
+		if (WIFSIGNALED(status)) {
+			return 128 + WTERMSIG(status);
+		}
+		return WEXITSTATUS(status);
+	}
+};
+} // namespace
+
+std::unique_ptr<IPlayerProcess>
+ProcessPlayerLauncher::Launch(int player_id, const std::string &shm_name) {
+	// Write the SHM name to file, to be read by the player process
+	std::ofstream shm_file(SHM_FILE_NAMES[player_id], std::ofstream::out);
+	shm_file << shm_name;
+	shm_file.close();
+
+	return std::make_unique<ChildPlayerProcess>("./player_" +
+	                                            std::to_string(player_id + 1));
+}
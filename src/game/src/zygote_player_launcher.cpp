@@ -0,0 +1,105 @@
+/**
+ * @file zygote_player_launcher.cpp
+ * Defines the launcher that forks players off zygote processes
+ */
+
+#include "game/zygote_player_launcher.h"
+#include "boost/process.hpp"
+
+#include <cstdlib>
+#include <system_error>
+
+namespace bp = boost::process;
+
+struct ZygotePlayerLauncher::Zygote {
+	/**
+	 * Pipe that jobs are written to, one per line
+	 */
+	bp::opstream jobs;
+
+	/**
+	 * Pipe that the ID of every forked player, and then its exit code, are
+	 * read from
+	 */
+	bp::ipstream replies;
+
+	/**
+	 * Error from launching or waiting on the process, if any
+	 */
+	std::error_code error;
+
+	/**
+	 * The zygote process
+	 */
+	bp::child process;
+
+	Zygote(const std::string &zygote_path)
+	    : process(zygote_path, "--zygote", bp::std_in < jobs,
+	              bp::std_out > replies, error) {}
+};
+
+namespace {
+
+/**
+ * A player running in a process forked off its zygote
+ */
+class ForkedPlayerProcess : public IPlayerProcess {
+	ZygotePlayerLauncher::Zygote *zygote;
+
+	/**
+	 * ID of the forked process, or -1 if the fork failed
+	 */
+	int pid;
+
+  public:
+	ForkedPlayerProcess(ZygotePlayerLauncher::Zygote *zygote,
+	                    const std::string &shm_name,
+	                    const std::string &library_path,
+	                    const std::string &debug_log_path)
+	    : zygote(zygote), pid(-1) {
+		zygote->jobs << shm_name << ' ' << library_path << ' '
+		             << debug_log_path << std::endl;
+		if (not(zygote->replies >> pid)) {
+			pid = -1;
+		}
+	}
+
+	int GetPid() override { return pid; }
+
+	int Wait() override {
+		// The zygote reaps the player, and passes on how it exited
+		auto exit_code = EXIT_FAILURE;
+		if (pid <= 0 || not(zygote->replies >> exit_code)) {
+			return EXIT_FAILURE;
+		}
+		return exit_code;
+	}
+};
+} // namespace
+
+ZygotePlayerLauncher::ZygotePlayerLauncher(
+    const std::string &zygote_path, std::array<std::string, 2> library_paths,
+    std::array<std::string, 2> debug_log_paths)
+    : library_paths(std::move(library_paths)),
+      debug_log_paths(std::move(debug_log_paths)) {
+	for (auto &zygote : zygotes) {
+		zygote = std::make_unique<Zygote>(zygote_path);
+	}
+}
+
+ZygotePlayerLauncher::~ZygotePlayerLauncher() {
+	// Zygotes exit once there are no more jobs to read
+	for (auto &zygote : zygotes) {
+		zygote->jobs.pipe().close();
+	}
+	for (auto &zygote : zygotes) {
+		zygote->process.wait(zygote->error);
+	}
+}
+
+std::unique_ptr<IPlayerProcess>
+ZygotePlayerLauncher::Launch(int player_id, const std::string &shm_name) {
+	return std::make_unique<ForkedPlayerProcess>(
+	    zygotes[player_id].get(), shm_name, library_paths[player_id],
+	    debug_log_paths[player_id]);
+}
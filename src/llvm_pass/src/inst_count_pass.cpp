@@ -1,13 +1,62 @@
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include <utility>
+#include <vector>
 
 namespace {
+
+/**
+ * Ways of adding a basic block's count to the running total
+ */
+enum class CountMode {
+	/**
+	 * Call PlayerDriver::IncrementCount, which does an atomic add
+	 */
+	Call,
+
+	/**
+	 * Load, add and store PlayerDriver::inline_instruction_count in place
+	 */
+	Inline
+};
+
+/**
+ * Selected with -mllvm -inst-count-mode=<call|inline>
+ */
+llvm::cl::opt<CountMode> count_mode(
+    "inst-count-mode",
+    llvm::cl::desc("How instruction counts are added to the total"),
+    llvm::cl::values(clEnumValN(CountMode::Call, "call",
+                                "Call the runtime's increment function"),
+                     clEnumValN(CountMode::Inline, "inline",
+                                "Add to the runtime's counter in place")),
+    llvm::cl::init(CountMode::Call));
+
+/**
+ * Enabled with -mllvm -inst-count-optimize
+ */
+llvm::cl::opt<bool> optimize_counts(
+    "inst-count-optimize",
+    llvm::cl::desc("Add counts once per loop and once per chain of blocks, "
+                   "instead of once per block, where the totals stay exact"),
+    llvm::cl::init(false));
+
 struct DynamicInstructionCountPass : public llvm::FunctionPass {
 	static char ID;
 	/**
@@ -15,36 +64,334 @@ struct DynamicInstructionCountPass : public llvm::FunctionPass {
 	 */
 	static const std::string increment_function_name;
 
-	DynamicInstructionCountPass() : FunctionPass(ID) {}
+	/**
+	 * Name of the external counter to be added to in the inline mode
+	 */
+	static const std::string counter_variable_name;
 
 	/**
-	 * Inserts a call to a function after every basic block in
-	 * order to count the number of LLVM IR instructions executed by the
-	 * code.
+	 * Name of the external limit the counter is compared against in the
+	 * inline mode
+	 */
+	static const std::string limit_variable_name;
+
+	/**
+	 * Name of the external function to be called when the counter goes past
+	 * the limit in the inline mode
+	 */
+	static const std::string exceed_function_name;
+
+	/**
+	 * Function called to add to the count in the call mode
+	 */
+	llvm::Constant *increment_function;
+
+	/**
+	 * Counter added to in the inline mode
+	 */
+	llvm::Constant *counter;
+
+	/**
+	 * Limit compared against in the inline mode
+	 */
+	llvm::Constant *limit;
+
+	/**
+	 * Function called in the inline mode when the count exceeds the limit
+	 */
+	llvm::Constant *exceed_function;
+
+	/**
+	 * A loop whose count is added once, in its preheader
+	 */
+	struct HoistedLoop {
+		llvm::Loop *loop;
+
+		/**
+		 * Number of times the backedge is taken, on every entry to the loop
+		 */
+		const llvm::SCEV *backedge_taken_count;
+
+		/**
+		 * Instructions executed by an iteration that takes the backedge
+		 */
+		uint64_t iteration_count;
+
+		/**
+		 * Instructions executed by the last iteration, which leaves the loop,
+		 * along with anything else that's added in the preheader
+		 */
+		uint64_t exit_count;
+	};
+
+	DynamicInstructionCountPass()
+	    : FunctionPass(ID), increment_function(nullptr), counter(nullptr),
+	      limit(nullptr), exceed_function(nullptr) {}
+
+	virtual void getAnalysisUsage(llvm::AnalysisUsage &AU) const {
+		if (optimize_counts) {
+			AU.addRequired<llvm::DominatorTreeWrapperPass>();
+			AU.addRequired<llvm::LoopInfoWrapperPass>();
+			AU.addRequired<llvm::ScalarEvolutionWrapperPass>();
+		}
+	}
+
+	/**
+	 * Inserts code before insert_point that adds amount to the running total,
+	 * and stops the player if the total goes past the instruction limit
+	 *
+	 * Depending on count_mode, this is either a call to a function, which
+	 * checks the limit itself, or a plain non atomic add to a global counter
+	 * followed by a compare against the limit. Both add the same amounts.
+	 *
+	 * In the inline mode, the block is split at insert_point
+	 *
+	 * @param insert_point instruction before which the count is to be added
+	 * @param amount 64 bit integer to add
+	 */
+	void AddToCount(llvm::Instruction *insert_point, llvm::Value *amount) {
+		llvm::IRBuilder<> builder(insert_point);
+
+		if (count_mode == CountMode::Call) {
+			llvm::Value *args[] = {amount};
+			builder.CreateCall(increment_function, args);
+		} else {
+			llvm::Value *total = builder.CreateLoad(counter);
+			total = builder.CreateAdd(total, amount);
+			builder.CreateStore(total, counter);
+
+			llvm::Value *is_limit_exceeded =
+			    builder.CreateICmpUGT(total, builder.CreateLoad(limit));
+			llvm::MDBuilder md_builder(insert_point->getContext());
+			llvm::Instruction *unreachable = llvm::SplitBlockAndInsertIfThen(
+			    is_limit_exceeded, insert_point, true,
+			    md_builder.createBranchWeights(1, 1 << 20));
+			llvm::IRBuilder<>(unreachable).CreateCall(exceed_function);
+		}
+	}
+
+	/**
+	 * Checks if anything in the block may unwind out of it before reaching
+	 * its terminator. Counts can only be added ahead of time for blocks that
+	 * don't, or the totals would differ from the naive pass when player code
+	 * throws.
+	 *
+	 * @param B block under inspection
+	 * @return true if some non terminator instruction may throw
+	 */
+	static bool MayThrowBeforeTerminator(const llvm::BasicBlock &B) {
+		for (auto &I : B) {
+			if (&I != B.getTerminator() && I.mayThrow()) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Checks if a loop's count can be added once in its preheader, and gets
+	 * the amounts to add if so
+	 *
+	 * That's the case for innermost loops with a computable backedge taken
+	 * count, a single exiting block, and no conditional code inside, i.e.
+	 * every block dominates the latch. Each iteration then runs every block
+	 * exactly once, apart from the last one, which stops at the exiting
+	 * block.
+	 *
+	 * @param L loop under inspection
+	 * @param sizes number of instructions in each block, before any
+	 * instrumentation was added
+	 * @param hoisted_loop set to the loop's counts on success
+	 * @return true if the loop can be hoisted, false otherwise
+	 */
+	bool GetHoistedLoop(
+	    llvm::Loop *L,
+	    const llvm::DenseMap<const llvm::BasicBlock *, uint64_t> &sizes,
+	    HoistedLoop &hoisted_loop) {
+		auto &DT = getAnalysis<llvm::DominatorTreeWrapperPass>().getDomTree();
+		auto &SE = getAnalysis<llvm::ScalarEvolutionWrapperPass>().getSE();
+
+		llvm::BasicBlock *latch = L->getLoopLatch();
+		llvm::BasicBlock *exiting = L->getExitingBlock();
+		if (!L->getSubLoops().empty() || !L->getLoopPreheader() || !latch ||
+		    !exiting) {
+			return false;
+		}
+
+		const llvm::SCEV *backedge_taken_count = SE.getBackedgeTakenCount(L);
+		if (llvm::isa<llvm::SCEVCouldNotCompute>(backedge_taken_count) ||
+		    !backedge_taken_count->getType()->isIntegerTy() ||
+		    backedge_taken_count->getType()->getIntegerBitWidth() > 64 ||
+		    !llvm::isSafeToExpand(backedge_taken_count, SE)) {
+			return false;
+		}
+
+		uint64_t iteration_count = 0;
+		uint64_t exit_count = 0;
+		for (auto *B : L->blocks()) {
+			if (!DT.dominates(B, latch) || MayThrowBeforeTerminator(*B)) {
+				return false;
+			}
+			iteration_count += sizes.lookup(B);
+			if (DT.dominates(B, exiting)) {
+				exit_count += sizes.lookup(B);
+			}
+		}
+
+		hoisted_loop = {L, backedge_taken_count, iteration_count, exit_count};
+		return true;
+	}
+
+	/**
+	 * Computes the count of a hoisted loop in its preheader, as
+	 * backedge_taken_count * iteration_count + exit_count
+	 *
+	 * @param hoisted_loop the loop
+	 * @return the count, computed right before the preheader's terminator
+	 */
+	llvm::Value *ExpandHoistedLoopCount(const HoistedLoop &hoisted_loop) {
+		auto &SE = getAnalysis<llvm::ScalarEvolutionWrapperPass>().getSE();
+		llvm::BasicBlock *preheader = hoisted_loop.loop->getLoopPreheader();
+		llvm::Instruction *insert_point = preheader->getTerminator();
+
+		llvm::SCEVExpander expander(
+		    SE, preheader->getModule()->getDataLayout(), "inst_count");
+		llvm::Value *backedge_taken_count = expander.expandCodeFor(
+		    hoisted_loop.backedge_taken_count,
+		    hoisted_loop.backedge_taken_count->getType(), insert_point);
+
+		llvm::IRBuilder<> builder(insert_point);
+		llvm::Value *amount = builder.CreateZExtOrTrunc(backedge_taken_count,
+		                                                builder.getInt64Ty());
+		amount = builder.CreateMul(
+		    amount, builder.getInt64(hoisted_loop.iteration_count));
+		return builder.CreateAdd(amount,
+		                         builder.getInt64(hoisted_loop.exit_count));
+	}
+
+	/**
+	 * Adds the number of instructions in every basic block to a running
+	 * total, before the block's terminator, in order to count the number of
+	 * LLVM IR instructions executed by the code.
+	 *
+	 * With optimize_counts, loops whose trip count can be worked out on entry
+	 * are counted once in their preheader, and a block that always follows
+	 * another one is counted along with it. The totals are the same as
+	 * without.
 	 *
 	 * @param F function under inspection
 	 * @return true if function is modified, false otherwise
 	 */
 	virtual bool runOnFunction(llvm::Function &F) {
-		// Get the function to call from our runtime library.
+		// Get the function or counter to use from our runtime library.
 		llvm::LLVMContext &Ctx = F.getContext();
+		llvm::Module *M = F.getParent();
+
+		if (count_mode == CountMode::Call) {
+			increment_function = M->getOrInsertFunction(
+			    increment_function_name, llvm::Type::getVoidTy(Ctx),
+			    llvm::Type::getInt64Ty(Ctx));
+		} else {
+			counter = M->getOrInsertGlobal(counter_variable_name,
+			                               llvm::Type::getInt64Ty(Ctx));
+			limit = M->getOrInsertGlobal(limit_variable_name,
+			                             llvm::Type::getInt64Ty(Ctx));
+			exceed_function = M->getOrInsertFunction(
+			    exceed_function_name, llvm::Type::getVoidTy(Ctx));
+			auto *exceed = llvm::dyn_cast<llvm::Function>(exceed_function);
+			if (exceed) {
+				exceed->addFnAttr(llvm::Attribute::NoReturn);
+				exceed->addFnAttr(llvm::Attribute::NoUnwind);
+				exceed->addFnAttr(llvm::Attribute::Cold);
+			}
+		}
 
-		llvm::Constant *resultFunc = F.getParent()->getOrInsertFunction(
-		    increment_function_name, llvm::Type::getVoidTy(Ctx),
-		    llvm::Type::getInt32Ty(Ctx));
+		// Counted before any instrumentation is added, so that every mode
+		// gives the same totals
+		llvm::DenseMap<const llvm::BasicBlock *, uint64_t> sizes;
+		for (auto &B : F) {
+			sizes[&B] = B.size();
+		}
+
+		// Block whose terminator each block's count is added at. Blocks in
+		// hoisted loops are left out.
+		llvm::DenseMap<llvm::BasicBlock *, llvm::BasicBlock *> count_blocks;
+		for (auto &B : F) {
+			count_blocks[&B] = &B;
+		}
 
 		bool flag = false;
 
+		std::vector<HoistedLoop> hoisted_loops;
+		if (optimize_counts) {
+			auto &LI = getAnalysis<llvm::LoopInfoWrapperPass>().getLoopInfo();
+
+			std::vector<llvm::Loop *> loops(LI.begin(), LI.end());
+			while (!loops.empty()) {
+				llvm::Loop *L = loops.back();
+				loops.pop_back();
+				loops.insert(loops.end(), L->begin(), L->end());
+
+				HoistedLoop hoisted_loop;
+				if (GetHoistedLoop(L, sizes, hoisted_loop)) {
+					hoisted_loops.push_back(hoisted_loop);
+					for (auto *B : L->blocks()) {
+						count_blocks.erase(B);
+					}
+				}
+			}
+
+			// Fold each block into its predecessor's count if it's the only
+			// way into the block and the block is the only way out of it. The
+			// traversal visits predecessors first.
+			llvm::ReversePostOrderTraversal<llvm::Function *> rpot(&F);
+			for (auto *B : rpot) {
+				llvm::BasicBlock *P = B->getSinglePredecessor();
+				if (P && P->getSingleSuccessor() == B &&
+				    count_blocks.count(P) && count_blocks.count(B) &&
+				    !MayThrowBeforeTerminator(*B)) {
+					count_blocks[B] = count_blocks[P];
+				}
+			}
+		}
+
+		// Sum up the counts to add at each block
+		llvm::DenseMap<llvm::BasicBlock *, uint64_t> counts;
 		for (auto &B : F) {
+			auto count_block = count_blocks.find(&B);
+			if (count_block != count_blocks.end()) {
+				counts[count_block->second] += sizes[&B];
+			}
+		}
+
+		// Amounts to add before each terminator. All of them are worked out
+		// before adding any, as adding may split blocks.
+		std::vector<std::pair<llvm::Instruction *, llvm::Value *>> amounts;
 
-			int count = 0;
-			count += B.size();
+		// A preheader's own count goes in with its loop's
+		for (auto &hoisted_loop : hoisted_loops) {
+			llvm::BasicBlock *preheader = hoisted_loop.loop->getLoopPreheader();
+			auto count = counts.find(preheader);
+			if (count != counts.end()) {
+				hoisted_loop.exit_count += count->second;
+				counts.erase(count);
+			}
+			amounts.emplace_back(preheader->getTerminator(),
+			                     ExpandHoistedLoopCount(hoisted_loop));
+		}
 
-			llvm::IRBuilder<> builder(&B);
-			builder.SetInsertPoint(B.getTerminator());
+		for (auto &B : F) {
+			auto count = counts.find(&B);
+			if (count != counts.end()) {
+				amounts.emplace_back(
+				    B.getTerminator(),
+				    llvm::ConstantInt::get(llvm::Type::getInt64Ty(Ctx),
+				                           count->second));
+			}
+		}
 
-			llvm::Value *args[] = {builder.getInt32(count)};
-			builder.CreateCall(resultFunc, args);
+		for (auto &amount : amounts) {
+			AddToCount(amount.first, amount.second);
 			flag = true;
 		}
 
@@ -58,12 +405,31 @@ struct DynamicInstructionCountPass : public llvm::FunctionPass {
 const std::string DynamicInstructionCountPass::increment_function_name =
     "_ZN7drivers12PlayerDriver14IncrementCountEm";
 
+const std::string DynamicInstructionCountPass::counter_variable_name =
+    "_ZN7drivers12PlayerDriver24inline_instruction_countE";
+
+const std::string DynamicInstructionCountPass::limit_variable_name =
+    "_ZN7drivers12PlayerDriver17instruction_limitE";
+
+const std::string DynamicInstructionCountPass::exceed_function_name =
+    "_ZN7drivers12PlayerDriver22ExceedInstructionLimitEv";
+
 char DynamicInstructionCountPass::ID = 0;
 
 // Automatically enable the pass.
+//
+// It runs as early as possible so that player code is counted at every
+// optimization level, -O0 included. Clang's IR keeps locals on the stack
+// until then, though, and scalar evolution can't work out the trip count of
+// a loop whose induction variable or bound is loaded from memory. So locals
+// are first promoted to registers, loop invariant loads hoisted, and loops
+// given preheaders. This runs in both modes, so that they count the same IR.
 static void
 registerDynamicInstructionCountPass(const llvm::PassManagerBuilder &,
                                     llvm::legacy::PassManagerBase &PM) {
+	PM.add(llvm::createPromoteMemoryToRegisterPass());
+	PM.add(llvm::createLoopSimplifyPass());
+	PM.add(llvm::createLICMPass());
 	PM.add(new DynamicInstructionCountPass());
 }
 
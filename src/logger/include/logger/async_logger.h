@@ -0,0 +1,156 @@
+/**
+ * @file async_logger.h
+ * Declarations for a logger that builds the game log on its own thread
+ */
+
+#pragma once
+
+#include "logger/interfaces/i_logger.h"
+#include "logger/logger.h"
+#include "logger/logger_export.h"
+#include "logger/state_snapshot.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace logger {
+
+/**
+ * Logger that only snapshots the state on the calling thread, and leaves
+ * building and writing the game log to a thread of its own
+ *
+ * Snapshots go through a fixed ring of slots, whose storage is reused from
+ * turn to turn. If the log falls a whole ring behind, LogState waits for a
+ * slot to free up. The end of game calls wait for the log to catch up.
+ */
+class LOGGER_EXPORT AsyncLogger : public ILogger {
+  private:
+	/**
+	 * Logger that captures the snapshots and turns them into the game log
+	 */
+	std::unique_ptr<Logger> logger;
+
+	/**
+	 * Ring of snapshots waiting to be logged
+	 */
+	std::vector<StateSnapshot> snapshots;
+
+	/**
+	 * Memory held by each snapshot in the ring, and by all of them. Only
+	 * LogState changes them.
+	 */
+	std::vector<int64_t> snapshot_bytes;
+	std::atomic<int64_t> total_snapshot_bytes;
+
+	/**
+	 * Number of snapshots captured so far
+	 */
+	size_t num_captured;
+
+	/**
+	 * Number of snapshots logged so far
+	 */
+	size_t num_logged;
+
+	/**
+	 * Set to stop the log thread once it's caught up
+	 */
+	bool is_stopping;
+
+	/**
+	 * Guards num_captured, num_logged and is_stopping
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Signalled when a snapshot is captured, or the thread should stop
+	 */
+	std::condition_variable captured;
+
+	/**
+	 * Signalled when a snapshot is logged
+	 */
+	std::condition_variable logged;
+
+	/**
+	 * Thread that logs the snapshots
+	 */
+	std::thread log_thread;
+
+	/**
+	 * Logs snapshots as they come in, until stopped
+	 */
+	void Run();
+
+	/**
+	 * Blocking function that waits until every captured snapshot is logged
+	 */
+	void WaitForLog();
+
+  public:
+	/**
+	 * Constructor for AsyncLogger
+	 *
+	 * @param[in]  logger       Logger to capture and log the snapshots with.
+	 *                          Errors and instruction counts are passed on to
+	 *                          it as they come in.
+	 * @param[in]  num_buffers  Number of turns the log can fall behind by
+	 */
+	AsyncLogger(std::unique_ptr<Logger> logger, size_t num_buffers);
+
+	/**
+	 * Destructor for AsyncLogger, which waits for the log thread to finish
+	 */
+	~AsyncLogger() override;
+
+	/**
+	 * @see ILogger#BeginGame
+	 */
+	void BeginGame(std::ostream &write_stream) override;
+
+	/**
+	 * @see ILogger#LogState
+	 */
+	void LogState() override;
+
+	/**
+	 * @see ILogger#LogInstructionCount
+	 */
+	void LogInstructionCount(state::PlayerId player_id, int64_t count) override;
+
+	/**
+	 * @see ILogger#LogError
+	 */
+	void LogError(state::PlayerId player_id, ErrorMessage message) override;
+
+	/**
+	 * @see ILogger#LogTurnProfile
+	 */
+	void LogTurnProfile(const TurnProfile &turn_profile) override;
+
+	/**
+	 * @see ILogger#LogFinalGameParams
+	 */
+	void LogFinalGameParams(state::PlayerId player_id, bool was_deathmatch,
+	                        std::array<int64_t, 2> final_scores) override;
+
+	/**
+	 * @see ILogger#WriteGame
+	 */
+	void WriteGame(std::ostream &write_stream) override;
+
+	/**
+	 * @see ILogger#GetLogBytes
+	 *
+	 * Counts the snapshots waiting to be logged too
+	 */
+	int64_t GetLogBytes() const override;
+};
+} // namespace logger
@@ -0,0 +1,46 @@
+/**
+ * @file block_compression.h
+ * Declarations for compressing blocks of the game log
+ */
+
+#pragma once
+
+#include "logger/logger_export.h"
+
+#include <cstddef>
+#include <string>
+
+namespace logger {
+
+/**
+ * Most times its compressed size that a block can decompress to. Every 255
+ * bytes of a match's length take at least a byte to encode.
+ */
+const size_t MAX_COMPRESSION_RATIO = 255;
+
+/**
+ * Compresses a block of data in the LZ4 block format
+ *
+ * Meant for speed rather than ratio. The input is matched greedily against
+ * the last place each 4 byte sequence was seen.
+ *
+ * @param[in]   input   Data to compress
+ * @param[out]  output  String to append the compressed data to
+ */
+LOGGER_EXPORT void CompressBlock(const std::string &input,
+                                 std::string &output);
+
+/**
+ * Decompresses a block of data in the LZ4 block format
+ *
+ * @param[in]   input       Compressed data
+ * @param[in]   input_size  Size of the compressed data
+ * @param[in]   size        Size of the data before it was compressed
+ * @param[out]  output      String to decompress into
+ *
+ * @return      true if the block decompressed to exactly size bytes, false
+ *              if it's malformed
+ */
+LOGGER_EXPORT bool DecompressBlock(const char *input, size_t input_size,
+                                   size_t size, std::string &output);
+} // namespace logger
@@ -0,0 +1,49 @@
+/**
+ * @file error_counts.h
+ * Declarations for logging the number of times each error was made in a turn
+ */
+
+#pragma once
+
+#include "game.pb.h"
+#include "logger/error_type.h"
+#include "logger/logger_export.h"
+
+#include <array>
+#include <google/protobuf/io/coded_stream.h>
+#include <string>
+
+namespace logger {
+
+/**
+ * Adds a player's errors to their errors in a game frame, each error code as
+ * many times as the error was made
+ *
+ * @param[in]   counts         Number of times each error was made
+ * @param[out]  player_errors  The player's errors in the game frame
+ */
+LOGGER_EXPORT void AddErrors(const ErrorCounts &counts,
+                             proto::PlayerErrors &player_errors);
+
+/**
+ * Encodes both players' errors as (error code, count) pairs, for only the
+ * errors that were made
+ *
+ * @param[in]   counts  Number of times each error was made, by each player
+ * @param[out]  output  String to append the encoded errors to
+ */
+LOGGER_EXPORT void EncodeErrorCounts(const std::array<ErrorCounts, 2> &counts,
+                                     std::string &output);
+
+/**
+ * Decodes both players' errors into a game frame
+ *
+ * @param[in]   input       Stream to read the encoded errors from
+ * @param[out]  game_state  Game frame to add the players' errors to
+ *
+ * @return      true if the errors were read, false if they're malformed
+ */
+LOGGER_EXPORT bool
+DecodeErrorCounts(google::protobuf::io::CodedInputStream &input,
+                  proto::GameState &game_state);
+} // namespace logger
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -124,4 +127,102 @@ const std::vector<std::string> ErrorTypeName = {
     "INVALID_TARGET_ID",
     "POSITION_OCCUPIED"};
 
+/**
+ * Messages that errors are logged with. Each belongs to one error type, and
+ * is logged as its value, which is the error code in the game log.
+ *
+ * ALERT! - When adding a value here, add it in the table below as well
+ */
+enum class ErrorMessage {
+	SOLDIER_ID_ALTERED,
+	VILLAGER_ID_ALTERED,
+	FACTORY_ID_ALTERED,
+	SOLDIER_ATTACK_AND_MOVE,
+	SOLDIER_ATTACKS_OWN_SOLDIER,
+	SOLDIER_ATTACKS_OWN_VILLAGER,
+	SOLDIER_ATTACKS_OWN_FACTORY,
+	VILLAGER_ATTACKS_OWN_SOLDIER,
+	VILLAGER_ATTACKS_OWN_VILLAGER,
+	VILLAGER_ATTACKS_OWN_FACTORY,
+	INVALID_TARGET_ID,
+	SOLDIER_INVALID_MOVE,
+	VILLAGER_INVALID_MOVE,
+	VILLAGER_MULTIPLE_TASKS,
+	POSITION_OCCUPIED,
+	NO_MORE_FACTORIES,
+	FACTORY_ON_WATER,
+	FACTORY_ON_GOLD_MINE,
+	INSUFFICIENT_FUNDS,
+	INVALID_BUILD_POSITION,
+	FACTORY_DOESNT_EXIST,
+	INVALID_MINE_POSITION
+};
+
+/**
+ * The error type and text of an error message
+ */
+struct ErrorMessageEntry {
+	ErrorType type;
+	const char *text;
+};
+
+/**
+ * Error type and text of every error message, indexed by ErrorMessage
+ */
+const ErrorMessageEntry ERROR_MESSAGES[] = {
+    {ErrorType::NO_ALTER_ACTOR_ID, "Cannot alter soldier id"},
+    {ErrorType::NO_ALTER_ACTOR_ID, "Cannot alter villager id"},
+    {ErrorType::NO_ALTER_ACTOR_ID, "Cannot alter factory id"},
+    {ErrorType::NO_MULTIPLE_SOLDIER_TASKS,
+     "Soldier cannot attack and move at the same time"},
+    {ErrorType::NO_ATTACK_SELF_SOLDIER, "Soldier is attacking his own soldier"},
+    {ErrorType::NO_ATTACK_SELF_VILLAGER,
+     "Soldier is attacking his own villager"},
+    {ErrorType::NO_ATTACK_SELF_FACTORY, "Soldier is attacking his own factory"},
+    {ErrorType::NO_ATTACK_SELF_SOLDIER,
+     "Villager is attacking his own soldier"},
+    {ErrorType::NO_ATTACK_SELF_VILLAGER,
+     "Villager is attacking his own villager"},
+    {ErrorType::NO_ATTACK_SELF_FACTORY,
+     "Villager is attacking his own factory"},
+    {ErrorType::INVALID_TARGET_ID, "Invalid target id"},
+    {ErrorType::INVALID_MOVE_POSITION,
+     "Soldier trying to move to invalid location"},
+    {ErrorType::INVALID_MOVE_POSITION,
+     "Villager cannot move to invalid position"},
+    {ErrorType::NO_MULTIPLE_VILLAGER_TASKS,
+     "Villager cannot do multiple tasks at the same time"},
+    {ErrorType::POSITION_OCCUPIED,
+     "Villager is trying to build a factory in a position that is already "
+     "occupied"},
+    {ErrorType::NO_MORE_FACTORIES,
+     "Trying to build more factories than the factory limit"},
+    {ErrorType::NO_BUILD_FACTORY_ON_WATER,
+     "Villager trying to build factory on water"},
+    {ErrorType::NO_BUILD_FACTORY_ON_GOLD_MINE,
+     "Villager trying to build factory on gold mine"},
+    {ErrorType::INSUFFICIENT_FUNDS,
+     "You do not have sufficient gold to construct a factory"},
+    {ErrorType::INVALID_BUILD_POSITION,
+     "Villager cannot build factory in invalid position"},
+    {ErrorType::NO_BUILD_FACTORY_THAT_DOSENT_EXIST,
+     "Villager trying to build factory that doesn't exist"},
+    {ErrorType::INVALID_MINE_POSITION,
+     "Villager cannot mine in invalid position"}};
+
+/**
+ * Number of error messages, and so of error codes
+ */
+const size_t NUM_ERROR_MESSAGES =
+    sizeof(ERROR_MESSAGES) / sizeof(ERROR_MESSAGES[0]);
+
+static_assert(NUM_ERROR_MESSAGES ==
+                  (size_t)ErrorMessage::INVALID_MINE_POSITION + 1,
+              "Every error message needs an entry in ERROR_MESSAGES");
+
+/**
+ * Number of times each error was made in a turn, indexed by error code
+ */
+typedef std::array<int64_t, NUM_ERROR_MESSAGES> ErrorCounts;
+
 } // namespace logger
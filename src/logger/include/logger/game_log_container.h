@@ -0,0 +1,144 @@
+/**
+ * @file game_log_container.h
+ * Declarations for the block compressed game log container
+ */
+
+#pragma once
+
+#include "game.pb.h"
+#include "logger/logger_export.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace logger {
+
+/**
+ * Bytes that a game log container starts with
+ */
+const std::string GAME_LOG_CONTAINER_MAGIC = "CCGLOGZ1";
+
+/**
+ * Default number of turns in each block of a container
+ */
+const int64_t GAME_LOG_CONTAINER_BLOCK_TURNS = 100;
+
+/**
+ * Writes a game into a container of independently compressed blocks
+ *
+ * The container is the magic, a header block, the turn blocks, an index of
+ * the blocks and a footer with the offset of the index. The header block
+ * holds the game without its frames. Each turn block holds the records of
+ * the streamed format for its turns, starting with a keyframe that lists the
+ * factories as of the turn before. Unit changes start over in every block,
+ * so a block can be read without the ones before it.
+ *
+ * @param[in]  game          The game to write
+ * @param[in]  write_stream  Stream to write the container to
+ * @param[in]  block_turns   Number of turns in each block
+ */
+LOGGER_EXPORT void
+WriteGameLogContainer(const proto::Game &game, std::ostream &write_stream,
+                      int64_t block_turns = GAME_LOG_CONTAINER_BLOCK_TURNS);
+
+/**
+ * Reads any range of turns out of a game log container, decompressing only
+ * the blocks that hold them
+ */
+class LOGGER_EXPORT GameLogContainerReader {
+  private:
+	/**
+	 * Where a block is in the container, and what it holds
+	 */
+	struct BlockEntry {
+		int64_t first_turn;
+		int64_t num_turns;
+		uint64_t offset;
+		uint64_t stored_size;
+		uint64_t size;
+
+		/**
+		 * True if the block is compressed, false if it's stored as is
+		 */
+		bool is_compressed;
+	};
+
+	/**
+	 * Stream the container is read from
+	 */
+	std::istream *read_stream;
+
+	/**
+	 * The game without its frames
+	 */
+	proto::Game header;
+
+	/**
+	 * Index of the turn blocks, in turn order
+	 */
+	std::vector<BlockEntry> blocks;
+
+	/**
+	 * Total number of turns in the container
+	 */
+	int64_t num_turns;
+
+	/**
+	 * Offset of the index, before which every block ends
+	 */
+	uint64_t index_offset;
+
+	/**
+	 * Reads a block and decompresses it
+	 *
+	 * @param[in]   block  The block to read
+	 * @param[out]  data   Contents of the block
+	 *
+	 * @return      true if the block was read, false if it's out of bounds or
+	 *              malformed
+	 */
+	bool ReadBlock(const BlockEntry &block, std::string &data);
+
+  public:
+	/**
+	 * Constructor for GameLogContainerReader
+	 *
+	 * @param[in]  read_stream  Stream to read the container from, which must
+	 *                          be seekable
+	 */
+	explicit GameLogContainerReader(std::istream &read_stream);
+
+	/**
+	 * Reads the index and the header of the container
+	 *
+	 * @return     true if the stream holds a container, false otherwise
+	 */
+	bool Open();
+
+	/**
+	 * Returns the number of turns in the container
+	 */
+	int64_t GetNumTurns() const;
+
+	/**
+	 * Reads a range of turns into a game, along with everything that isn't
+	 * a frame
+	 *
+	 * The frames are the same as in the logged game, except that if the range
+	 * starts after the first turn, its first frame lists every factory in
+	 * full. The result is then a game log of its own, like one that started
+	 * on that turn.
+	 *
+	 * @param[in]   first_turn  Index of the first turn to read
+	 * @param[in]   count       Number of turns to read
+	 * @param[out]  game        The game with the turns read
+	 *
+	 * @return      true if the turns were read, false if the range is out of
+	 *              bounds or the container is malformed
+	 */
+	bool ReadTurns(int64_t first_turn, int64_t count, proto::Game &game);
+};
+} // namespace logger
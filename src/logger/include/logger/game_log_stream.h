@@ -0,0 +1,117 @@
+/**
+ * @file game_log_stream.h
+ * Declarations for the streamed game log format
+ */
+
+#pragma once
+
+#include "game.pb.h"
+#include "logger/logger_export.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace logger {
+
+/**
+ * Bytes that a streamed game log starts with
+ *
+ * Whole game logs are a serialized proto::Game, which can't start with these
+ */
+const std::string GAME_LOG_STREAM_MAGIC = "CCGLOG01";
+
+/**
+ * Kinds of records in a streamed game log
+ *
+ * The magic is followed by a header, a turn and a units record per turn, and a
+ * trailer, with a profile just before the trailer if the game was timed.
+ * Each record is its type byte, the length of its message as a varint, and
+ * the serialized message.
+ */
+enum class GameLogRecordType : uint8_t {
+	/**
+	 * proto::Game with the map, max HPs, instruction limits and error map
+	 */
+	HEADER = 1,
+
+	/**
+	 * proto::GameState of a single turn, without its soldiers and villagers.
+	 * In a streamed log it's without the players' errors too.
+	 */
+	TURN = 2,
+
+	/**
+	 * proto::Game with the winner and win type
+	 */
+	TRAILER = 3,
+
+	/**
+	 * Soldiers and then villagers of the turn before it, each encoded by a
+	 * UnitDeltaEncoder as changes from the turn before that
+	 */
+	UNITS = 4,
+
+	/**
+	 * proto::GameState listing every factory in full, as of the turn before.
+	 * Only found at the start of a block in a game log container.
+	 */
+	KEYFRAME = 5,
+
+	/**
+	 * Errors of both players in the turn before it, as the number of times
+	 * each error was made
+	 */
+	ERRORS = 6,
+
+	/**
+	 * How long each phase of the game's turns took, encoded by
+	 * EncodeTurnProfile in logger/turn_profile.h
+	 */
+	PROFILE = 7
+};
+
+/**
+ * Writes a record to a streamed game log
+ *
+ * @param[in]   write_stream  Stream to write the record to
+ * @param[in]   type          Type of the record
+ * @param[in]   message       Message of the record
+ * @param[out]  buffer        Scratch space for serializing the message, which
+ *                            can be reused across calls
+ */
+LOGGER_EXPORT void
+WriteGameLogRecord(std::ostream &write_stream, GameLogRecordType type,
+                   const google::protobuf::MessageLite &message,
+                   std::string &buffer);
+
+/**
+ * Writes a record that isn't a message to a streamed game log
+ *
+ * @param[in]  write_stream  Stream to write the record to
+ * @param[in]  type          Type of the record
+ * @param[in]  data          Contents of the record
+ */
+LOGGER_EXPORT void WriteGameLogRecord(std::ostream &write_stream,
+                                      GameLogRecordType type,
+                                      const std::string &data);
+
+/**
+ * Reads a game log in any format into a complete proto::Game
+ *
+ * Besides whole and streamed logs, this reads game log containers.
+ *
+ * A streamed log is put back together into the same message that the whole
+ * log would have held, with every unit in every frame. If a streamed log ends
+ * before its trailer, as when the game was cut short, the turns read so far
+ * are kept.
+ *
+ * @param[in]   read_stream  Stream to read the log from, which must be
+ *                           seekable
+ * @param[out]  game         The game that was logged
+ *
+ * @return      true if a complete log was read, false otherwise
+ */
+LOGGER_EXPORT bool ReadGameLog(std::istream &read_stream, proto::Game &game);
+} // namespace logger
@@ -7,8 +7,10 @@
 
 #include "logger/error_type.h"
 #include "logger/logger_export.h"
+#include "logger/turn_profile.h"
 #include "state/interfaces/i_command_taker.h"
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 
@@ -21,6 +23,15 @@ class LOGGER_EXPORT ILogger {
   public:
 	virtual ~ILogger(){};
 
+	/**
+	 * Called once before the first turn is logged, with the stream that the
+	 * game will be written to. Loggers that stream the game write to it from
+	 * here on, others only in WriteGame.
+	 *
+	 * @param[in]   write_stream  Stream the game will be written to
+	 */
+	virtual void BeginGame(std::ostream &write_stream) = 0;
+
 	/**
 	 * Logs all information from main state
 	 */
@@ -37,15 +48,22 @@ class LOGGER_EXPORT ILogger {
 	                                 int64_t count) = 0;
 
 	/**
-	 * Takes a player and the error, and logs it into the state. Every distinct
-	 * string is assigned an error code and stored in the error_map
+	 * Takes a player and the error, and counts it against the current turn.
+	 * The error is logged under the message's error code, whose text is in
+	 * the error_map
 	 *
 	 * @param[in]   player_id    The player identifier
-	 * @param[in]   error_type   The error type
-	 * @param[in]   message      The error string
+	 * @param[in]   message      The error message, which fixes its error type
+	 */
+	virtual void LogError(state::PlayerId player_id, ErrorMessage message) = 0;
+
+	/**
+	 * Logs how long each phase of the game's turns took, at most once, before
+	 * the final game parameters. Both streamed and whole game logs keep it.
+	 *
+	 * @param[in]   turn_profile  Latencies of each phase
 	 */
-	virtual void LogError(state::PlayerId player_id, ErrorType error_type,
-	                      std::string message) = 0;
+	virtual void LogTurnProfile(const TurnProfile &turn_profile) = 0;
 
 	/**
 	 * Logs final game parameters, should be called once, right before logging
@@ -56,8 +74,17 @@ class LOGGER_EXPORT ILogger {
 	                                std::array<int64_t, 2> final_scores) = 0;
 
 	/**
-	 * Writes the complete serialized logs to stream
+	 * Writes the complete serialized logs to stream, or whatever is left of
+	 * them if the game is being streamed
 	 */
 	virtual void WriteGame(std::ostream &write_stream) = 0;
+
+	/**
+	 * Gets the memory held for the game log, as of the last turn logged. May
+	 * be called from any thread.
+	 *
+	 * @return      Size in bytes
+	 */
+	virtual int64_t GetLogBytes() const = 0;
 };
 } // namespace logger
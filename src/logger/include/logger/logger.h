@@ -9,11 +9,16 @@
 #include "logger/error_type.h"
 #include "logger/interfaces/i_logger.h"
 #include "logger/logger_export.h"
+#include "logger/state_snapshot.h"
+#include "logger/unit_delta.h"
 #include "physics/vector.hpp"
 #include "state/interfaces/i_command_taker.h"
 
+#include <atomic>
 #include <cstdint>
+#include <google/protobuf/arena.h>
 #include <ostream>
+#include <string>
 
 namespace logger {
 
@@ -57,30 +62,26 @@ class LOGGER_EXPORT Logger : public ILogger {
 	std::array<std::vector<FactoryLogEntry>, 2> factory_logs;
 
 	/**
-	 * Protobuf object holding complete game logs
+	 * Arena that the game logs are allocated on, so that building a frame
+	 * doesn't go to the heap for every message in it
 	 */
-	std::unique_ptr<proto::Game> logs;
+	google::protobuf::Arena arena;
 
 	/**
-	 * Stores the instruction counts until they are written into the log along
-	 * with the remaininig state data, every turn
-	 */
-	std::vector<int64_t> instruction_counts;
-
-	/**
-	 * Map holding mapping of error strings to error codes
+	 * Protobuf object holding complete game logs, owned by the arena
 	 */
-	std::unordered_map<std::string, int64_t> error_map;
+	proto::Game *logs;
 
 	/**
-	 * Holds an incrementing value to assign each error a unique code
+	 * Stores the instruction counts until they are written into the log along
+	 * with the remaininig state data, every turn
 	 */
-	int64_t current_error_code;
+	std::vector<int64_t> instruction_counts;
 
 	/**
-	 * Holds the errors that occured in a particular move, indexed by player_id
+	 * Number of times each error was made this turn, indexed by player_id
 	 */
-	std::array<std::vector<int64_t>, 2> errors;
+	std::array<ErrorCounts, 2> error_counts;
 
 	/**
 	 * Number of instructions exceeding which the turn is forfeit
@@ -107,19 +108,140 @@ class LOGGER_EXPORT Logger : public ILogger {
 	 */
 	int64_t factory_max_hp;
 
+	/**
+	 * True if the log is written out turn by turn, in the streamed format
+	 */
+	bool stream_game;
+
+	/**
+	 * Stream that turns are written to as they come in, when streaming
+	 */
+	std::ostream *stream;
+
+	/**
+	 * Scratch space for serializing records, reused across turns
+	 */
+	std::string record_buffer;
+
+	/**
+	 * True once the map and other constants have been logged
+	 */
+	bool is_header_logged;
+
+	/**
+	 * Snapshot that LogState captures the state into, reused every turn
+	 */
+	StateSnapshot snapshot;
+
+	/**
+	 * Encodes the soldiers of each turn as changes from the turn before, when
+	 * streaming
+	 */
+	UnitDeltaEncoder soldier_encoder;
+
+	/**
+	 * Encodes the villagers of each turn as changes from the turn before,
+	 * when streaming
+	 */
+	UnitDeltaEncoder villager_encoder;
+
+	/**
+	 * Scratch space for the units being encoded, reused across turns
+	 */
+	std::vector<UnitRecord> unit_records;
+
+	/**
+	 * Encoded unit changes of the frame that hasn't been written yet
+	 */
+	std::string unit_deltas;
+
+	/**
+	 * Encoded errors of the frame that hasn't been written yet
+	 */
+	std::string error_record;
+
+	/**
+	 * Encoded turn profile, written just before the trailer when streaming,
+	 * and after the game otherwise
+	 */
+	std::string profile_record;
+
+	/**
+	 * Memory held for the game log, as of the last turn logged
+	 */
+	std::atomic<int64_t> log_bytes;
+
+	/**
+	 * Logs things that stay the same all game, like the map
+	 */
+	void LogHeader();
+
+	/**
+	 * Writes out all game frames but the latest one, and drops them from
+	 * memory. The latest frame is held back so that the final scores can
+	 * still be set in it.
+	 */
+	void FlushStates();
+
+	/**
+	 * Adds every soldier and villager to a game frame
+	 *
+	 * @param[in]   snapshot    Snapshot of the turn
+	 * @param[out]  game_state  Game frame of the turn
+	 */
+	void LogUnits(const StateSnapshot &snapshot, proto::GameState *game_state);
+
+	/**
+	 * Encodes only what changed about the soldiers and villagers since the
+	 * last turn, to be written along with the frame
+	 *
+	 * @param[in]  snapshot  Snapshot of the turn
+	 */
+	void LogUnitDeltas(const StateSnapshot &snapshot);
+
+	/**
+	 * Measures the memory held for the game log, into log_bytes
+	 */
+	void UpdateLogBytes();
+
   public:
 	/**
 	 * Constructor for the Logger class
+	 *
+	 * @param[in]  stream_game  Write the log turn by turn in the streamed
+	 *                          format, instead of as a whole at the end
 	 */
 	Logger(state::ICommandTaker *state, int64_t player_instruction_limit_turn,
 	       int64_t player_instruction_limit_game, int64_t soldier_max_hp,
-	       int64_t villager_max_hp, int64_t factory_max_hp);
+	       int64_t villager_max_hp, int64_t factory_max_hp,
+	       bool stream_game = false);
+
+	/**
+	 * @see ILogger#BeginGame
+	 */
+	void BeginGame(std::ostream &write_stream) override;
 
 	/**
 	 * @see ILogger#LogState
 	 */
 	void LogState() override;
 
+	/**
+	 * Copies what this turn's frame needs out of the state. Also takes the
+	 * instruction counts and errors logged so far, and resets them.
+	 *
+	 * @param[out]  snapshot  Snapshot to fill, whose storage is reused
+	 */
+	void CaptureState(StateSnapshot &snapshot);
+
+	/**
+	 * Builds the game frame for a turn from its snapshot. Doesn't touch the
+	 * state, so it can run while the state moves on to later turns.
+	 *
+	 * @param[in]  snapshot  Snapshot of the turn
+	 */
+	void LogSnapshot(const StateSnapshot &snapshot);
+
 	/**
 	 * @see ILogger#LogInstructionCount
 	 */
@@ -128,8 +250,12 @@ class LOGGER_EXPORT Logger : public ILogger {
 	/**
 	 * @see ILogger#LogError
 	 */
-	void LogError(state::PlayerId player_id, ErrorType error_type,
-	              std::string message) override;
+	void LogError(state::PlayerId player_id, ErrorMessage message) override;
+
+	/**
+	 * @see ILogger#LogTurnProfile
+	 */
+	void LogTurnProfile(const TurnProfile &turn_profile) override;
 
 	/**
 	 * @see ILogger#LogFinalGameParams
@@ -142,5 +268,10 @@ class LOGGER_EXPORT Logger : public ILogger {
 	 * Defaults to std::cout when no stream passed
 	 */
 	void WriteGame(std::ostream &write_stream = std::cout) override;
+
+	/**
+	 * @see ILogger#GetLogBytes
+	 */
+	int64_t GetLogBytes() const override;
 };
 } // namespace logger
@@ -0,0 +1,116 @@
+/**
+ * @file state_snapshot.h
+ * Declarations for a plain copy of the state that the logger works off of
+ */
+
+#pragma once
+
+#include "logger/error_type.h"
+#include "state/actor/factory_states/factory_state.h"
+#include "state/actor/soldier_states/soldier_state.h"
+#include "state/actor/villager_states/villager_state.h"
+#include "state/utilities.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace logger {
+
+/**
+ * Logged fields of a soldier
+ */
+struct SoldierSnapshot {
+	int64_t id;
+	int64_t player_id;
+	int64_t hp;
+	int64_t x;
+	int64_t y;
+	state::SoldierStateName state;
+
+	/**
+	 * Position of the attack target, or -1, -1 if there is none
+	 */
+	int64_t target_x;
+	int64_t target_y;
+};
+
+/**
+ * Logged fields of a villager
+ */
+struct VillagerSnapshot {
+	int64_t id;
+	int64_t player_id;
+	int64_t hp;
+	int64_t x;
+	int64_t y;
+	state::VillagerStateName state;
+
+	/**
+	 * Position of the attack, mine or build target, or -1, -1 if there is none
+	 */
+	int64_t target_x;
+	int64_t target_y;
+};
+
+/**
+ * Logged fields of a factory
+ */
+struct FactorySnapshot {
+	int64_t id;
+	int64_t player_id;
+	int64_t hp;
+	int64_t x;
+	int64_t y;
+	state::FactoryStateName state;
+	state::ActorType production_state;
+	int64_t construction_completion;
+	int64_t total_construction_completion;
+};
+
+/**
+ * Everything the logger needs from a single turn
+ *
+ * Holds no pointers into the state, so that the turn can be logged while the
+ * state moves on. The vectors keep their storage when a snapshot is reused.
+ */
+struct StateSnapshot {
+	/**
+	 * Soldiers of both players, player 1's first
+	 */
+	std::vector<SoldierSnapshot> soldiers;
+
+	/**
+	 * Villagers of both players, player 1's first
+	 */
+	std::vector<VillagerSnapshot> villagers;
+
+	/**
+	 * Factories of each player, in the order the state holds them
+	 */
+	std::array<std::vector<FactorySnapshot>, 2> factories;
+
+	std::array<int64_t, 2> gold;
+	std::array<int64_t, 2> scores;
+	std::array<int64_t, 2> instruction_counts;
+
+	/**
+	 * Number of times each player made each error this turn
+	 */
+	std::array<ErrorCounts, 2> error_counts;
+};
+
+/**
+ * Gets the memory a snapshot holds, with the storage of its vectors
+ */
+inline int64_t GetSnapshotBytes(const StateSnapshot &snapshot) {
+	auto bytes = static_cast<int64_t>(
+	    sizeof(StateSnapshot) +
+	    snapshot.soldiers.capacity() * sizeof(SoldierSnapshot) +
+	    snapshot.villagers.capacity() * sizeof(VillagerSnapshot));
+	for (auto const &factories : snapshot.factories) {
+		bytes += factories.capacity() * sizeof(FactorySnapshot);
+	}
+	return bytes;
+}
+} // namespace logger
@@ -0,0 +1,123 @@
+/**
+ * @file turn_profile.h
+ * Declarations for the time a game spent in each phase of its turns
+ */
+
+#pragma once
+
+#include "logger/logger_export.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace logger {
+
+/**
+ * Hardware events counted while a phase ran, in total over the game
+ */
+struct LOGGER_EXPORT PhaseCounters {
+	int64_t instructions;
+	int64_t cycles;
+
+	/**
+	 * Last level cache misses
+	 */
+	int64_t cache_misses;
+
+	int64_t branch_misses;
+};
+
+/**
+ * How long a phase of the turns of a game took
+ */
+struct LOGGER_EXPORT PhaseLatencies {
+	/**
+	 * Name of the phase
+	 */
+	std::string phase;
+
+	/**
+	 * Number of times the phase was timed
+	 */
+	int64_t count;
+
+	/**
+	 * Median, 99th percentile and longest time the phase took, in
+	 * nanoseconds. The percentiles are rounded up, by less than an eighth.
+	 */
+	int64_t p50_ns, p99_ns, max_ns;
+
+	/**
+	 * true if hardware events were counted for the phase, in which case they
+	 * are in counters
+	 */
+	bool has_counters;
+
+	PhaseCounters counters;
+};
+
+/**
+ * How long every phase of the turns of a game took
+ */
+using TurnProfile = std::vector<PhaseLatencies>;
+
+/**
+ * Field number that the encoded profile is appended under in a whole game
+ * log. proto::Game has no such field, so readers of the game skip it.
+ */
+const int TURN_PROFILE_FIELD_NUMBER = 1000;
+
+/**
+ * Encodes a turn profile, for the profile record of a streamed game log, or
+ * the profile field of a whole one
+ *
+ * @param[in]   turn_profile  The turn profile
+ * @param[out]  output        String to append the encoded profile to
+ */
+LOGGER_EXPORT void EncodeTurnProfile(const TurnProfile &turn_profile,
+                                     std::string &output);
+
+/**
+ * Decodes a turn profile
+ *
+ * @param[in]   input         The encoded profile
+ * @param[out]  turn_profile  The turn profile
+ *
+ * @return      true if the profile was read, false if it's malformed
+ */
+LOGGER_EXPORT bool DecodeTurnProfile(const std::string &input,
+                                     TurnProfile &turn_profile);
+
+/**
+ * Appends an encoded turn profile to a whole game log, as an extra field of
+ * the serialized proto::Game
+ *
+ * @param[in]   profile       The encoded profile
+ * @param[out]  write_stream  Stream the game was written to
+ */
+LOGGER_EXPORT void WriteTurnProfileField(const std::string &profile,
+                                         std::ostream &write_stream);
+
+/**
+ * Reads the turn profile out of a streamed or whole game log. Game log
+ * containers have no turn profile.
+ *
+ * @param[in]   read_stream   Stream to read the log from
+ * @param[out]  turn_profile  The turn profile
+ *
+ * @return      true if the log has a turn profile, false otherwise
+ */
+LOGGER_EXPORT bool ReadTurnProfile(std::istream &read_stream,
+                                   TurnProfile &turn_profile);
+
+/**
+ * Writes the phase name, count, and the percentiles and longest time in
+ * nanoseconds, followed by the hardware event counts if there are any, all
+ * separated by spaces
+ */
+LOGGER_EXPORT std::ostream &operator<<(std::ostream &os,
+                                       const PhaseLatencies &phase_latencies);
+} // namespace logger
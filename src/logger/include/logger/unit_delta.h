@@ -0,0 +1,150 @@
+/**
+ * @file unit_delta.h
+ * Declarations for encoding units as changes from the previous turn
+ */
+
+#pragma once
+
+#include "game.pb.h"
+#include "logger/logger_export.h"
+
+#include <cstdint>
+#include <google/protobuf/io/coded_stream.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace logger {
+
+/**
+ * Logged fields of a soldier or villager, as they appear in the game log
+ */
+struct UnitRecord {
+	int64_t id;
+	int64_t player_id;
+	int64_t hp;
+	int64_t x;
+	int64_t y;
+
+	/**
+	 * proto::SoldierState or proto::VillagerState of the unit
+	 */
+	int64_t state;
+
+	int64_t target_x;
+	int64_t target_y;
+};
+
+/**
+ * Encodes the units of each turn as edits to the units of the turn before
+ *
+ * A turn is a list of operations that walk over the previous turn's units in
+ * order. Each operation starts with a varint holding a count and its kind:
+ *
+ * - KEEP: the next count units are unchanged. A count of 0 ends the turn.
+ * - UPDATE: the next unit changed. The count is a mask of the changed fields,
+ *   each followed by its difference from the old value as a zigzag varint.
+ * - REMOVE: the next count units are gone, usually because they died.
+ * - INSERT: a unit that wasn't there before, with all of its fields.
+ *
+ * Units that don't move or change cost nothing beyond a shared KEEP.
+ */
+class LOGGER_EXPORT UnitDeltaEncoder {
+  private:
+	/**
+	 * Units as of the last encoded turn
+	 */
+	std::vector<UnitRecord> previous_units;
+
+	/**
+	 * Position of each unit in previous_units, built only when the units
+	 * come in an order the encoder doesn't expect
+	 */
+	std::unordered_map<int64_t, size_t> previous_positions;
+
+  public:
+	/**
+	 * Appends the changes since the last turn to the output
+	 *
+	 * @param[in]   units   Units this turn, in the order they are logged
+	 * @param[out]  output  String to append the encoded turn to
+	 */
+	void Encode(const std::vector<UnitRecord> &units, std::string &output);
+};
+
+/**
+ * Puts the units of each turn back together from the output of
+ * UnitDeltaEncoder
+ */
+class LOGGER_EXPORT UnitDeltaDecoder {
+  private:
+	/**
+	 * Units as of the last decoded turn
+	 */
+	std::vector<UnitRecord> previous_units;
+
+  public:
+	/**
+	 * Decodes the next turn
+	 *
+	 * @param[in]   input  Stream to read the encoded turn from
+	 * @param[out]  units  Units this turn, in the order they were logged
+	 *
+	 * @return      true if a whole turn was read, false if the input is
+	 *              malformed
+	 */
+	bool Decode(google::protobuf::io::CodedInputStream &input,
+	            std::vector<UnitRecord> &units);
+};
+
+/**
+ * Decodes the soldiers and then the villagers of a turn into its game frame
+ *
+ * @param[in]   input             Stream to read the encoded units from
+ * @param[in]   soldier_decoder   Decoder of the soldiers of earlier turns
+ * @param[in]   villager_decoder  Decoder of the villagers of earlier turns
+ * @param[out]  game_state        Game frame to add the units to
+ *
+ * @return      true if the units were read, false if they're malformed
+ */
+LOGGER_EXPORT bool DecodeUnits(google::protobuf::io::CodedInputStream &input,
+                               UnitDeltaDecoder &soldier_decoder,
+                               UnitDeltaDecoder &villager_decoder,
+                               proto::GameState &game_state);
+
+/**
+ * Copies the soldiers of a game frame into records
+ *
+ * @param[in]   game_state  Game frame to copy from
+ * @param[out]  units       Records of the soldiers, in order
+ */
+LOGGER_EXPORT void GetSoldierRecords(const proto::GameState &game_state,
+                                     std::vector<UnitRecord> &units);
+
+/**
+ * Copies the villagers of a game frame into records
+ *
+ * @param[in]   game_state  Game frame to copy from
+ * @param[out]  units       Records of the villagers, in order
+ */
+LOGGER_EXPORT void GetVillagerRecords(const proto::GameState &game_state,
+                                      std::vector<UnitRecord> &units);
+
+/**
+ * Adds soldiers to a game frame from their records
+ *
+ * @param[in]   units       Records of the soldiers
+ * @param[out]  game_state  Game frame to add them to
+ */
+LOGGER_EXPORT void AddSoldiers(const std::vector<UnitRecord> &units,
+                               proto::GameState &game_state);
+
+/**
+ * Adds villagers to a game frame from their records
+ *
+ * @param[in]   units       Records of the villagers
+ * @param[out]  game_state  Game frame to add them to
+ */
+LOGGER_EXPORT void AddVillagers(const std::vector<UnitRecord> &units,
+                                proto::GameState &game_state);
+} // namespace logger
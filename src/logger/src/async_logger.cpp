@@ -0,0 +1,111 @@
+/**
+ * @file async_logger.cpp
+ * Defines the logger that builds the game log on its own thread
+ */
+
+#include "logger/async_logger.h"
+
+namespace logger {
+
+AsyncLogger::AsyncLogger(std::unique_ptr<Logger> logger, size_t num_buffers)
+    : logger(std::move(logger)), snapshots(num_buffers),
+      snapshot_bytes(num_buffers, sizeof(StateSnapshot)),
+      total_snapshot_bytes(num_buffers * sizeof(StateSnapshot)),
+      num_captured(0), num_logged(0), is_stopping(false), mutex(), captured(),
+      logged(), log_thread([this] { Run(); }) {}
+
+AsyncLogger::~AsyncLogger() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		is_stopping = true;
+	}
+	captured.notify_one();
+	log_thread.join();
+}
+
+void AsyncLogger::Run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		captured.wait(lock, [this] {
+			return is_stopping || num_logged < num_captured;
+		});
+		if (num_logged == num_captured) {
+			return;
+		}
+
+		// The slot is left alone by LogState until it's marked as logged
+		auto &snapshot = snapshots[num_logged % snapshots.size()];
+		lock.unlock();
+		logger->LogSnapshot(snapshot);
+		lock.lock();
+
+		++num_logged;
+		logged.notify_all();
+	}
+}
+
+void AsyncLogger::WaitForLog() {
+	std::unique_lock<std::mutex> lock(mutex);
+	logged.wait(lock, [this] { return num_logged == num_captured; });
+}
+
+void AsyncLogger::BeginGame(std::ostream &write_stream) {
+	// Nothing has been captured yet, so the log thread is idle
+	logger->BeginGame(write_stream);
+}
+
+void AsyncLogger::LogState() {
+	size_t slot;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		logged.wait(lock, [this] {
+			return num_captured - num_logged < snapshots.size();
+		});
+		slot = num_captured % snapshots.size();
+	}
+
+	logger->CaptureState(snapshots[slot]);
+	auto bytes = GetSnapshotBytes(snapshots[slot]);
+	total_snapshot_bytes += bytes - snapshot_bytes[slot];
+	snapshot_bytes[slot] = bytes;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++num_captured;
+	}
+	captured.notify_one();
+}
+
+void AsyncLogger::LogInstructionCount(state::PlayerId player_id,
+                                      int64_t count) {
+	logger->LogInstructionCount(player_id, count);
+}
+
+void AsyncLogger::LogError(state::PlayerId player_id, ErrorMessage message) {
+	logger->LogError(player_id, message);
+}
+
+void AsyncLogger::LogTurnProfile(const TurnProfile &turn_profile) {
+	// The log thread measures the profile record along with the log, so it
+	// has to be done before the record is written
+	WaitForLog();
+	logger->LogTurnProfile(turn_profile);
+}
+
+void AsyncLogger::LogFinalGameParams(state::PlayerId player_id,
+                                     bool was_deathmatch,
+                                     std::array<int64_t, 2> final_scores) {
+	// The final scores go into the last frame, so it has to be built first
+	WaitForLog();
+	logger->LogFinalGameParams(player_id, was_deathmatch, final_scores);
+}
+
+void AsyncLogger::WriteGame(std::ostream &write_stream) {
+	WaitForLog();
+	logger->WriteGame(write_stream);
+}
+
+int64_t AsyncLogger::GetLogBytes() const {
+	return logger->GetLogBytes() + total_snapshot_bytes;
+}
+} // namespace logger
@@ -0,0 +1,197 @@
+/**
+ * @file block_compression.cpp
+ * Defines the LZ4 block compressor and decompressor
+ */
+
+#include "logger/block_compression.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace logger {
+
+namespace {
+
+/**
+ * Shortest match that can be encoded
+ */
+const size_t MIN_MATCH = 4;
+
+/**
+ * The last match has to start at least this far from the end
+ */
+const size_t MATCH_FIND_LIMIT = 12;
+
+/**
+ * The last bytes of a block are always literals
+ */
+const size_t LAST_LITERALS = 5;
+
+/**
+ * Farthest back a match can be
+ */
+const size_t MAX_OFFSET = 65535;
+
+const int HASH_BITS = 14;
+
+uint32_t Read32(const char *data) {
+	uint32_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+	return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+/**
+ * Appends a length that didn't fit in its 4 bits of the token
+ */
+void AppendLength(size_t length, std::string &output) {
+	while (length >= 255) {
+		output.push_back((char)255);
+		length -= 255;
+	}
+	output.push_back((char)length);
+}
+
+/**
+ * Appends a sequence of literals and an optional match after them
+ */
+void AppendSequence(const char *literals, size_t num_literals, size_t offset,
+                    size_t match_length, std::string &output) {
+	auto literal_bits = num_literals < 15 ? num_literals : 15;
+	auto match_bits = size_t{0};
+	if (match_length > 0) {
+		auto extra_length = match_length - MIN_MATCH;
+		match_bits = extra_length < 15 ? extra_length : 15;
+	}
+	output.push_back((char)(literal_bits << 4 | match_bits));
+
+	if (num_literals >= 15) {
+		AppendLength(num_literals - 15, output);
+	}
+	output.append(literals, num_literals);
+
+	if (match_length > 0) {
+		output.push_back((char)(offset & 0xff));
+		output.push_back((char)(offset >> 8));
+		if (match_length - MIN_MATCH >= 15) {
+			AppendLength(match_length - MIN_MATCH - 15, output);
+		}
+	}
+}
+
+/**
+ * Reads a length that didn't fit in its 4 bits of the token
+ */
+bool ReadLength(const uint8_t *&input, const uint8_t *input_end,
+                size_t &length) {
+	uint8_t byte;
+	do {
+		if (input == input_end) {
+			return false;
+		}
+		byte = *input++;
+		length += byte;
+	} while (byte == 255);
+	return true;
+}
+} // namespace
+
+void CompressBlock(const std::string &input, std::string &output) {
+	auto const *data = input.data();
+	auto size = input.size();
+
+	// Positions are offset by one, so that 0 means the slot is empty
+	std::vector<uint32_t> last_seen(size_t{1} << HASH_BITS, 0);
+
+	size_t anchor = 0;
+	size_t position = 0;
+	while (size >= MATCH_FIND_LIMIT && position < size - MATCH_FIND_LIMIT) {
+		auto sequence = Read32(data + position);
+		auto &slot = last_seen[Hash(sequence)];
+		auto candidate = size_t{slot};
+		slot = position + 1;
+
+		if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET ||
+		    Read32(data + candidate - 1) != sequence) {
+			++position;
+			continue;
+		}
+		auto match = candidate - 1;
+
+		auto length = MIN_MATCH;
+		while (position + length < size - LAST_LITERALS &&
+		       data[match + length] == data[position + length]) {
+			++length;
+		}
+
+		AppendSequence(data + anchor, position - anchor, position - match,
+		               length, output);
+		position += length;
+		anchor = position;
+	}
+
+	AppendSequence(data + anchor, size - anchor, 0, 0, output);
+}
+
+bool DecompressBlock(const char *input, size_t input_size, size_t size,
+                     std::string &output) {
+	output.resize(size);
+	auto *out = &output[0];
+	size_t out_position = 0;
+
+	auto const *in = reinterpret_cast<const uint8_t *>(input);
+	auto const *in_end = in + input_size;
+
+	while (in < in_end) {
+		auto token = *in++;
+
+		size_t num_literals = token >> 4;
+		if (num_literals == 15 && !ReadLength(in, in_end, num_literals)) {
+			return false;
+		}
+		if (num_literals > (size_t)(in_end - in) ||
+		    num_literals > size - out_position) {
+			return false;
+		}
+		std::memcpy(out + out_position, in, num_literals);
+		in += num_literals;
+		out_position += num_literals;
+
+		// The last sequence has no match
+		if (in == in_end) {
+			break;
+		}
+
+		if (in_end - in < 2) {
+			return false;
+		}
+		size_t offset = in[0] | in[1] << 8;
+		in += 2;
+		if (offset == 0 || offset > out_position) {
+			return false;
+		}
+
+		size_t match_length = token & 0xf;
+		if (match_length == 15 && !ReadLength(in, in_end, match_length)) {
+			return false;
+		}
+		match_length += MIN_MATCH;
+		if (match_length > size - out_position) {
+			return false;
+		}
+
+		// Matches can overlap what they write, so copy a byte at a time
+		auto match = out_position - offset;
+		for (size_t i = 0; i < match_length; ++i) {
+			out[out_position + i] = out[match + i];
+		}
+		out_position += match_length;
+	}
+
+	return out_position == size;
+}
+} // namespace logger
@@ -0,0 +1,78 @@
+/**
+ * @file error_counts.cpp
+ * Defines the encoding of the number of times each error was made in a turn
+ */
+
+#include "logger/error_counts.h"
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+
+namespace logger {
+
+namespace {
+
+const int MAX_VARINT_BYTES = 10;
+
+/**
+ * Most times an error can be made in a turn, past which a count is taken to
+ * be malformed
+ */
+const uint64_t MAX_ERROR_COUNT = uint64_t{1} << 32;
+
+void AppendVarint(uint64_t value, std::string &output) {
+	uint8_t buffer[MAX_VARINT_BYTES];
+	auto *end = CodedOutputStream::WriteVarint64ToArray(value, buffer);
+	output.append(reinterpret_cast<char *>(buffer), end - buffer);
+}
+} // namespace
+
+void AddErrors(const ErrorCounts &counts, proto::PlayerErrors &player_errors) {
+	for (size_t code = 0; code < counts.size(); ++code) {
+		for (int64_t i = 0; i < counts[code]; ++i) {
+			player_errors.add_errors(code);
+		}
+	}
+}
+
+void EncodeErrorCounts(const std::array<ErrorCounts, 2> &counts,
+                       std::string &output) {
+	for (auto const &player_counts : counts) {
+		uint64_t num_errors = 0;
+		for (auto count : player_counts) {
+			num_errors += count > 0;
+		}
+
+		AppendVarint(num_errors, output);
+		for (size_t code = 0; code < player_counts.size(); ++code) {
+			if (player_counts[code] > 0) {
+				AppendVarint(code, output);
+				AppendVarint(player_counts[code], output);
+			}
+		}
+	}
+}
+
+bool DecodeErrorCounts(CodedInputStream &input, proto::GameState &game_state) {
+	game_state.clear_player_errors();
+	for (int player_id = 0; player_id < 2; ++player_id) {
+		auto *player_errors = game_state.add_player_errors();
+
+		uint64_t num_errors;
+		if (!input.ReadVarint64(&num_errors)) {
+			return false;
+		}
+		for (uint64_t i = 0; i < num_errors; ++i) {
+			uint64_t code, count;
+			if (!input.ReadVarint64(&code) || !input.ReadVarint64(&count) ||
+			    count > MAX_ERROR_COUNT) {
+				return false;
+			}
+			for (uint64_t j = 0; j < count; ++j) {
+				player_errors->add_errors(code);
+			}
+		}
+	}
+	return true;
+}
+} // namespace logger
@@ -0,0 +1,392 @@
+/**
+ * @file game_log_container.cpp
+ * Defines the writer and reader for the block compressed game log container
+ */
+
+#include "logger/game_log_container.h"
+#include "logger/block_compression.h"
+#include "logger/game_log_stream.h"
+#include "logger/unit_delta.h"
+
+#include <algorithm>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <map>
+#include <sstream>
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::StringOutputStream;
+
+namespace logger {
+
+namespace {
+
+/**
+ * Size of the footer, which is the index offset and the magic again
+ */
+const size_t FOOTER_SIZE = 8 + 8;
+
+/**
+ * Factories as of some turn, by id
+ */
+typedef std::map<int64_t, proto::Factory> FactoryMap;
+
+/**
+ * Brings a set of factories up to date with the changes logged in a frame
+ */
+void ApplyFactories(const proto::GameState &game_state,
+                    FactoryMap &factories) {
+	for (auto const &factory : game_state.factories()) {
+		if (factory.state() == proto::FACTORY_DESTROYED) {
+			factories.erase(factory.id());
+			continue;
+		}
+
+		auto existing = factories.find(factory.id());
+		if (existing == factories.end()) {
+			factories[factory.id()] = factory;
+			continue;
+		}
+
+		// Changes don't repeat the position
+		existing->second.set_player_id(factory.player_id());
+		existing->second.set_hp(factory.hp());
+		existing->second.set_build_percent(factory.build_percent());
+		existing->second.set_state(factory.state());
+	}
+}
+
+/**
+ * Lists every factory in a frame, player by player like the first frame
+ */
+void ListFactories(const FactoryMap &factories,
+                   proto::GameState &game_state) {
+	game_state.clear_factories();
+	for (auto const &factory : factories) {
+		*game_state.add_factories() = factory.second;
+	}
+	std::stable_sort(game_state.mutable_factories()->begin(),
+	                 game_state.mutable_factories()->end(),
+	                 [](const proto::Factory &a, const proto::Factory &b) {
+		                 return a.player_id() < b.player_id();
+	                 });
+}
+
+/**
+ * Compresses a block and writes it, leaving it as is if that's smaller
+ */
+void WriteBlock(const std::string &data, std::ostream &write_stream,
+                std::string &compressed, bool &is_compressed) {
+	compressed.clear();
+	CompressBlock(data, compressed);
+	is_compressed = compressed.size() < data.size();
+	auto const &stored = is_compressed ? compressed : data;
+	write_stream.write(stored.data(), stored.size());
+}
+} // namespace
+
+void WriteGameLogContainer(const proto::Game &game,
+                           std::ostream &write_stream, int64_t block_turns) {
+	auto index = std::string{};
+	auto compressed = std::string{};
+	bool is_compressed;
+	uint64_t offset = GAME_LOG_CONTAINER_MAGIC.size();
+	{
+		StringOutputStream index_output(&index);
+		CodedOutputStream index_stream(&index_output);
+
+		write_stream.write(GAME_LOG_CONTAINER_MAGIC.data(),
+		                   GAME_LOG_CONTAINER_MAGIC.size());
+
+		// The header is everything but the frames
+		auto header = game;
+		header.clear_states();
+		auto header_data = header.SerializeAsString();
+		WriteBlock(header_data, write_stream, compressed, is_compressed);
+		auto header_stored_size =
+		    is_compressed ? compressed.size() : header_data.size();
+		index_stream.WriteVarint64(offset);
+		index_stream.WriteVarint64(header_stored_size);
+		index_stream.WriteVarint64(header_data.size());
+		index_stream.WriteVarint32(is_compressed);
+		offset += header_stored_size;
+
+		auto num_blocks =
+		    (game.states_size() + block_turns - 1) / block_turns;
+		index_stream.WriteVarint64(num_blocks);
+
+		auto factories = FactoryMap{};
+		std::ostringstream block_stream;
+		auto record_buffer = std::string{};
+		auto units = std::vector<UnitRecord>{};
+		auto unit_deltas = std::string{};
+		auto turn = proto::GameState{};
+
+		for (int64_t first_turn = 0; first_turn < game.states_size();
+		     first_turn += block_turns) {
+			auto last_turn =
+			    std::min<int64_t>(first_turn + block_turns, game.states_size());
+			block_stream.str("");
+
+			// Start the block with the factories so far
+			turn.Clear();
+			ListFactories(factories, turn);
+			WriteGameLogRecord(block_stream, GameLogRecordType::KEYFRAME, turn,
+			                   record_buffer);
+
+			// New encoders, so that the first turn has every unit in full
+			UnitDeltaEncoder soldier_encoder, villager_encoder;
+			for (auto i = first_turn; i < last_turn; ++i) {
+				auto const &game_state = game.states(i);
+				ApplyFactories(game_state, factories);
+
+				turn = game_state;
+				turn.clear_soldiers();
+				turn.clear_villagers();
+				WriteGameLogRecord(block_stream, GameLogRecordType::TURN, turn,
+				                   record_buffer);
+
+				unit_deltas.clear();
+				GetSoldierRecords(game_state, units);
+				soldier_encoder.Encode(units, unit_deltas);
+				GetVillagerRecords(game_state, units);
+				villager_encoder.Encode(units, unit_deltas);
+				WriteGameLogRecord(block_stream, GameLogRecordType::UNITS,
+				                   unit_deltas);
+			}
+
+			auto block_data = block_stream.str();
+			WriteBlock(block_data, write_stream, compressed, is_compressed);
+			auto stored_size =
+			    is_compressed ? compressed.size() : block_data.size();
+
+			index_stream.WriteVarint64(first_turn);
+			index_stream.WriteVarint64(last_turn - first_turn);
+			index_stream.WriteVarint64(offset);
+			index_stream.WriteVarint64(stored_size);
+			index_stream.WriteVarint64(block_data.size());
+			index_stream.WriteVarint32(is_compressed);
+			offset += stored_size;
+		}
+	}
+
+	write_stream.write(index.data(), index.size());
+
+	uint8_t footer[8];
+	CodedOutputStream::WriteLittleEndian64ToArray(offset, footer);
+	write_stream.write(reinterpret_cast<char *>(footer), sizeof(footer));
+	write_stream.write(GAME_LOG_CONTAINER_MAGIC.data(),
+	                   GAME_LOG_CONTAINER_MAGIC.size());
+	write_stream.flush();
+}
+
+GameLogContainerReader::GameLogContainerReader(std::istream &read_stream)
+    : read_stream(&read_stream), header(), blocks(), num_turns(0),
+      index_offset(0) {}
+
+bool GameLogContainerReader::Open() {
+	// Check the magic at both ends
+	auto magic = std::string(GAME_LOG_CONTAINER_MAGIC.size(), '\0');
+	read_stream->seekg(0);
+	read_stream->read(&magic[0], magic.size());
+	if (!*read_stream || magic != GAME_LOG_CONTAINER_MAGIC) {
+		return false;
+	}
+
+	read_stream->seekg(0, std::ios::end);
+	uint64_t size = read_stream->tellg();
+	if (size < magic.size() + FOOTER_SIZE) {
+		return false;
+	}
+
+	uint8_t footer[FOOTER_SIZE];
+	read_stream->seekg(size - FOOTER_SIZE);
+	read_stream->read(reinterpret_cast<char *>(footer), FOOTER_SIZE);
+	CodedInputStream::ReadLittleEndian64FromArray(footer, &index_offset);
+	if (!*read_stream ||
+	    std::string(reinterpret_cast<char *>(footer) + 8, 8) !=
+	        GAME_LOG_CONTAINER_MAGIC ||
+	    index_offset > size - FOOTER_SIZE) {
+		return false;
+	}
+
+	auto index = std::string(size - FOOTER_SIZE - index_offset, '\0');
+	read_stream->seekg(index_offset);
+	read_stream->read(&index[0], index.size());
+	if (!*read_stream) {
+		return false;
+	}
+
+	CodedInputStream index_stream(
+	    reinterpret_cast<const uint8_t *>(index.data()), index.size());
+	BlockEntry header_block{0, 0, 0, 0, 0, false};
+	uint32_t is_compressed;
+	uint64_t num_blocks;
+	if (!index_stream.ReadVarint64(&header_block.offset) ||
+	    !index_stream.ReadVarint64(&header_block.stored_size) ||
+	    !index_stream.ReadVarint64(&header_block.size) ||
+	    !index_stream.ReadVarint32(&is_compressed) ||
+	    !index_stream.ReadVarint64(&num_blocks)) {
+		return false;
+	}
+	header_block.is_compressed = is_compressed;
+
+	blocks.clear();
+	num_turns = 0;
+	for (uint64_t i = 0; i < num_blocks; ++i) {
+		BlockEntry block;
+		uint64_t first_turn, block_turns;
+		if (!index_stream.ReadVarint64(&first_turn) ||
+		    !index_stream.ReadVarint64(&block_turns) ||
+		    !index_stream.ReadVarint64(&block.offset) ||
+		    !index_stream.ReadVarint64(&block.stored_size) ||
+		    !index_stream.ReadVarint64(&block.size) ||
+		    !index_stream.ReadVarint32(&is_compressed) ||
+		    (int64_t)first_turn != num_turns) {
+			return false;
+		}
+		block.first_turn = first_turn;
+		block.num_turns = block_turns;
+		block.is_compressed = is_compressed;
+		blocks.push_back(block);
+		num_turns += block.num_turns;
+	}
+
+	auto header_data = std::string{};
+	return ReadBlock(header_block, header_data) &&
+	       header.ParseFromString(header_data);
+}
+
+int64_t GameLogContainerReader::GetNumTurns() const { return num_turns; }
+
+bool GameLogContainerReader::ReadBlock(const BlockEntry &block,
+                                       std::string &data) {
+	// The index comes from the file, so a block has to fit between the magic
+	// and the index, and its size has to be one its stored bytes can hold,
+	// before anything is allocated for it
+	auto max_size = block.is_compressed
+	                    ? block.stored_size * MAX_COMPRESSION_RATIO
+	                    : block.stored_size;
+	if (block.offset < GAME_LOG_CONTAINER_MAGIC.size() ||
+	    block.offset > index_offset ||
+	    block.stored_size > index_offset - block.offset ||
+	    block.size > max_size) {
+		return false;
+	}
+
+	auto stored = std::string(block.stored_size, '\0');
+	read_stream->seekg(block.offset);
+	read_stream->read(&stored[0], stored.size());
+	if (!*read_stream) {
+		return false;
+	}
+
+	if (!block.is_compressed) {
+		data = std::move(stored);
+		return data.size() == block.size;
+	}
+	return DecompressBlock(stored.data(), stored.size(), block.size, data);
+}
+
+bool GameLogContainerReader::ReadTurns(int64_t first_turn, int64_t count,
+                                       proto::Game &game) {
+	if (first_turn < 0 || count < 0 || first_turn + count > num_turns) {
+		return false;
+	}
+
+	game = header;
+	auto last_turn = first_turn + count;
+
+	// Only the blocks that have some of the turns are read
+	auto block = std::upper_bound(blocks.begin(), blocks.end(), first_turn,
+	                              [](int64_t turn, const BlockEntry &entry) {
+		                              return turn < entry.first_turn;
+	                              });
+	if (block != blocks.begin()) {
+		--block;
+	}
+
+	auto data = std::string{};
+	auto factories = FactoryMap{};
+	auto skipped_turn = proto::GameState{};
+	for (; block != blocks.end() && block->first_turn < last_turn; ++block) {
+		if (!ReadBlock(*block, data)) {
+			return false;
+		}
+
+		CodedInputStream input(reinterpret_cast<const uint8_t *>(data.data()),
+		                       data.size());
+		UnitDeltaDecoder soldier_decoder, villager_decoder;
+		auto turn = block->first_turn - 1;
+		auto *game_state = &skipped_turn;
+
+		uint8_t type;
+		while (input.ReadRaw(&type, sizeof(type))) {
+			uint32_t length;
+			if (!input.ReadVarint32(&length)) {
+				return false;
+			}
+			auto limit = input.PushLimit((int)length);
+
+			bool parsed = false;
+			switch ((GameLogRecordType)type) {
+			case GameLogRecordType::KEYFRAME:
+				// Only the block the range starts in needs the factories
+				skipped_turn.Clear();
+				parsed = skipped_turn.MergeFromCodedStream(&input);
+				if (turn < first_turn) {
+					factories.clear();
+					ApplyFactories(skipped_turn, factories);
+				}
+				break;
+			case GameLogRecordType::TURN:
+				// Turns before the range are only read to bring the
+				// factories and units up to date
+				++turn;
+				if (turn < first_turn) {
+					skipped_turn.Clear();
+					game_state = &skipped_turn;
+				} else {
+					game_state = game.add_states();
+				}
+				parsed = game_state->MergeFromCodedStream(&input);
+				if (turn < first_turn) {
+					ApplyFactories(skipped_turn, factories);
+				}
+				break;
+			case GameLogRecordType::UNITS:
+				parsed = DecodeUnits(input, soldier_decoder, villager_decoder,
+				                     *game_state) &&
+				         input.BytesUntilLimit() == 0;
+				break;
+			default:
+				break;
+			}
+			if (!parsed) {
+				return false;
+			}
+			input.PopLimit(limit);
+
+			// Stop once the units of the last turn in range are read
+			if (turn == last_turn - 1 &&
+			    (GameLogRecordType)type == GameLogRecordType::UNITS) {
+				break;
+			}
+		}
+	}
+
+	if (game.states_size() != count) {
+		return false;
+	}
+
+	// A range that starts later gets all of its factories up front
+	if (first_turn > 0 && count > 0) {
+		auto *first_state = game.mutable_states(0);
+		ApplyFactories(*first_state, factories);
+		ListFactories(factories, *first_state);
+	}
+
+	return true;
+}
+} // namespace logger
@@ -0,0 +1,119 @@
+/**
+ * @file game_log_stream.cpp
+ * Defines the reader and writer for the streamed game log format
+ */
+
+#include "logger/game_log_stream.h"
+#include "logger/error_counts.h"
+#include "logger/game_log_container.h"
+#include "logger/unit_delta.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include <limits>
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::IstreamInputStream;
+
+namespace logger {
+
+void WriteGameLogRecord(std::ostream &write_stream, GameLogRecordType type,
+                        const google::protobuf::MessageLite &message,
+                        std::string &buffer) {
+	// Reuse the buffer's storage instead of allocating for every record
+	buffer.clear();
+	message.AppendToString(&buffer);
+	WriteGameLogRecord(write_stream, type, buffer);
+}
+
+void WriteGameLogRecord(std::ostream &write_stream, GameLogRecordType type,
+                        const std::string &data) {
+	// Type byte and the longest possible varint32
+	uint8_t prefix[1 + 5];
+	prefix[0] = (uint8_t)type;
+	auto *prefix_end = CodedOutputStream::WriteVarint32ToArray(
+	    (uint32_t)data.size(), prefix + 1);
+
+	write_stream.write(reinterpret_cast<const char *>(prefix),
+	                   prefix_end - prefix);
+	write_stream.write(data.data(), data.size());
+}
+
+bool ReadGameLog(std::istream &read_stream, proto::Game &game) {
+	game.Clear();
+
+	// Logs without the magic were written as a whole
+	auto start = read_stream.tellg();
+	std::string magic(GAME_LOG_STREAM_MAGIC.size(), '\0');
+	read_stream.read(&magic[0], magic.size());
+	if (read_stream && magic == GAME_LOG_CONTAINER_MAGIC) {
+		GameLogContainerReader reader(read_stream);
+		return reader.Open() &&
+		       reader.ReadTurns(0, reader.GetNumTurns(), game);
+	}
+	if (!read_stream || magic != GAME_LOG_STREAM_MAGIC) {
+		read_stream.clear();
+		read_stream.seekg(start);
+		return game.ParseFromIstream(&read_stream);
+	}
+
+	IstreamInputStream raw_input(&read_stream);
+	CodedInputStream input(&raw_input);
+
+	// Turn records are small, but a whole game can go past the default limit
+	input.SetTotalBytesLimit(std::numeric_limits<int>::max());
+
+	UnitDeltaDecoder soldier_decoder, villager_decoder;
+
+	bool has_header = false;
+	uint8_t type;
+	while (input.ReadRaw(&type, sizeof(type))) {
+		uint32_t length;
+		if (!input.ReadVarint32(&length)) {
+			return false;
+		}
+
+		auto limit = input.PushLimit((int)length);
+		bool parsed = false;
+		switch ((GameLogRecordType)type) {
+		case GameLogRecordType::HEADER:
+			has_header = true;
+			parsed = game.MergeFromCodedStream(&input);
+			break;
+		case GameLogRecordType::TURN:
+			parsed = game.add_states()->MergeFromCodedStream(&input);
+			break;
+		case GameLogRecordType::TRAILER:
+			return has_header && game.MergeFromCodedStream(&input);
+		case GameLogRecordType::KEYFRAME:
+			// Keyframes are only found in containers
+			break;
+		case GameLogRecordType::UNITS:
+			parsed = game.states_size() > 0 &&
+			         DecodeUnits(input, soldier_decoder, villager_decoder,
+			                     *game.mutable_states()->rbegin()) &&
+			         input.BytesUntilLimit() == 0;
+			break;
+		case GameLogRecordType::ERRORS:
+			parsed = game.states_size() > 0 &&
+			         DecodeErrorCounts(input,
+			                           *game.mutable_states()->rbegin()) &&
+			         input.BytesUntilLimit() == 0;
+			break;
+		case GameLogRecordType::PROFILE:
+			// The game itself doesn't have the profile, see ReadTurnProfile
+			parsed = input.Skip((int)length);
+			break;
+		}
+		if (!parsed) {
+			return false;
+		}
+		input.PopLimit(limit);
+	}
+
+	// The stream ended before the trailer
+	return false;
+}
+} // namespace logger
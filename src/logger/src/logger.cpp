@@ -4,6 +4,8 @@
  */
 
 #include "logger/logger.h"
+#include "logger/error_counts.h"
+#include "logger/game_log_stream.h"
 #include "state/interfaces/i_command_taker.h"
 
 #include <string>
@@ -14,16 +16,20 @@ namespace logger {
 
 Logger::Logger(ICommandTaker *state, int64_t player_instruction_limit_turn,
                int64_t player_instruction_limit_game, int64_t soldier_max_hp,
-               int64_t villager_max_hp, int64_t factory_max_hp)
+               int64_t villager_max_hp, int64_t factory_max_hp,
+               bool stream_game)
     : state(state), turn_count(0), factory_logs(),
-      logs(std::make_unique<proto::Game>()),
+      arena(),
+      logs(google::protobuf::Arena::CreateMessage<proto::Game>(&arena)),
       instruction_counts(std::vector<int64_t>((int)PlayerId::PLAYER_COUNT, 0)),
-      error_map(std::unordered_map<std::string, int64_t>()),
-      current_error_code(0), errors(std::array<std::vector<int64_t>, 2>()),
+      error_counts(),
       player_instruction_limit_turn(player_instruction_limit_turn),
       player_instruction_limit_game(player_instruction_limit_game),
       soldier_max_hp(soldier_max_hp), villager_max_hp(villager_max_hp),
-      factory_max_hp(factory_max_hp) {}
+      factory_max_hp(factory_max_hp), stream_game(stream_game),
+      stream(nullptr), record_buffer(), is_header_logged(false),
+      snapshot(), soldier_encoder(), villager_encoder(), unit_records(),
+      unit_deltas(), error_record(), profile_record(), log_bytes(0) {}
 
 proto::FactoryState GetProtoFactoryState(FactoryStateName factory_state,
                                          ActorType production_state) {
@@ -71,6 +77,54 @@ FactoryState GetFactoryState(FactoryStateName factory_state,
 	return curr_factory_state;
 }
 
+proto::SoldierState GetProtoSoldierState(SoldierStateName soldier_state) {
+	proto::SoldierState soldier_state_proto;
+	switch (soldier_state) {
+	case SoldierStateName::IDLE:
+		soldier_state_proto = proto::SOLDIER_IDLE;
+		break;
+	case SoldierStateName::MOVE:
+	case SoldierStateName::PURSUIT:
+		soldier_state_proto = proto::SOLDIER_MOVE;
+		break;
+	case SoldierStateName::ATTACK:
+		soldier_state_proto = proto::SOLDIER_ATTACK;
+		break;
+	case SoldierStateName::DEAD:
+		soldier_state_proto = proto::SOLDIER_DEAD;
+		break;
+	}
+	return soldier_state_proto;
+}
+
+proto::VillagerState GetProtoVillagerState(VillagerStateName villager_state) {
+	proto::VillagerState villager_state_proto;
+	switch (villager_state) {
+	case VillagerStateName::IDLE:
+		villager_state_proto = proto::VILLAGER_IDLE;
+		break;
+	case VillagerStateName::MOVE:
+	case VillagerStateName::MOVE_TO_BUILD:
+	case VillagerStateName::MOVE_TO_MINE:
+	case VillagerStateName::PURSUIT:
+		villager_state_proto = proto::VILLAGER_MOVE;
+		break;
+	case VillagerStateName::ATTACK:
+		villager_state_proto = proto::VILLAGER_ATTACK;
+		break;
+	case VillagerStateName::MINE:
+		villager_state_proto = proto::VILLAGER_MINE;
+		break;
+	case VillagerStateName::BUILD:
+		villager_state_proto = proto::VILLAGER_BUILD;
+		break;
+	case VillagerStateName::DEAD:
+		villager_state_proto = proto::VILLAGER_DEAD;
+		break;
+	}
+	return villager_state_proto;
+}
+
 proto::TerrainType GetProtoTerrainType(TerrainType terrain) {
 	proto::TerrainType terrain_proto;
 	switch (terrain) {
@@ -87,37 +141,168 @@ proto::TerrainType GetProtoTerrainType(TerrainType terrain) {
 	return terrain_proto;
 }
 
+void Logger::BeginGame(std::ostream &write_stream) {
+	LogHeader();
+	is_header_logged = true;
+	if (!stream_game) {
+		return;
+	}
+
+	// The header goes out before the first turn, so nothing of it is kept
+	stream = &write_stream;
+	stream->write(GAME_LOG_STREAM_MAGIC.data(), GAME_LOG_STREAM_MAGIC.size());
+	WriteGameLogRecord(*stream, GameLogRecordType::HEADER, *logs,
+	                   record_buffer);
+	logs->Clear();
+	UpdateLogBytes();
+}
+
+void Logger::LogHeader() {
+	// Set map properties
+	auto const *map = state->GetMap();
+	auto map_size = map->GetSize();
+	auto map_element_size = map->GetElementSize();
+
+	logs->set_map_size(map_size);
+	logs->set_map_element_size(map_element_size);
+	for (int i = 0; i < map_size; ++i) {
+		for (int j = 0; j < map_size; ++j) {
+			logs->add_map_elements(
+			    GetProtoTerrainType(map->GetTerrainTypeByOffset(i, j)));
+		}
+	}
+
+	// Set max HPs of actors
+	logs->set_soldier_max_hp(this->soldier_max_hp);
+	logs->set_villager_max_hp(this->villager_max_hp);
+	logs->set_factory_max_hp(this->factory_max_hp);
+
+	// Set instruction limit constants
+	logs->set_inst_limit_turn(this->player_instruction_limit_turn);
+	logs->set_inst_limit_game(this->player_instruction_limit_game);
+
+	// Every error code maps to "ERROR_TYPE: <message_string>"
+	auto &error_map = *logs->mutable_error_map();
+	for (size_t code = 0; code < NUM_ERROR_MESSAGES; ++code) {
+		auto const &message = ERROR_MESSAGES[code];
+		error_map[code] =
+		    ErrorTypeName[(int)message.type] + ": " + message.text;
+	}
+}
+
+void Logger::FlushStates() {
+	if (stream == nullptr || logs->states_size() == 0) {
+		return;
+	}
+
+	// Turns are flushed as soon as the next one comes in, so there's only
+	// ever one here, and the unit changes are that turn's
+	for (auto const &game_state : logs->states()) {
+		WriteGameLogRecord(*stream, GameLogRecordType::TURN, game_state,
+		                   record_buffer);
+	}
+	WriteGameLogRecord(*stream, GameLogRecordType::ERRORS, error_record);
+	error_record.clear();
+	WriteGameLogRecord(*stream, GameLogRecordType::UNITS, unit_deltas);
+	unit_deltas.clear();
+	stream->flush();
+
+	// Clearing keeps the frames allocated, to be reused for the next turns
+	logs->mutable_states()->Clear();
+}
+
 void Logger::LogState() {
-	turn_count++;
-	auto *game_state = logs->add_states();
+	CaptureState(snapshot);
+	LogSnapshot(snapshot);
+}
 
+void Logger::CaptureState(StateSnapshot &snapshot) {
 	auto soldiers = state->GetSoldiers();
 	auto villagers = state->GetVillagers();
 	auto factories = state->GetFactories();
-	auto money = state->GetGold();
-	auto scores = state->GetScores(false);
 
-	// Things set only during the first turn.
-	if (turn_count == 1) {
-		// Set map properties
-		auto const *map = state->GetMap();
-		auto map_size = map->GetSize();
-		auto map_element_size = map->GetElementSize();
-
-		logs->set_map_size(map_size);
-		logs->set_map_element_size(map_element_size);
-		std::vector<proto::TerrainType> map_terrain;
-		for (int i = 0; i < map_size; ++i) {
-			for (int j = 0; j < map_size; ++j) {
-				logs->add_map_elements(
-				    GetProtoTerrainType(map->GetTerrainTypeByOffset(i, j)));
+	snapshot.soldiers.clear();
+	for (auto const &player_soldiers : soldiers) {
+		for (auto const &soldier : player_soldiers) {
+			auto target_x = int64_t{-1};
+			auto target_y = int64_t{-1};
+			if (soldier->IsAttackTargetSet()) {
+				auto target_pos = soldier->GetAttackTarget()->GetPosition();
+				target_x = (int)target_pos.x;
+				target_y = (int)target_pos.y;
 			}
+			snapshot.soldiers.push_back(
+			    {(int)soldier->GetActorId(), (int)soldier->GetPlayerId(),
+			     soldier->GetHp(), (int)soldier->GetPosition().x,
+			     (int)soldier->GetPosition().y, soldier->GetState(), target_x,
+			     target_y});
 		}
+	}
 
-		// Set max HPs of actors
-		logs->set_soldier_max_hp(this->soldier_max_hp);
-		logs->set_villager_max_hp(this->villager_max_hp);
-		logs->set_factory_max_hp(this->factory_max_hp);
+	snapshot.villagers.clear();
+	for (auto const &player_villagers : villagers) {
+		for (auto const &villager : player_villagers) {
+			auto target_x = int64_t{-1};
+			auto target_y = int64_t{-1};
+			if (villager->IsAttackTargetSet()) {
+				auto target_pos = villager->GetAttackTarget()->GetPosition();
+				target_x = (int)target_pos.x;
+				target_y = (int)target_pos.y;
+			} else if (villager->IsMineTargetSet()) {
+				auto target_pos = villager->GetMineTarget();
+				target_x = target_pos.x;
+				target_y = target_pos.y;
+			} else if (villager->IsBuildTargetSet()) {
+				auto target_factory_pos =
+				    villager->GetBuildTarget()->GetPosition();
+				target_x = (int)target_factory_pos.x;
+				target_y = (int)target_factory_pos.y;
+			}
+			snapshot.villagers.push_back(
+			    {(int)villager->GetActorId(), (int)villager->GetPlayerId(),
+			     villager->GetHp(), (int)villager->GetPosition().x,
+			     (int)villager->GetPosition().y, villager->GetState(),
+			     target_x, target_y});
+		}
+	}
+
+	for (int i = 0; i < (int)PlayerId::PLAYER_COUNT; ++i) {
+		snapshot.factories[i].clear();
+		for (auto const &factory : factories[i]) {
+			snapshot.factories[i].push_back(
+			    {factory->GetActorId(), (int)factory->GetPlayerId(),
+			     factory->GetHp(), (int)factory->GetPosition().x,
+			     (int)factory->GetPosition().y, factory->GetState(),
+			     factory->GetProductionState(),
+			     factory->GetConstructionCompletion(),
+			     factory->GetTotalConstructionCompletion()});
+		}
+	}
+
+	snapshot.gold = state->GetGold();
+	snapshot.scores = state->GetScores(false);
+
+	// Take the instruction counts and errors, and reset them for the next turn
+	for (int i = 0; i < (int)PlayerId::PLAYER_COUNT; ++i) {
+		snapshot.instruction_counts[i] = instruction_counts[i];
+		instruction_counts[i] = 0;
+		snapshot.error_counts[i] = error_counts[i];
+		error_counts[i].fill(0);
+	}
+}
+
+void Logger::LogSnapshot(const StateSnapshot &snapshot) {
+	turn_count++;
+	FlushStates();
+	auto *game_state = logs->add_states();
+
+	auto const &factories = snapshot.factories;
+
+	// Things set only during the first turn.
+	if (turn_count == 1) {
+		if (!is_header_logged) {
+			LogHeader();
+		}
 
 		// Set factories and add actor log entires
 		for (int i = 0; i < (int)PlayerId::PLAYER_COUNT; i++) {
@@ -126,29 +311,25 @@ void Logger::LogState() {
 			std::vector<FactoryLogEntry> player_factory_log_entry;
 			for (auto const &factory : factories[i]) {
 				proto::Factory *t_factory = game_state->add_factories();
-				t_factory->set_id((int)factory->GetActorId());
-				t_factory->set_player_id((int)factory->GetPlayerId());
-				t_factory->set_hp(factory->GetHp());
-				t_factory->set_x((int)factory->GetPosition().x);
-				t_factory->set_y((int)factory->GetPosition().y);
+				t_factory->set_id((int)factory.id);
+				t_factory->set_player_id(factory.player_id);
+				t_factory->set_hp(factory.hp);
+				t_factory->set_x(factory.x);
+				t_factory->set_y(factory.y);
 				t_factory->set_state(GetProtoFactoryState(
-				    factory->GetState(), factory->GetProductionState()));
-				auto current = (double)factory->GetConstructionCompletion();
-				auto total = (double)factory->GetTotalConstructionCompletion();
+				    factory.state, factory.production_state));
+				auto current = (double)factory.construction_completion;
+				auto total = (double)factory.total_construction_completion;
 				int build_percent = floor((current / total) * 100);
 				t_factory->set_build_percent(build_percent);
 				player_factory_log_entry.push_back(
-				    {(int)factory->GetActorId(), factory->GetHp(),
-				     (int)factory->GetConstructionCompletion(),
-				     GetFactoryState(factory->GetState(),
-				                     factory->GetProductionState())});
+				    {(int)factory.id, factory.hp,
+				     (int)factory.construction_completion,
+				     GetFactoryState(factory.state,
+				                     factory.production_state)});
 			}
 			factory_logs[i] = player_factory_log_entry;
 		}
-
-		// Set instruction limit constants
-		logs->set_inst_limit_turn(this->player_instruction_limit_turn);
-		logs->set_inst_limit_game(this->player_instruction_limit_game);
 	} else {
 		// Things done in subsequent turns
 		for (int i = 0; i < (int)PlayerId::PLAYER_COUNT; ++i) {
@@ -160,37 +341,35 @@ void Logger::LogState() {
 			       factory_ptr < factories[i].size()) {
 
 				auto curr_log = factory_logs[i][log_ptr];
-				auto curr_factory = factories[i][factory_ptr];
+				auto const &curr_factory = factories[i][factory_ptr];
 
 				// Check if a factory exists in both lists
-				if (curr_log.id == (int)curr_factory->GetActorId()) {
+				if (curr_log.id == (int)curr_factory.id) {
 
-					FactoryState curr_factory_state =
-					    GetFactoryState(curr_factory->GetState(),
-					                    curr_factory->GetProductionState());
+					FactoryState curr_factory_state = GetFactoryState(
+					    curr_factory.state, curr_factory.production_state);
 					auto current =
-					    (double)curr_factory->GetConstructionCompletion();
+					    (double)curr_factory.construction_completion;
 					auto total =
-					    (double)curr_factory->GetTotalConstructionCompletion();
+					    (double)curr_factory.total_construction_completion;
 					int build_percent = floor((current / total) * 100);
 
 					// If it does, check if it's stats have changed
-					if (curr_log.hp != curr_factory->GetHp() ||
+					if (curr_log.hp != curr_factory.hp ||
 					    curr_log.state != curr_factory_state ||
 					    curr_log.build_percent != build_percent) {
 
 						// An existing factory's stats have changed. Log it
 						auto *t_factory = game_state->add_factories();
-						t_factory->set_id((int)curr_factory->GetActorId());
+						t_factory->set_id((int)curr_factory.id);
 						t_factory->set_player_id(i);
-						t_factory->set_hp(curr_factory->GetHp());
+						t_factory->set_hp(curr_factory.hp);
 						t_factory->set_build_percent(build_percent);
 						t_factory->set_state(GetProtoFactoryState(
-						    curr_factory->GetState(),
-						    curr_factory->GetProductionState()));
+						    curr_factory.state, curr_factory.production_state));
 
 						// Update the factory log as well
-						factory_logs[i][log_ptr].hp = curr_factory->GetHp();
+						factory_logs[i][log_ptr].hp = curr_factory.hp;
 						factory_logs[i][log_ptr].state = curr_factory_state;
 						factory_logs[i][log_ptr].build_percent = build_percent;
 					}
@@ -198,7 +377,7 @@ void Logger::LogState() {
 					log_ptr++;
 					factory_ptr++;
 
-				} else if (curr_log.id < curr_factory->GetActorId()) {
+				} else if (curr_log.id < curr_factory.id) {
 					// If a factory dies, the main factory id will be greater
 
 					// A factory was destroyed. Log this factory from the log.
@@ -235,29 +414,25 @@ void Logger::LogState() {
 
 			// Remaining factories in the main list are newly built
 			while (factory_ptr < factories[i].size()) {
-				auto *curr_factory = factories[i][factory_ptr];
-				auto current =
-				    (double)curr_factory->GetConstructionCompletion();
-				auto total =
-				    (double)curr_factory->GetTotalConstructionCompletion();
+				auto const &curr_factory = factories[i][factory_ptr];
+				auto current = (double)curr_factory.construction_completion;
+				auto total = (double)curr_factory.total_construction_completion;
 				int build_percent = floor((current / total) * 100);
 
 				// A newly built factory. Log it.
 				auto *t_factory = game_state->add_factories();
-				t_factory->set_id((int)curr_factory->GetActorId());
-				t_factory->set_player_id((int)curr_factory->GetPlayerId());
-				t_factory->set_hp(curr_factory->GetHp());
-				t_factory->set_x((int)curr_factory->GetPosition().x);
-				t_factory->set_y((int)curr_factory->GetPosition().y);
-				t_factory->set_state(
-				    GetProtoFactoryState(curr_factory->GetState(),
-				                         curr_factory->GetProductionState()));
+				t_factory->set_id((int)curr_factory.id);
+				t_factory->set_player_id(curr_factory.player_id);
+				t_factory->set_hp(curr_factory.hp);
+				t_factory->set_x(curr_factory.x);
+				t_factory->set_y(curr_factory.y);
+				t_factory->set_state(GetProtoFactoryState(
+				    curr_factory.state, curr_factory.production_state));
 				t_factory->set_build_percent(build_percent);
 				factory_logs[i].push_back(
-				    {(int)curr_factory->GetActorId(), curr_factory->GetHp(),
-				     build_percent,
-				     GetFactoryState(curr_factory->GetState(),
-				                     curr_factory->GetProductionState())});
+				    {(int)curr_factory.id, curr_factory.hp, build_percent,
+				     GetFactoryState(curr_factory.state,
+				                     curr_factory.production_state)});
 				factory_ptr++;
 			}
 		}
@@ -265,148 +440,102 @@ void Logger::LogState() {
 
 	// Things to be logged in all turns
 
-	for (auto const &player_soldiers : soldiers) {
-		for (auto const &soldier : player_soldiers) {
-			proto::Soldier *t_soldier = game_state->add_soldiers();
-			t_soldier->set_id((int)soldier->GetActorId());
-			t_soldier->set_player_id((int)soldier->GetPlayerId());
-			t_soldier->set_hp(soldier->GetHp());
-			t_soldier->set_x((int)soldier->GetPosition().x);
-			t_soldier->set_y((int)soldier->GetPosition().y);
-			switch (soldier->GetState()) {
-			case SoldierStateName::IDLE:
-				t_soldier->set_state(proto::SOLDIER_IDLE);
-				break;
-			case SoldierStateName::MOVE:
-			case SoldierStateName::PURSUIT:
-				t_soldier->set_state(proto::SOLDIER_MOVE);
-				break;
-			case SoldierStateName::ATTACK:
-				t_soldier->set_state(proto::SOLDIER_ATTACK);
-				break;
-			case SoldierStateName::DEAD:
-				t_soldier->set_state(proto::SOLDIER_DEAD);
-				break;
-			}
-			if (soldier->IsAttackTargetSet()) {
-				auto target_pos = soldier->GetAttackTarget()->GetPosition();
-				t_soldier->set_target_x((int)target_pos.x);
-				t_soldier->set_target_y((int)target_pos.y);
-			} else {
-				t_soldier->set_target_x(-1);
-				t_soldier->set_target_y(-1);
-			}
-		}
-	}
-
-	for (auto const &player_villagers : villagers) {
-		for (auto const &villager : player_villagers) {
-			proto::Villager *t_villager = game_state->add_villagers();
-			t_villager->set_id((int)villager->GetActorId());
-			t_villager->set_player_id((int)villager->GetPlayerId());
-			t_villager->set_hp(villager->GetHp());
-			t_villager->set_x((int)villager->GetPosition().x);
-			t_villager->set_y((int)villager->GetPosition().y);
-			switch (villager->GetState()) {
-			case VillagerStateName::IDLE:
-				t_villager->set_state(proto::VILLAGER_IDLE);
-				break;
-			case VillagerStateName::MOVE:
-			case VillagerStateName::MOVE_TO_BUILD:
-			case VillagerStateName::MOVE_TO_MINE:
-			case VillagerStateName::PURSUIT:
-				t_villager->set_state(proto::VILLAGER_MOVE);
-				break;
-			case VillagerStateName::ATTACK:
-				t_villager->set_state(proto::VILLAGER_ATTACK);
-				break;
-			case VillagerStateName::MINE:
-				t_villager->set_state(proto::VILLAGER_MINE);
-				break;
-			case VillagerStateName::BUILD:
-				t_villager->set_state(proto::VILLAGER_BUILD);
-				break;
-			case VillagerStateName::DEAD:
-				t_villager->set_state(proto::VILLAGER_DEAD);
-				break;
-			}
-			if (villager->IsAttackTargetSet()) {
-				auto target_pos = villager->GetAttackTarget()->GetPosition();
-				t_villager->set_target_x((int)target_pos.x);
-				t_villager->set_target_y((int)target_pos.y);
-			} else if (villager->IsMineTargetSet()) {
-				auto target_pos = villager->GetMineTarget();
-				t_villager->set_target_x(target_pos.x);
-				t_villager->set_target_y(target_pos.y);
-			} else if (villager->IsBuildTargetSet()) {
-				auto target_factory_pos =
-				    villager->GetBuildTarget()->GetPosition();
-				t_villager->set_target_x((int)target_factory_pos.x);
-				t_villager->set_target_y((int)target_factory_pos.y);
-			} else {
-				t_villager->set_target_x(-1);
-				t_villager->set_target_y(-1);
-			}
-		}
+	if (stream != nullptr) {
+		LogUnitDeltas(snapshot);
+	} else {
+		LogUnits(snapshot, game_state);
 	}
 
 	// Log player money
-	for (auto player_money : money) {
+	for (auto player_money : snapshot.gold) {
 		game_state->add_gold(player_money);
 	}
 
 	// Log player scores
-	for (auto player_score : scores) {
+	for (auto player_score : snapshot.scores) {
 		game_state->add_scores(player_score);
 	}
 
-	// Log instruction counts and reset temp counts to 0
-	for (auto &inst_count : instruction_counts) {
+	// Log instruction counts
+	for (auto inst_count : snapshot.instruction_counts) {
 		game_state->add_instruction_counts(inst_count);
-		inst_count = 0;
 	}
 
-	// Log the errors, clear the error vectors
-	for (auto &player_errors : errors) {
-		auto player_error_struct = game_state->add_player_errors();
-		for (auto error_code : player_errors) {
-			player_error_struct->add_errors(error_code);
+	// Log the errors, which are only counted when streaming
+	if (stream != nullptr) {
+		EncodeErrorCounts(snapshot.error_counts, error_record);
+	} else {
+		for (auto const &player_error_counts : snapshot.error_counts) {
+			AddErrors(player_error_counts, *game_state->add_player_errors());
 		}
-		player_errors.clear();
 	}
-}
 
-void Logger::LogInstructionCount(PlayerId player_id, int64_t count) {
-	this->instruction_counts[(int)player_id] = count;
+	UpdateLogBytes();
 }
 
-void Logger::LogError(state::PlayerId player_id, ErrorType error_type,
-                      std::string message) {
-	int64_t error_code;
+void Logger::LogUnits(const StateSnapshot &snapshot,
+                      proto::GameState *game_state) {
+	for (auto const &soldier : snapshot.soldiers) {
+		proto::Soldier *t_soldier = game_state->add_soldiers();
+		t_soldier->set_id(soldier.id);
+		t_soldier->set_player_id(soldier.player_id);
+		t_soldier->set_hp(soldier.hp);
+		t_soldier->set_x(soldier.x);
+		t_soldier->set_y(soldier.y);
+		t_soldier->set_state(GetProtoSoldierState(soldier.state));
+		t_soldier->set_target_x(soldier.target_x);
+		t_soldier->set_target_y(soldier.target_y);
+	}
 
-	// Encode the message as "ERROR_TYPE: <message_string>"
-	std::string full_message = ErrorTypeName[(int)error_type] + ": " + message;
+	for (auto const &villager : snapshot.villagers) {
+		proto::Villager *t_villager = game_state->add_villagers();
+		t_villager->set_id(villager.id);
+		t_villager->set_player_id(villager.player_id);
+		t_villager->set_hp(villager.hp);
+		t_villager->set_x(villager.x);
+		t_villager->set_y(villager.y);
+		t_villager->set_state(GetProtoVillagerState(villager.state));
+		t_villager->set_target_x(villager.target_x);
+		t_villager->set_target_y(villager.target_y);
+	}
+}
 
-	// If the message doesn't exist in the map, add an entry in the map and
-	// increment the counter
-	if (error_map.find(full_message) == error_map.end()) {
-		error_code = current_error_code++;
-		error_map[full_message] = error_code;
-	} else {
-		error_code = error_map[full_message];
+void Logger::LogUnitDeltas(const StateSnapshot &snapshot) {
+	unit_records.clear();
+	for (auto const &soldier : snapshot.soldiers) {
+		unit_records.push_back({soldier.id, soldier.player_id, soldier.hp,
+		                        soldier.x, soldier.y,
+		                        GetProtoSoldierState(soldier.state),
+		                        soldier.target_x, soldier.target_y});
 	}
+	soldier_encoder.Encode(unit_records, unit_deltas);
+
+	unit_records.clear();
+	for (auto const &villager : snapshot.villagers) {
+		unit_records.push_back({villager.id, villager.player_id, villager.hp,
+		                        villager.x, villager.y,
+		                        GetProtoVillagerState(villager.state),
+		                        villager.target_x, villager.target_y});
+	}
+	villager_encoder.Encode(unit_records, unit_deltas);
+}
 
-	errors[(int)player_id].push_back(error_code);
+void Logger::LogInstructionCount(PlayerId player_id, int64_t count) {
+	this->instruction_counts[(int)player_id] = count;
+}
+
+void Logger::LogError(state::PlayerId player_id, ErrorMessage message) {
+	// The message is the error code, and the error map has its text
+	++error_counts[(int)player_id][(size_t)message];
+}
+
+void Logger::LogTurnProfile(const TurnProfile &turn_profile) {
+	profile_record.clear();
+	EncodeTurnProfile(turn_profile, profile_record);
 }
 
 void Logger::LogFinalGameParams(PlayerId player_id, bool was_deathmatch,
                                 std::array<int64_t, 2> final_scores) {
-	// Write the error mapping to logs
-	// Flip the mapping, int error_code -> string message
-	for (auto element : error_map) {
-		(*logs->mutable_error_map())[element.second] = element.first;
-	}
-
 	// Write the winner and game type
 	logs->set_was_deathmatch(was_deathmatch);
 	switch (player_id) {
@@ -428,6 +557,40 @@ void Logger::LogFinalGameParams(PlayerId player_id, bool was_deathmatch,
 }
 
 void Logger::WriteGame(std::ostream &write_stream) {
-	logs->SerializeToOstream(&write_stream);
+	if (stream == nullptr) {
+		// proto::Game has nowhere to put the profile, so it goes after the
+		// game as a field that the game's readers skip
+		logs->SerializeToOstream(&write_stream);
+		if (!profile_record.empty()) {
+			WriteTurnProfileField(profile_record, write_stream);
+		}
+		return;
+	}
+
+	// Only the last frame and the final game params are left to write
+	FlushStates();
+	if (!profile_record.empty()) {
+		WriteGameLogRecord(*stream, GameLogRecordType::PROFILE,
+		                   profile_record);
+	}
+	WriteGameLogRecord(*stream, GameLogRecordType::TRAILER, *logs,
+	                   record_buffer);
+	stream->flush();
+}
+
+int64_t Logger::GetLogBytes() const { return log_bytes; }
+
+void Logger::UpdateLogBytes() {
+	// Messages on the arena are only freed with it, so what it has used is
+	// what the log holds, along with the buffers kept for streaming
+	auto bytes = static_cast<int64_t>(
+	    arena.SpaceUsed() + record_buffer.capacity() + unit_deltas.capacity() +
+	    error_record.capacity() + profile_record.capacity() +
+	    unit_records.capacity() * sizeof(UnitRecord));
+	for (auto const &player_factory_logs : factory_logs) {
+		bytes += player_factory_logs.capacity() * sizeof(FactoryLogEntry);
+	}
+	bytes += GetSnapshotBytes(snapshot);
+	log_bytes = bytes;
 }
 } // namespace logger
@@ -0,0 +1,203 @@
+/**
+ * @file turn_profile.cpp
+ * Defines the encoding of the time a game spent in each phase of its turns
+ */
+
+#include "logger/turn_profile.h"
+#include "logger/game_log_stream.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <limits>
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::IstreamInputStream;
+using google::protobuf::io::OstreamOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+namespace logger {
+
+namespace {
+
+const int MAX_VARINT_BYTES = 10;
+
+/**
+ * Longest phase name, past which a name is taken to be malformed
+ */
+const uint64_t MAX_PHASE_NAME_LENGTH = 256;
+
+void AppendVarint(uint64_t value, std::string &output) {
+	uint8_t buffer[MAX_VARINT_BYTES];
+	auto *end = CodedOutputStream::WriteVarint64ToArray(value, buffer);
+	output.append(reinterpret_cast<char *>(buffer), end - buffer);
+}
+
+bool ReadVarint(CodedInputStream &input, int64_t &value) {
+	uint64_t unsigned_value;
+	if (!input.ReadVarint64(&unsigned_value)) {
+		return false;
+	}
+	value = (int64_t)unsigned_value;
+	return true;
+}
+
+/**
+ * Reads the turn profile out of the extra field of a whole game log
+ */
+bool ReadWholeLogTurnProfile(std::istream &read_stream,
+                             TurnProfile &turn_profile) {
+	IstreamInputStream raw_input(&read_stream);
+	CodedInputStream input(&raw_input);
+	input.SetTotalBytesLimit(std::numeric_limits<int>::max());
+
+	// The profile is appended after the game, so every field before it is
+	// skipped
+	while (auto tag = input.ReadTag()) {
+		if (WireFormatLite::GetTagFieldNumber(tag) !=
+		        TURN_PROFILE_FIELD_NUMBER ||
+		    WireFormatLite::GetTagWireType(tag) !=
+		        WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+			if (!WireFormatLite::SkipField(&input, tag)) {
+				return false;
+			}
+			continue;
+		}
+
+		uint32_t length;
+		std::string profile;
+		return input.ReadVarint32(&length) &&
+		       input.ReadString(&profile, (int)length) &&
+		       DecodeTurnProfile(profile, turn_profile);
+	}
+	return false;
+}
+} // namespace
+
+void EncodeTurnProfile(const TurnProfile &turn_profile, std::string &output) {
+	AppendVarint(turn_profile.size(), output);
+	for (auto const &phase_latencies : turn_profile) {
+		AppendVarint(phase_latencies.phase.size(), output);
+		output.append(phase_latencies.phase);
+		AppendVarint(phase_latencies.count, output);
+		AppendVarint(phase_latencies.p50_ns, output);
+		AppendVarint(phase_latencies.p99_ns, output);
+		AppendVarint(phase_latencies.max_ns, output);
+		AppendVarint(phase_latencies.has_counters, output);
+		if (phase_latencies.has_counters) {
+			auto const &counters = phase_latencies.counters;
+			AppendVarint(counters.instructions, output);
+			AppendVarint(counters.cycles, output);
+			AppendVarint(counters.cache_misses, output);
+			AppendVarint(counters.branch_misses, output);
+		}
+	}
+}
+
+bool DecodeTurnProfile(const std::string &input, TurnProfile &turn_profile) {
+	auto data = reinterpret_cast<const uint8_t *>(input.data());
+	CodedInputStream coded_input(data, (int)input.size());
+	turn_profile.clear();
+
+	uint64_t num_phases;
+	if (!coded_input.ReadVarint64(&num_phases)) {
+		return false;
+	}
+	for (uint64_t i = 0; i < num_phases; ++i) {
+		auto phase_latencies = PhaseLatencies{};
+		uint64_t name_length;
+		if (!coded_input.ReadVarint64(&name_length) ||
+		    name_length > MAX_PHASE_NAME_LENGTH ||
+		    !coded_input.ReadString(&phase_latencies.phase,
+		                            (int)name_length) ||
+		    !ReadVarint(coded_input, phase_latencies.count) ||
+		    !ReadVarint(coded_input, phase_latencies.p50_ns) ||
+		    !ReadVarint(coded_input, phase_latencies.p99_ns) ||
+		    !ReadVarint(coded_input, phase_latencies.max_ns)) {
+			return false;
+		}
+
+		uint64_t has_counters;
+		if (!coded_input.ReadVarint64(&has_counters) || has_counters > 1) {
+			return false;
+		}
+		phase_latencies.has_counters = has_counters;
+		auto &counters = phase_latencies.counters;
+		if (has_counters &&
+		    (!ReadVarint(coded_input, counters.instructions) ||
+		     !ReadVarint(coded_input, counters.cycles) ||
+		     !ReadVarint(coded_input, counters.cache_misses) ||
+		     !ReadVarint(coded_input, counters.branch_misses))) {
+			return false;
+		}
+		turn_profile.push_back(phase_latencies);
+	}
+	return coded_input.CurrentPosition() == (int)input.size();
+}
+
+void WriteTurnProfileField(const std::string &profile,
+                           std::ostream &write_stream) {
+	OstreamOutputStream raw_output(&write_stream);
+	CodedOutputStream output(&raw_output);
+	output.WriteTag(WireFormatLite::MakeTag(
+	    TURN_PROFILE_FIELD_NUMBER, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+	output.WriteVarint32((uint32_t)profile.size());
+	output.WriteString(profile);
+}
+
+bool ReadTurnProfile(std::istream &read_stream, TurnProfile &turn_profile) {
+	turn_profile.clear();
+
+	// Anything without the magic is taken to be a whole log
+	auto start = read_stream.tellg();
+	std::string magic(GAME_LOG_STREAM_MAGIC.size(), '\0');
+	read_stream.read(&magic[0], magic.size());
+	if (!read_stream || magic != GAME_LOG_STREAM_MAGIC) {
+		read_stream.clear();
+		if (start == std::istream::pos_type(-1) ||
+		    !read_stream.seekg(start)) {
+			return false;
+		}
+		return ReadWholeLogTurnProfile(read_stream, turn_profile);
+	}
+
+	IstreamInputStream raw_input(&read_stream);
+	CodedInputStream input(&raw_input);
+	input.SetTotalBytesLimit(std::numeric_limits<int>::max());
+
+	// The profile is near the end, so every record before it is skipped
+	uint8_t type;
+	while (input.ReadRaw(&type, sizeof(type))) {
+		uint32_t length;
+		if (!input.ReadVarint32(&length)) {
+			return false;
+		}
+		if ((GameLogRecordType)type != GameLogRecordType::PROFILE) {
+			if (!input.Skip((int)length)) {
+				return false;
+			}
+			continue;
+		}
+
+		std::string record;
+		return input.ReadString(&record, (int)length) &&
+		       DecodeTurnProfile(record, turn_profile);
+	}
+	return false;
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const PhaseLatencies &phase_latencies) {
+	os << phase_latencies.phase << " " << phase_latencies.count << " "
+	   << phase_latencies.p50_ns << " " << phase_latencies.p99_ns << " "
+	   << phase_latencies.max_ns;
+	if (phase_latencies.has_counters) {
+		auto const &counters = phase_latencies.counters;
+		os << " " << counters.instructions << " " << counters.cycles << " "
+		   << counters.cache_misses << " " << counters.branch_misses;
+	}
+	return os;
+}
+} // namespace logger
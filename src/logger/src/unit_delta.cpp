@@ -0,0 +1,276 @@
+/**
+ * @file unit_delta.cpp
+ * Defines the encoder and decoder for units as changes between turns
+ */
+
+#include "logger/unit_delta.h"
+
+#include <google/protobuf/wire_format_lite.h>
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+namespace logger {
+
+namespace {
+
+/**
+ * Kinds of operations, kept in the low bits of each operation's first varint
+ */
+enum UnitDeltaOp : uint64_t { KEEP = 0, UPDATE = 1, REMOVE = 2, INSERT = 3 };
+
+const int UNIT_DELTA_OP_BITS = 2;
+
+const int MAX_VARINT_BYTES = 10;
+
+/**
+ * Fields that can change from turn to turn, in the order of the update mask
+ */
+int64_t UnitRecord::*const UPDATABLE_FIELDS[] = {
+    &UnitRecord::player_id, &UnitRecord::hp,    &UnitRecord::x,
+    &UnitRecord::y,         &UnitRecord::state, &UnitRecord::target_x,
+    &UnitRecord::target_y};
+
+const size_t NUM_UPDATABLE_FIELDS =
+    sizeof(UPDATABLE_FIELDS) / sizeof(UPDATABLE_FIELDS[0]);
+
+void AppendVarint(uint64_t value, std::string &output) {
+	uint8_t buffer[MAX_VARINT_BYTES];
+	auto *end = CodedOutputStream::WriteVarint64ToArray(value, buffer);
+	output.append(reinterpret_cast<char *>(buffer), end - buffer);
+}
+
+void AppendSigned(int64_t value, std::string &output) {
+	AppendVarint(WireFormatLite::ZigZagEncode64(value), output);
+}
+
+void AppendOp(UnitDeltaOp op, uint64_t count, std::string &output) {
+	AppendVarint(count << UNIT_DELTA_OP_BITS | op, output);
+}
+
+bool ReadSigned(CodedInputStream &input, int64_t &value) {
+	uint64_t encoded;
+	if (!input.ReadVarint64(&encoded)) {
+		return false;
+	}
+	value = WireFormatLite::ZigZagDecode64(encoded);
+	return true;
+}
+
+/**
+ * Appends a KEEP for the units counted so far, if there are any
+ */
+void FlushKeep(uint64_t &num_kept, std::string &output) {
+	if (num_kept > 0) {
+		AppendOp(KEEP, num_kept, output);
+		num_kept = 0;
+	}
+}
+} // namespace
+
+void UnitDeltaEncoder::Encode(const std::vector<UnitRecord> &units,
+                              std::string &output) {
+	size_t previous = 0;
+	uint64_t num_kept = 0;
+	bool has_positions = false;
+
+	for (auto const &unit : units) {
+		// Units are normally in the same order as last turn, with some gone
+		// and new ones at the end. If this one isn't next, skip over units
+		// to get to it if it's further on, or insert it if it isn't there.
+		if (previous >= previous_units.size() ||
+		    previous_units[previous].id != unit.id) {
+			if (!has_positions) {
+				previous_positions.clear();
+				for (size_t i = 0; i < previous_units.size(); ++i) {
+					previous_positions[previous_units[i].id] = i;
+				}
+				has_positions = true;
+			}
+
+			auto position = previous_positions.find(unit.id);
+			if (position == previous_positions.end() ||
+			    position->second < previous) {
+				FlushKeep(num_kept, output);
+				AppendOp(INSERT, 0, output);
+				AppendSigned(unit.id, output);
+				for (auto field : UPDATABLE_FIELDS) {
+					AppendSigned(unit.*field, output);
+				}
+				continue;
+			}
+
+			FlushKeep(num_kept, output);
+			AppendOp(REMOVE, position->second - previous, output);
+			previous = position->second;
+		}
+
+		auto const &previous_unit = previous_units[previous++];
+		uint64_t mask = 0;
+		for (size_t i = 0; i < NUM_UPDATABLE_FIELDS; ++i) {
+			auto field = UPDATABLE_FIELDS[i];
+			if (unit.*field != previous_unit.*field) {
+				mask |= uint64_t{1} << i;
+			}
+		}
+
+		if (mask == 0) {
+			++num_kept;
+			continue;
+		}
+
+		FlushKeep(num_kept, output);
+		AppendOp(UPDATE, mask, output);
+		for (size_t i = 0; i < NUM_UPDATABLE_FIELDS; ++i) {
+			if (mask & uint64_t{1} << i) {
+				auto field = UPDATABLE_FIELDS[i];
+				AppendSigned(unit.*field - previous_unit.*field, output);
+			}
+		}
+	}
+
+	// Units kept at the end don't need a KEEP, as the turn ends right after
+	if (previous < previous_units.size()) {
+		FlushKeep(num_kept, output);
+		AppendOp(REMOVE, previous_units.size() - previous, output);
+	}
+	AppendOp(KEEP, 0, output);
+
+	previous_units = units;
+}
+
+bool UnitDeltaDecoder::Decode(CodedInputStream &input,
+                              std::vector<UnitRecord> &units) {
+	units.clear();
+	size_t previous = 0;
+
+	while (true) {
+		uint64_t header;
+		if (!input.ReadVarint64(&header)) {
+			return false;
+		}
+		auto op = header & ((1 << UNIT_DELTA_OP_BITS) - 1);
+		auto count = header >> UNIT_DELTA_OP_BITS;
+
+		if (op == KEEP && count == 0) {
+			break;
+		}
+
+		switch (op) {
+		case KEEP:
+		case REMOVE:
+			if (count > previous_units.size() - previous) {
+				return false;
+			}
+			if (op == KEEP) {
+				units.insert(units.end(), previous_units.begin() + previous,
+				             previous_units.begin() + previous + count);
+			}
+			previous += count;
+			break;
+		case UPDATE: {
+			if (previous >= previous_units.size()) {
+				return false;
+			}
+			auto unit = previous_units[previous++];
+			for (size_t i = 0; i < NUM_UPDATABLE_FIELDS; ++i) {
+				int64_t difference = 0;
+				if ((count & uint64_t{1} << i) &&
+				    !ReadSigned(input, difference)) {
+					return false;
+				}
+				unit.*UPDATABLE_FIELDS[i] += difference;
+			}
+			units.push_back(unit);
+			break;
+		}
+		case INSERT: {
+			UnitRecord unit;
+			if (!ReadSigned(input, unit.id)) {
+				return false;
+			}
+			for (auto field : UPDATABLE_FIELDS) {
+				if (!ReadSigned(input, unit.*field)) {
+					return false;
+				}
+			}
+			units.push_back(unit);
+			break;
+		}
+		}
+	}
+
+	// Whatever wasn't removed is kept
+	units.insert(units.end(), previous_units.begin() + previous,
+	             previous_units.end());
+	previous_units = units;
+	return true;
+}
+
+bool DecodeUnits(CodedInputStream &input, UnitDeltaDecoder &soldier_decoder,
+                 UnitDeltaDecoder &villager_decoder,
+                 proto::GameState &game_state) {
+	std::vector<UnitRecord> units;
+	if (!soldier_decoder.Decode(input, units)) {
+		return false;
+	}
+	AddSoldiers(units, game_state);
+
+	if (!villager_decoder.Decode(input, units)) {
+		return false;
+	}
+	AddVillagers(units, game_state);
+	return true;
+}
+
+void GetSoldierRecords(const proto::GameState &game_state,
+                       std::vector<UnitRecord> &units) {
+	units.clear();
+	for (auto const &soldier : game_state.soldiers()) {
+		units.push_back({soldier.id(), soldier.player_id(), soldier.hp(),
+		                 soldier.x(), soldier.y(), soldier.state(),
+		                 soldier.target_x(), soldier.target_y()});
+	}
+}
+
+void GetVillagerRecords(const proto::GameState &game_state,
+                        std::vector<UnitRecord> &units) {
+	units.clear();
+	for (auto const &villager : game_state.villagers()) {
+		units.push_back({villager.id(), villager.player_id(), villager.hp(),
+		                 villager.x(), villager.y(), villager.state(),
+		                 villager.target_x(), villager.target_y()});
+	}
+}
+
+void AddSoldiers(const std::vector<UnitRecord> &units,
+                 proto::GameState &game_state) {
+	for (auto const &unit : units) {
+		auto *soldier = game_state.add_soldiers();
+		soldier->set_id(unit.id);
+		soldier->set_player_id(unit.player_id);
+		soldier->set_hp(unit.hp);
+		soldier->set_x(unit.x);
+		soldier->set_y(unit.y);
+		soldier->set_state((proto::SoldierState)unit.state);
+		soldier->set_target_x(unit.target_x);
+		soldier->set_target_y(unit.target_y);
+	}
+}
+
+void AddVillagers(const std::vector<UnitRecord> &units,
+                  proto::GameState &game_state) {
+	for (auto const &unit : units) {
+		auto *villager = game_state.add_villagers();
+		villager->set_id(unit.id);
+		villager->set_player_id(unit.player_id);
+		villager->set_hp(unit.hp);
+		villager->set_x(unit.x);
+		villager->set_y(unit.y);
+		villager->set_state((proto::VillagerState)unit.state);
+		villager->set_target_x(unit.target_x);
+		villager->set_target_y(unit.target_y);
+	}
+}
+} // namespace logger
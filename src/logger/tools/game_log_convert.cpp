@@ -0,0 +1,47 @@
+/**
+ * @file game_log_convert.cpp
+ * Converts game logs between the whole, streamed and container formats
+ */
+
+#include "logger/game_log_container.h"
+#include "logger/game_log_stream.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace logger;
+
+int main(int argc, char *argv[]) {
+	// With --whole, write the whole format instead of a container
+	auto is_whole = argc == 4 && string(argv[1]) == "--whole";
+	if (argc != 3 && !is_whole) {
+		cerr << "Usage: " << argv[0] << " [--whole] <input_log> <output_log>\n";
+		return EXIT_FAILURE;
+	}
+	auto input_file_name = argv[argc - 2];
+	auto output_file_name = argv[argc - 1];
+
+	ifstream input_file(input_file_name, ios::in | ios::binary);
+	auto game = proto::Game{};
+	if (!input_file || !ReadGameLog(input_file, game)) {
+		cerr << "Error! Could not read game log " << input_file_name << '\n';
+		return EXIT_FAILURE;
+	}
+
+	ofstream output_file(output_file_name,
+	                     ios::out | ios::binary | ios::trunc);
+	if (is_whole) {
+		game.SerializeToOstream(&output_file);
+	} else {
+		WriteGameLogContainer(game, output_file);
+	}
+
+	if (!output_file) {
+		cerr << "Error! Could not write game log " << output_file_name << '\n';
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
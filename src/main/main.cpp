@@ -1,8 +1,16 @@
 #include "constants/constants.h"
 #include "drivers/main_driver.h"
+#include "drivers/match_engine.h"
+#include "drivers/perf_counters.h"
+#include "drivers/tracer.h"
 #include "drivers/shared_memory_utils/shared_memory_main.h"
 #include "drivers/timer.h"
 #include "game/game.h"
+#include "game/match_server.h"
+#include "game/player_worker_pool.h"
+#include "game/process_player_launcher.h"
+#include "game/zygote_player_launcher.h"
+#include "logger/async_logger.h"
 #include "logger/logger.h"
 #include "physics/vector.hpp"
 #include "simulator_constants/constants.h"
@@ -11,6 +19,8 @@
 #include "state/actor/soldier.h"
 #include "state/actor/villager.h"
 #include "state/command_giver.h"
+#include "state/command_recorder.h"
+#include "state/command_replayer.h"
 #include "state/map/map.h"
 #include "state/path_planner/path_planner.h"
 #include "state/player_state.h"
@@ -18,11 +28,18 @@
 #include "state/state_syncer.h"
 #include "state/utilities.h"
 
+#include <atomic>
+#include <csignal>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <random>
+#include <sstream>
+#include <stdexcept>
+#include <pthread.h>
+#include <thread>
 
 using namespace std;
 using namespace drivers;
@@ -37,21 +54,48 @@ const auto MAP_FILE_NAME = "map.txt";
 // output scores so that the player cannot directly print a score
 const auto KEY_FILE_NAME = "key.txt";
 
-auto shm_names = vector<string>(2);
+// Executable that the match server and the zygotes run players in
+const auto PLAYER_WORKER_PATH = "./player_worker";
+
+// Player code libraries, which zygotes look up on the library search path
+const auto PLAYER_LIBRARY_NAMES =
+    array<string, 2>{"libplayer_1_code.so", "libplayer_2_code.so"};
+
+// Debug log files of players forked off zygotes, the same ones the player
+// processes write
+const auto PLAYER_DEBUG_LOG_PATHS =
+    array<string, 2>{"./player_1.dlog", "./player_2.dlog"};
+
+// Number of player worker processes the match server keeps warm
+const size_t NUM_PLAYER_WORKERS = 2;
+
+// Debug log files of the players, in a match server job's output directory
+const auto PLAYER_DEBUG_LOG_FILE_NAMES =
+    array<string, 2>{"player_1.dlog", "player_2.dlog"};
+
+/**
+ * Everything derived from a map file, which can be reused for every game on
+ * the same map
+ */
+struct Terrain {
+	vector<vector<TerrainType>> map_elements;
+	shared_ptr<const PathGraph> path_graph;
+
+	// The paths in the form the players look them up in, in each player's
+	// orientation
+	array<shared_ptr<const player_state::PathTables>, 2> path_tables;
+};
+
+string ReadFile(const string &file_name) {
+	auto file = ifstream(file_name, ifstream::in);
+	auto contents = ostringstream{};
+	contents << file.rdbuf();
+	return contents.str();
+}
 
-unique_ptr<Map> BuildMap() {
+Terrain BuildTerrain(const string &map_file_input) {
 	auto map_elements = vector<vector<TerrainType>>{};
 
-	auto map_file = ifstream(MAP_FILE_NAME, ifstream::in);
-
-	// Compute file size
-	map_file.seekg(0, map_file.end);
-	auto map_file_size = map_file.tellg();
-	map_file.seekg(0);
-
-	auto map_file_input = vector<char>(map_file_size, '\0');
-	map_file.read(&map_file_input[0], map_file_size);
-
 	auto map_row = vector<TerrainType>{};
 	for (auto character : map_file_input) {
 		switch (character) {
@@ -69,9 +113,8 @@ unique_ptr<Map> BuildMap() {
 		case '\n':
 			// Ensure that size of the row matches MAP_SIZE
 			if (map_row.size() != MAP_SIZE) {
-				std::cerr << "Bad map file! Match MAP_SIZE " << MAP_SIZE
-				          << '\n';
-				exit(EXIT_FAILURE);
+				throw runtime_error("Bad map file! Match MAP_SIZE " +
+				                    to_string(MAP_SIZE));
 			}
 
 			map_elements.push_back(map_row);
@@ -79,15 +122,24 @@ unique_ptr<Map> BuildMap() {
 			break;
 		}
 	}
-	map_file.close();
 
 	// Ensure that number of rows matches MAP_SIZE
 	if (map_elements.size() != MAP_SIZE) {
-		std::cerr << "Bad map file! Match MAP_SIZE " << MAP_SIZE << '\n';
-		exit(EXIT_FAILURE);
+		throw runtime_error("Bad map file! Match MAP_SIZE " +
+		                    to_string(MAP_SIZE));
 	}
 
-	return make_unique<Map>(map_elements, MAP_SIZE, ELEMENT_SIZE);
+	// Precompute the paths
+	auto map = Map(map_elements, MAP_SIZE, ELEMENT_SIZE);
+	auto path_graph = PathPlanner(&map).GetPathGraph();
+	auto path_tables = array<shared_ptr<const player_state::PathTables>, 2>{};
+	for (int i = 0; i < 2; ++i) {
+		auto player_path_tables = make_shared<player_state::PathTables>();
+		path_graph->FillPathTables(*player_path_tables, i == 1);
+		path_tables[i] = move(player_path_tables);
+	}
+
+	return Terrain{move(map_elements), move(path_graph), move(path_tables)};
 }
 
 unique_ptr<GoldManager> BuildGoldManager() {
@@ -107,8 +159,9 @@ unique_ptr<ScoreManager> BuildScoreManager() {
 	    FACTORY_AGE_REWARDS, GOLD_REWARD_RATIO);
 }
 
-unique_ptr<PathPlanner> BuildPathPlanner(Map *map) {
-	return make_unique<PathPlanner>(map);
+unique_ptr<PathPlanner> BuildPathPlanner(Map *map,
+                                         const Terrain &terrain) {
+	return make_unique<PathPlanner>(map, terrain.path_graph);
 }
 
 unique_ptr<Soldier> BuildSoldier(PlayerId player_id, PathPlanner *path_planner,
@@ -162,11 +215,11 @@ Factory BuildModelFactory(GoldManager *gold_manager,
 	               FACTORY_SOLDIER_FREQUENCY, UnitProductionCallback{});
 }
 
-unique_ptr<State> BuildState() {
+unique_ptr<State> BuildState(const Terrain &terrain) {
 	Actor::SetActorIdIncrement();
 
-	auto map = BuildMap();
-	auto path_planner = BuildPathPlanner(map.get());
+	auto map = make_unique<Map>(terrain.map_elements, MAP_SIZE, ELEMENT_SIZE);
+	auto path_planner = BuildPathPlanner(map.get(), terrain);
 	auto gold_manager = BuildGoldManager();
 	auto score_manager = BuildScoreManager();
 
@@ -199,28 +252,109 @@ unique_ptr<State> BuildState() {
 	    move(model_soldier), move(model_factory), INTEREST_THRESHOLD);
 }
 
-unique_ptr<MainDriver> BuildMainDriver() {
-	auto state = BuildState();
-	auto logger =
+// Names the shared memory segments of a game. Every game gets names of its
+// own, so that games can run side by side.
+array<string, 2> GenerateShmNames() {
+	auto shm_names = array<string, 2>{};
+	for (int i = 0; i < 2; ++i) {
+		shm_names[i] = Game::GenerateRandomString(64) + to_string(i);
+	}
+	return shm_names;
+}
+
+unique_ptr<MainDriver> BuildMainDriver(const Terrain &terrain,
+                                       const array<string, 2> &shm_names,
+                                       const string &log_file_name,
+                                       const string &command_log_file_name) {
+	auto state = BuildState(terrain);
+	auto state_logger =
 	    make_unique<Logger>(state.get(), PLAYER_INSTRUCTION_LIMIT_TURN,
 	                        PLAYER_INSTRUCTION_LIMIT_GAME, SOLDIER_MAX_HP,
-	                        VILLAGER_MAX_HP, FACTORY_MAX_HP);
+	                        VILLAGER_MAX_HP, FACTORY_MAX_HP, STREAM_GAME_LOG);
+	auto logger = unique_ptr<ILogger>{};
+	if (LOG_ASYNCHRONOUSLY) {
+		logger =
+		    make_unique<AsyncLogger>(move(state_logger), LOG_BUFFER_TURNS);
+	} else {
+		logger = move(state_logger);
+	}
+
+	// Commands pass through the recorder on their way to the state, if the
+	// command log is being recorded
+	auto command_taker = unique_ptr<ICommandTaker>{move(state)};
+	if (RECORD_COMMAND_LOG) {
+		command_taker = make_unique<CommandRecorder>(
+		    move(command_taker),
+		    make_unique<ofstream>(command_log_file_name,
+		                          ios::out | ios::binary | ios::trunc),
+		    COMMAND_LOG_HASH_INTERVAL_TURNS);
+	}
 
-	auto command_giver = make_unique<CommandGiver>(state.get(), logger.get());
-	auto state_syncer = make_unique<StateSyncer>(move(command_giver),
-	                                             move(state), logger.get());
+	auto command_giver =
+	    make_unique<CommandGiver>(command_taker.get(), logger.get());
+	auto state_syncer = make_unique<StateSyncer>(
+	    move(command_giver), move(command_taker), logger.get());
 
 	vector<unique_ptr<SharedMemoryMain>> shm_mains;
 	for (int i = 0; i < 2; ++i) {
-		shm_names[i] = Game::GenerateRandomString(64) + to_string(i);
 		shm_mains.push_back(make_unique<SharedMemoryMain>(
-		    shm_names[i], false, false, 0, transfer_state::State()));
+		    shm_names[i], false, false, 0, transfer_state::State(),
+		    terrain.path_tables[i].get()));
 	}
 
 	return make_unique<MainDriver>(
 	    move(state_syncer), move(shm_mains), PLAYER_INSTRUCTION_LIMIT_TURN,
 	    PLAYER_INSTRUCTION_LIMIT_GAME, NUM_TURNS,
-	    Timer::Interval(GAME_DURATION_MS), move(logger), GAME_LOG_FILE_NAME);
+	    Timer::Interval(GAME_DURATION_MS), Timer::Interval(TURN_DURATION_MS),
+	    move(logger), log_file_name, RUN_PLAYERS_CONCURRENTLY,
+	    COUNT_PERF_EVENTS);
+}
+
+// Games go on without hardware event counts if the kernel won't give them,
+// but say so up front
+void WarnIfPerfEventsUncounted() {
+	if (COUNT_PERF_EVENTS && not PerfCounters::GetThreadCounters().IsOpen()) {
+		cerr << "Warning! Could not count hardware events. Turn profiles "
+		        "will only have times.\n"
+		     << "Check kernel.perf_event_paranoid and that the CPU's counters "
+		        "are exposed, or turn COUNT_PERF_EVENTS off\n";
+	}
+}
+
+// Signal a running game prints its memory report on
+const int MEMORY_REPORT_SIGNAL = SIGUSR1;
+
+void PrintMemoryReport(ostream &os, const Game &game,
+                       const string &prefix_key) {
+	for (auto const &memory : game.GetMemoryReport()) {
+		os << prefix_key << " MEMORY " << memory << '\n';
+	}
+	os.flush();
+}
+
+// Blocks the memory report signal in the calling thread, and in the threads
+// it starts from then on, so that only the reporter takes it
+void BlockMemoryReportSignal() {
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, MEMORY_REPORT_SIGNAL);
+	pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+}
+
+// Prints the game's memory report each time the process gets the memory
+// report signal, until is_stopping is set and the signal is sent to the
+// reporter once more
+thread StartMemoryReporter(const Game &game, const string &prefix_key,
+                           const atomic_bool &is_stopping) {
+	return thread([&game, &prefix_key, &is_stopping] {
+		sigset_t signals;
+		sigemptyset(&signals);
+		sigaddset(&signals, MEMORY_REPORT_SIGNAL);
+		int signal_number;
+		while (sigwait(&signals, &signal_number) == 0 && not is_stopping) {
+			PrintMemoryReport(cerr, game, prefix_key);
+		}
+	});
 }
 
 string GetKeyFromFile() {
@@ -235,13 +369,173 @@ bool FileExists(const std::string &name) {
 	return f.good();
 }
 
-void WriteToFile(string file_name, string content) {
-	ofstream file(file_name, ofstream::out);
-	file << content;
-	file.close();
+// Starts a match server job, which is a line with the map file, the security
+// key, the two players' code libraries and an output directory for the game
+// and debug logs. The reply is the key and results, like the output of a
+// single game, sent once the game is over, or an error message.
+void RunJob(const string &job, const MatchServer::Reply &reply,
+            PlayerWorkerPool &player_worker_pool,
+            map<string, Terrain> &terrain_cache, MatchEngine &match_engine) {
+	auto job_stream = istringstream(job);
+	auto map_file_name = string{}, prefix_key = string{};
+	auto library_paths = array<string, 2>{};
+	auto output_dir = string{};
+	if (not(job_stream >> map_file_name >> prefix_key >> library_paths[0] >>
+	        library_paths[1] >> output_dir)) {
+		reply("Error! Bad job: " + job);
+		return;
+	}
+	if (not FileExists(map_file_name)) {
+		reply("Error! Could not open map file " + map_file_name);
+		return;
+	}
+
+	// Look the terrain up by map contents, so that edited maps are rebuilt
+	auto map_file_input = ReadFile(map_file_name);
+	auto terrain = terrain_cache.find(map_file_input);
+	if (terrain == terrain_cache.end()) {
+		try {
+			terrain = terrain_cache
+			              .emplace(map_file_input, BuildTerrain(map_file_input))
+			              .first;
+		} catch (const runtime_error &e) {
+			reply(string("Error! ") + e.what());
+			return;
+		}
+	}
+
+	auto shm_names = GenerateShmNames();
+	auto driver = BuildMainDriver(terrain->second, shm_names,
+	                              output_dir + "/" + GAME_LOG_FILE_NAME,
+	                              output_dir + "/" + COMMAND_LOG_FILE_NAME);
+	auto player_launcher = player_worker_pool.GetLauncher(
+	    library_paths, {output_dir + "/" + PLAYER_DEBUG_LOG_FILE_NAMES[0],
+	                    output_dir + "/" + PLAYER_DEBUG_LOG_FILE_NAMES[1]});
+	auto game = make_shared<Game>(move(driver), shm_names,
+	                              move(player_launcher), &match_engine);
+
+	// The game is kept alive by its own callback, and goes away with it
+	game->Start([game, prefix_key, reply](const GameResult &results) {
+		if (PRINT_MEMORY_REPORT) {
+			auto memory_report = ostringstream{};
+			PrintMemoryReport(memory_report, *game, prefix_key);
+			cout << memory_report.str() << flush;
+		}
+
+		auto results_line = ostringstream{};
+		results_line << prefix_key << " " << results;
+		reply(results_line.str());
+	});
+}
+
+// Serves match jobs on the socket until killed
+int RunMatchServer(const string &socket_path) {
+	// Workers can die with jobs still being written to them, which shows up
+	// as a write error instead
+	signal(SIGPIPE, SIG_IGN);
+
+	WarnIfPerfEventsUncounted();
+
+	PlayerWorkerPool player_worker_pool(PLAYER_WORKER_PATH, NUM_PLAYER_WORKERS);
+	auto terrain_cache = map<string, Terrain>{};
+
+	// All the games are driven from a single engine thread
+	MatchEngine match_engine;
+	thread engine_runner([&match_engine] { match_engine.Run(); });
+
+	// Jobs are started one at a time on the server's thread, and replied to
+	// from the thread that finishes their game
+	MatchServer server(socket_path, [&](const string &job,
+	                                    MatchServer::Reply reply) {
+		RunJob(job, reply, player_worker_pool, terrain_cache, match_engine);
+	});
+
+	cout << "Serving matches on " << socket_path << "..." << endl;
+	server.Run();
+
+	match_engine.Stop();
+	engine_runner.join();
+
+	return 0;
+}
+
+// Simulates a game again from its command log, on the map in the map file,
+// and writes the game log for it. The log has the same frames as the game's,
+// less the instruction counts and errors, which aren't recorded.
+int ReplayGame(const string &command_log_file_name,
+               const string &log_file_name) {
+	if (not FileExists(MAP_FILE_NAME)) {
+		cerr << "Error! Could not open map file " << MAP_FILE_NAME << '\n';
+		return EXIT_FAILURE;
+	}
+	auto terrain = Terrain{};
+	try {
+		terrain = BuildTerrain(ReadFile(MAP_FILE_NAME));
+	} catch (const runtime_error &e) {
+		cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	auto command_log = ifstream(command_log_file_name, ios::in | ios::binary);
+	auto state = BuildState(terrain);
+	CommandReplayer replayer(state.get(), command_log);
+	if (not replayer.Open()) {
+		cerr << "Error! Could not read command log " << command_log_file_name
+		     << '\n';
+		return EXIT_FAILURE;
+	}
+
+	Logger logger(state.get(), PLAYER_INSTRUCTION_LIMIT_TURN,
+	              PLAYER_INSTRUCTION_LIMIT_GAME, SOLDIER_MAX_HP,
+	              VILLAGER_MAX_HP, FACTORY_MAX_HP, STREAM_GAME_LOG);
+	auto log_file =
+	    ofstream(log_file_name, ios::out | ios::binary | ios::trunc);
+	logger.BeginGame(log_file);
+	logger.LogState();
+
+	auto status = ReplayStatus::TURN_REPLAYED;
+	while ((status = replayer.ReplayTurn()) == ReplayStatus::TURN_REPLAYED) {
+		logger.LogState();
+	}
+	if (status != ReplayStatus::FINISHED) {
+		cerr << "Error! Replay "
+		     << (status == ReplayStatus::HASH_MISMATCH ? "diverged from"
+		                                               : "could not read")
+		     << " the command log at turn " << replayer.GetTurnNo() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	// End the game like the driver does. A game that ran out of turns is won
+	// by score, and one that stopped early was forfeit or timed out.
+	auto winner = PlayerId::PLAYER1;
+	if (state->IsGameOver(winner)) {
+		logger.LogFinalGameParams(winner, true, state->GetScores(true));
+	} else if (replayer.GetTurnNo() == NUM_TURNS) {
+		auto scores = state->GetScores(true);
+		winner = scores[0] > scores[1]   ? PlayerId::PLAYER1
+		         : scores[0] < scores[1] ? PlayerId::PLAYER2
+		                                 : PlayerId::PLAYER_NULL;
+		logger.LogFinalGameParams(winner, false, scores);
+	} else {
+		logger.LogFinalGameParams(PlayerId::PLAYER1, false, {0, 0});
+	}
+	logger.WriteGame(log_file);
+
+	cout << "Replayed " << replayer.GetTurnNo() << " turns\n";
+	return 0;
 }
 
 int main(int argc, char *argv[]) {
+	// With --serve, run as a match server instead of playing a single game
+	if (argc == 3 && string(argv[1]) == "--serve") {
+		return RunMatchServer(argv[2]);
+	}
+
+	// With --replay, simulate a recorded game again instead
+	if (argc == 4 && string(argv[1]) == "--replay") {
+		return ReplayGame(argv[2], argv[3]);
+	}
+
 	// Check if map file exists
 	if (not FileExists(MAP_FILE_NAME)) {
 		cerr << "Error! Could not open map file " << MAP_FILE_NAME << '\n';
@@ -260,23 +554,71 @@ int main(int argc, char *argv[]) {
 		auto result = remove(KEY_FILE_NAME);
 	}
 
-	// Build main driver
-	auto driver = BuildMainDriver();
+	WarnIfPerfEventsUncounted();
 
-	// Write the SHM names to file, to be read by the player process
-	for (int i = 0; i < 2; ++i) {
-		WriteToFile(SHM_FILE_NAMES[i], shm_names[i]);
+	// Before any threads are started, which would otherwise take the signal
+	// and be killed by it
+	BlockMemoryReportSignal();
+
+	// Start the zygotes first, so that they're warmed up by the time the game
+	// starts
+	auto player_launcher = unique_ptr<IPlayerLauncher>{};
+	if (LAUNCH_PLAYERS_FROM_ZYGOTE) {
+		player_launcher = make_unique<ZygotePlayerLauncher>(
+		    PLAYER_WORKER_PATH, PLAYER_LIBRARY_NAMES, PLAYER_DEBUG_LOG_PATHS);
+	} else {
+		player_launcher = make_unique<ProcessPlayerLauncher>();
+	}
+
+	// Build main driver
+	auto terrain = Terrain{};
+	try {
+		terrain = BuildTerrain(ReadFile(MAP_FILE_NAME));
+	} catch (const runtime_error &e) {
+		cerr << e.what() << '\n';
+		return EXIT_FAILURE;
 	}
+	auto shm_names = GenerateShmNames();
+	auto driver = BuildMainDriver(terrain, shm_names, GAME_LOG_FILE_NAME,
+	                              COMMAND_LOG_FILE_NAME);
 
 	// Build game object
-	auto game = std::make_unique<Game>(move(driver));
+	auto game =
+	    std::make_unique<Game>(move(driver), shm_names, move(player_launcher));
 
 	// Start the game
 	cout << "Starting game...\n";
+	if (TRACE_GAME) {
+		Tracer::GetInstance().Enable("main");
+	}
+	atomic_bool is_reporter_stopping(false);
+	auto memory_reporter =
+	    StartMemoryReporter(*game, prefix_key, is_reporter_stopping);
 	auto results = game->Start();
+	is_reporter_stopping = true;
+	pthread_kill(memory_reporter.native_handle(), MEMORY_REPORT_SIGNAL);
+	memory_reporter.join();
+
+	// The players are done by now, and have written their trace events
+	if (TRACE_GAME) {
+		Tracer::GetInstance().Disable();
+		auto trace_file = ofstream(GAME_TRACE_FILE_NAME);
+		Tracer::GetInstance().WriteTrace(
+		    trace_file,
+		    {PLAYER_DEBUG_LOG_PATHS[0] + PLAYER_TRACE_FILE_EXT,
+		     PLAYER_DEBUG_LOG_PATHS[1] + PLAYER_TRACE_FILE_EXT});
+	}
 
 	// Game has finished
 	cout << prefix_key << " " << results << endl;
+	if (PRINT_TURN_PROFILE) {
+		for (auto const &phase_latencies : game->GetTurnProfile()) {
+			cout << prefix_key << " PROFILE " << phase_latencies << '\n';
+		}
+	}
+	if (PRINT_MEMORY_REPORT) {
+		PrintMemoryReport(cout, *game, prefix_key);
+	}
 
 	return 0;
 }
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "player_code/player_code_export.h"
+#include "player_wrapper/interfaces/i_player_code.h"
+#include "state/player_state.h"
+
+namespace player_code {
+
+/**
+ * Loop heavy player code, instrumented by the naive pass
+ */
+class PLAYER_CODE_EXPORT PlayerCode3 : public player_wrapper::IPlayerCode {
+	/**
+	 * Player AI update function (main logic of the AI)
+	 */
+	player_state::State Update(player_state::State state) override;
+};
+
+/**
+ * Same code as PlayerCode3, instrumented with optimized counts
+ */
+class PLAYER_CODE_EXPORT PlayerCode3Optimized
+    : public player_wrapper::IPlayerCode {
+	/**
+	 * Player AI update function (main logic of the AI)
+	 */
+	player_state::State Update(player_state::State state) override;
+};
+} // namespace player_code
@@ -0,0 +1,5 @@
+#include "player_code/player_code.h"
+
+extern "C" PLAYER_CODE_EXPORT player_wrapper::IPlayerCode *CreatePlayerCode() {
+	return new player_code::PlayerCode();
+}
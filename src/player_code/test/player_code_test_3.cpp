@@ -0,0 +1,43 @@
+#include "player_code/test/player_code_test_3.h"
+#include <vector>
+
+// Built once for each of the classes in the header
+#ifndef PLAYER_CODE_TEST_3
+#define PLAYER_CODE_TEST_3 PlayerCode3
+#endif
+
+namespace player_code {
+
+player_state::State PLAYER_CODE_TEST_3::Update(player_state::State state) {
+	// Trip count only known at run time
+	int64_t sum = 0;
+	for (int64_t i = 0; i < state.gold; ++i) {
+		sum += i * 3;
+	}
+
+	// Nested loops with a constant trip count, and a branch inside
+	int64_t num_land_tiles = 0;
+	for (auto &row : state.map) {
+		for (auto &tile : row) {
+			if (tile == player_state::TerrainType::LAND) {
+				++num_land_tiles;
+			}
+		}
+	}
+
+	// Loop that exits at the bottom
+	int64_t value = state.gold;
+	do {
+		value /= 2;
+	} while (value > 0);
+
+	// Loop with calls inside
+	std::vector<int64_t> values(state.gold % 100 + 1, 1);
+	for (size_t i = 0; i < values.size(); ++i) {
+		values[i] += i;
+	}
+
+	state.score = sum + num_land_tiles + value + values.back();
+	return state;
+}
+} // namespace player_code
@@ -54,3 +54,11 @@ class PLAYER_WRAPPER_EXPORT IPlayerCode {
 	virtual ~IPlayerCode() {}
 };
 } // namespace player_wrapper
+
+/**
+ * Creates the player's code
+ *
+ * Defined by the player code library, so that processes loading the library
+ * at runtime can look it up by name
+ */
+extern "C" player_wrapper::IPlayerCode *CreatePlayerCode();
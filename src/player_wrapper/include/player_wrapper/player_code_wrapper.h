@@ -32,8 +32,14 @@ class PLAYER_WRAPPER_EXPORT PlayerCodeWrapper {
 	/**
 	 * Runs the player's update and returns the player's debug logs
 	 *
+	 * @param      transfer_state  The player's state, which the player's
+	 *                             moves are written back to
+	 * @param[in]  path_tables     Paths of the map for the player to look up,
+	 *                             or null if there are none
+	 *
 	 * @return     The debug logs
 	 */
-	std::string Update(transfer_state::State &transfer_state);
+	std::string Update(transfer_state::State &transfer_state,
+	                   const player_state::PathTables *path_tables = nullptr);
 };
 } // namespace player_wrapper
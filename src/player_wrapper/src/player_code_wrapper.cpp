@@ -11,8 +11,11 @@ namespace player_wrapper {
 PlayerCodeWrapper::PlayerCodeWrapper(std::unique_ptr<IPlayerCode> player_code)
     : player_code(std::move(player_code)) {}
 
-std::string PlayerCodeWrapper::Update(transfer_state::State &transfer_state) {
+std::string
+PlayerCodeWrapper::Update(transfer_state::State &transfer_state,
+                          const player_state::PathTables *path_tables) {
 	auto player_state = transfer_state::ConvertToPlayerState(transfer_state);
+	player_state.path_tables = path_tables;
 	player_state = player_code->Update(player_state);
 	transfer_state = transfer_state::ConvertToTransferState(player_state);
 	return player_code->GetAndClearDebugLogs();
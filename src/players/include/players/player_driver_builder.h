@@ -0,0 +1,46 @@
+/**
+ * @file player_driver_builder.h
+ * Builds the driver that runs a player's code, for the player executables
+ */
+
+#pragma once
+
+#include "constants/constants.h"
+#include "drivers/player_driver.h"
+#include "drivers/shared_memory_utils/shared_memory_player.h"
+#include "drivers/timer.h"
+#include "player_wrapper/interfaces/i_player_code.h"
+#include "player_wrapper/player_code_wrapper.h"
+#include "simulator_constants/constants.h"
+
+#include <memory>
+#include <string>
+
+const std::string player_debug_log_ext = ".dlog";
+const std::string debug_logs_turn_prefix =
+    ">>>>>>>>>>>>>>>>>>>START OF TURN LOG<<<<<<<<<<<<<<<<<<<<\n";
+const std::string debug_logs_truncate_message =
+    "(logs truncated due to excessive size)\n";
+const int64_t max_debug_logs_turn_length = 10000;
+
+inline std::unique_ptr<drivers::PlayerDriver>
+BuildPlayerDriver(std::unique_ptr<player_wrapper::IPlayerCode> player_code,
+                  std::string shm_name, std::string player_debug_log_file) {
+	using namespace drivers;
+	using namespace player_wrapper;
+
+	auto shm_player = std::make_unique<SharedMemoryPlayer>(shm_name);
+
+	auto player_code_wrapper =
+	    std::make_unique<PlayerCodeWrapper>(std::move(player_code));
+
+	// The trace events go next to the debug logs, for the game to collect
+	auto player_trace_file =
+	    TRACE_GAME ? player_debug_log_file + PLAYER_TRACE_FILE_EXT : "";
+
+	return std::make_unique<PlayerDriver>(
+	    std::move(player_code_wrapper), std::move(shm_player), NUM_TURNS,
+	    Timer::Interval(GAME_DURATION_MS), player_debug_log_file,
+	    debug_logs_turn_prefix, debug_logs_truncate_message,
+	    max_debug_logs_turn_length, player_trace_file);
+}
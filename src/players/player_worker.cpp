@@ -0,0 +1,131 @@
+#include "players/player_driver_builder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <exception>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace player_wrapper;
+
+// Name of the function in player code libraries that creates the player code
+const auto PLAYER_CODE_FACTORY_NAME = "CreatePlayerCode";
+
+int RunMatch(std::string shm_name, std::string library_path,
+             std::string debug_log_path) {
+	// Load the player's code afresh, so that nothing is left over from the
+	// previous match
+	auto library = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (library == nullptr) {
+		std::cerr << "Could not load player code: " << dlerror() << '\n';
+		return EXIT_FAILURE;
+	}
+
+	auto create_player_code = reinterpret_cast<decltype(&CreatePlayerCode)>(
+	    dlsym(library, PLAYER_CODE_FACTORY_NAME));
+	if (create_player_code == nullptr) {
+		std::cerr << "Could not find player code: " << dlerror() << '\n';
+		dlclose(library);
+		return EXIT_FAILURE;
+	}
+
+	auto status = EXIT_SUCCESS;
+	try {
+		auto player_code = std::unique_ptr<IPlayerCode>(create_player_code());
+		auto driver = BuildPlayerDriver(std::move(player_code), shm_name,
+		                                debug_log_path);
+		driver->Start();
+	} catch (const std::exception &e) {
+		std::cerr << "Could not run match: " << e.what() << '\n';
+		status = EXIT_FAILURE;
+	}
+
+	dlclose(library);
+	return status;
+}
+
+// Swaps stdin for /dev/null, so that player code can't read the launcher's
+// jobs
+void DetachFromJobs() {
+	auto null_fd = open("/dev/null", O_RDONLY);
+	dup2(null_fd, STDIN_FILENO);
+	close(null_fd);
+}
+
+// Runs every match in a child process of its own, and reports the child's ID
+// as soon as it's forked, and then how it exited
+void RunZygote(FILE *replies) {
+	std::string shm_name, library_path, debug_log_path;
+	while (std::cin >> shm_name >> library_path >> debug_log_path) {
+		auto pid = fork();
+		if (pid == 0) {
+			// The player can't be left able to forge the zygote's replies,
+			// or to read the jobs after its own
+			fclose(replies);
+			DetachFromJobs();
+
+			auto status = RunMatch(shm_name, library_path, debug_log_path);
+			std::cout.flush();
+			fflush(nullptr);
+			_exit(status);
+		}
+
+		fprintf(replies, "%d\n", pid);
+		fflush(replies);
+
+		// Report the exit code, or 128 and the terminating signal if it was
+		// killed, so that a signal can't pass for an exit code the game
+		// treats specially
+		auto status = 0, exit_code = EXIT_FAILURE;
+		if (pid > 0 && waitpid(pid, &status, 0) == pid) {
+			if (WIFEXITED(status)) {
+				exit_code = WEXITSTATUS(status);
+			} else if (WIFSIGNALED(status)) {
+				exit_code = 128 + WTERMSIG(status);
+			}
+		}
+		fprintf(replies, "%d\n", exit_code);
+		fflush(replies);
+	}
+}
+
+// Runs a single match in this process, and exits with its status. A worker
+// is never reused, so nothing the player leaves behind, like threads, exit
+// hooks or a library that won't unload, outlives its match.
+void RunWorker() {
+	std::string shm_name, library_path, debug_log_path;
+	if (!(std::cin >> shm_name >> library_path >> debug_log_path)) {
+		_exit(EXIT_FAILURE);
+	}
+
+	// The player gets nothing from the pool but its job
+	DetachFromJobs();
+
+	auto status = RunMatch(shm_name, library_path, debug_log_path);
+	std::cout.flush();
+	fflush(nullptr);
+	_exit(status);
+}
+
+// Runs a match for the player worker pool, or matches for a zygote launcher
+// when started with --zygote. Every job is a line on stdin, with the SHM
+// name, the player code library and the debug log file. A worker exits with
+// the match's status, while the zygote answers on stdout.
+int main(int argc, char *argv[]) {
+	// Send everything written to stdout, like the player's prints, to stderr.
+	// Only the zygote keeps the original stdout, for its replies.
+	if (argc == 2 && std::string(argv[1]) == "--zygote") {
+		auto replies = fdopen(dup(STDOUT_FILENO), "w");
+		dup2(STDERR_FILENO, STDOUT_FILENO);
+		RunZygote(replies);
+		return 0;
+	}
+
+	dup2(STDERR_FILENO, STDOUT_FILENO);
+	RunWorker();
+}
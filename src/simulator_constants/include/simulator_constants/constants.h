@@ -17,11 +17,71 @@ const int64_t NUM_TURNS = 1000;
 // Duration of the game in milliseconds
 const int64_t GAME_DURATION_MS = 50 * 1000;
 
+// Time a player gets to finish a single turn, in milliseconds. Going past it
+// forfeits the game.
+const int64_t TURN_DURATION_MS = 1000;
+
+// If true, both players run their turns at the same time
+const bool RUN_PLAYERS_CONCURRENTLY = true;
+
+// If true, player processes are forked off a zygote that has the simulator
+// libraries loaded already, instead of being started from scratch
+const bool LAUNCH_PLAYERS_FROM_ZYGOTE = true;
+
+// If true, the game log is written turn by turn in the streamed format, and
+// only the latest turn is kept in memory. Otherwise the whole game is held in
+// memory and written at the end as a single message, which is what the viewer
+// reads.
+const bool STREAM_GAME_LOG = false;
+
+// If true, the game log is built on a thread of its own, from snapshots of the
+// state taken at the end of every turn
+const bool LOG_ASYNCHRONOUSLY = true;
+
+// Number of turns the asynchronous log can fall behind the game by, before the
+// game waits for it
+const int64_t LOG_BUFFER_TURNS = 64;
+
+// If true, the commands the state takes every turn are written to a command
+// log, which the game can be simulated again from with --replay
+const bool RECORD_COMMAND_LOG = false;
+
+// Number of turns between the state hashes in the command log, which a replay
+// is checked against
+const int64_t COMMAND_LOG_HASH_INTERVAL_TURNS = 10;
+
+// If true, how long each phase of the turns took is printed after the result
+// of a single game, a line per phase. The game log always has it.
+const bool PRINT_TURN_PROFILE = false;
+
+// If true, the turn profile also has the instructions, cycles, cache misses and
+// branch misses of each phase, where the kernel lets the simulator count them
+const bool COUNT_PERF_EVENTS = false;
+
+// If true, a single game is traced into a timeline of the main process and
+// the players, which chrome://tracing and Perfetto can open
+const bool TRACE_GAME = false;
+
+// If true, the current and peak memory each subsystem of the game held is
+// printed after the result, a line per subsystem. A running single game prints
+// it to stderr whenever the main process gets SIGUSR1, either way.
+const bool PRINT_MEMORY_REPORT = false;
+
 // File names for passing SHM names to player processes
 const auto SHM_FILE_NAMES = std::array<std::string, 2>{"shm1.txt", "shm2.txt"};
 
 // File where the output game binary log will be stored
 const auto GAME_LOG_FILE_NAME = "game.log";
 
+// File where the command log is stored, if it's recorded
+const auto COMMAND_LOG_FILE_NAME = "game.clog";
+
+// File where the trace of the game is stored, if it's traced
+const auto GAME_TRACE_FILE_NAME = "game.trace.json";
+
+// Extension added to a player's debug log file name for the file the player
+// writes its trace events to, if the game is traced
+const auto PLAYER_TRACE_FILE_EXT = ".trace";
+
 // Interestingness threshold
 const int64_t INTEREST_THRESHOLD = 0;
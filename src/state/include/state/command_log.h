@@ -0,0 +1,142 @@
+/**
+ * @file command_log.h
+ * Declarations for the log of the commands that change the state, which a
+ * game can be simulated again from
+ */
+
+#pragma once
+
+#include "physics/vector.hpp"
+#include "state/interfaces/i_command_taker.h"
+#include "state/state_export.h"
+#include "state/utilities.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace state {
+
+/**
+ * Bytes that a command log starts with
+ */
+const std::string COMMAND_LOG_MAGIC = "CCCMDS01";
+
+/**
+ * The state changing calls of ICommandTaker
+ */
+enum class CommandType {
+	MOVE_UNIT,
+	MINE_LOCATION,
+	ATTACK_ACTOR,
+	CREATE_FACTORY,
+	BUILD_FACTORY,
+	SET_FACTORY_PRODUCTION,
+	STOP_OR_START_FACTORY
+};
+
+/**
+ * A single call to the state, with its arguments
+ */
+struct Command {
+	CommandType type;
+
+	PlayerId player_id;
+
+	/**
+	 * Unit or factory the command is given to
+	 */
+	ActorId actor_id;
+
+	/**
+	 * Actor attacked, or factory built by a villager
+	 */
+	ActorId target_id;
+
+	/**
+	 * Destination, mine location or factory offset
+	 */
+	Vec2D position;
+
+	/**
+	 * Unit type a factory produces
+	 */
+	ActorType actor_type;
+
+	/**
+	 * True if a factory is to stop producing, false if it's to start
+	 */
+	bool should_stop;
+};
+
+/**
+ * The commands given in a turn, and the hash of the state at the end of it
+ */
+struct CommandLogTurn {
+	std::vector<Command> commands;
+
+	/**
+	 * True if the turn has the hash of the state, which is only taken every
+	 * few turns
+	 */
+	bool has_state_hash;
+
+	uint64_t state_hash;
+};
+
+/**
+ * Writes the start of a command log
+ *
+ * @param[in]  write_stream  Stream to write the log to
+ */
+STATE_EXPORT void WriteCommandLogHeader(std::ostream &write_stream);
+
+/**
+ * Reads the start of a command log
+ *
+ * @param[in]  read_stream  Stream to read the log from
+ *
+ * @return     true if the stream holds a command log, false otherwise
+ */
+STATE_EXPORT bool ReadCommandLogHeader(std::istream &read_stream);
+
+/**
+ * Writes the commands of a turn to a command log
+ *
+ * @param[in]  write_stream  Stream to write the log to
+ * @param[in]  turn          The turn to write
+ */
+STATE_EXPORT void WriteCommandLogTurn(std::ostream &write_stream,
+                                      const CommandLogTurn &turn);
+
+/**
+ * Reads the commands of a turn from a command log
+ *
+ * @param[in]   read_stream  Stream to read the log from
+ * @param[out]  turn         The turn read
+ *
+ * @return      true if a turn was read, false if the log is over or
+ *              malformed, which read_stream.eof() tells apart
+ */
+STATE_EXPORT bool ReadCommandLogTurn(std::istream &read_stream,
+                                     CommandLogTurn &turn);
+
+/**
+ * Gives a logged command to the state
+ *
+ * @param[in]  state    State to give the command to
+ * @param[in]  command  The command
+ */
+STATE_EXPORT void ApplyCommand(ICommandTaker *state, const Command &command);
+
+/**
+ * Hashes the actors, gold and scores in the state
+ *
+ * @param[in]  state  The state to hash
+ *
+ * @return     The hash
+ */
+STATE_EXPORT uint64_t HashState(ICommandTaker *state);
+} // namespace state
@@ -0,0 +1,136 @@
+/**
+ * @file command_recorder.h
+ * Declares the CommandRecorder class
+ */
+
+#pragma once
+
+#include "state/command_log.h"
+#include "state/interfaces/i_command_taker.h"
+#include "state/state_export.h"
+
+#include <memory>
+#include <ostream>
+
+namespace state {
+
+/**
+ * Passes calls on to the state, writing the commands it takes to a command
+ * log as it goes
+ *
+ * The state hash is written to the log every few turns, after the update.
+ */
+class STATE_EXPORT CommandRecorder : public ICommandTaker {
+  private:
+	/**
+	 * The state that the calls are passed on to
+	 */
+	std::unique_ptr<ICommandTaker> state;
+
+	/**
+	 * Stream the command log is written to
+	 */
+	std::unique_ptr<std::ostream> log_stream;
+
+	/**
+	 * Number of turns between state hashes
+	 */
+	int64_t hash_interval_turns;
+
+	/**
+	 * Number of turns the state has been updated for
+	 */
+	int64_t turn_no;
+
+	/**
+	 * Commands taken so far this turn
+	 */
+	CommandLogTurn turn;
+
+	/**
+	 * Adds a command to this turn's commands
+	 */
+	void Record(CommandType type, PlayerId player_id, ActorId actor_id);
+
+  public:
+	/**
+	 * Constructor for CommandRecorder
+	 *
+	 * @param[in]  state                The state to pass calls on to
+	 * @param[in]  log_stream           Stream to write the command log to
+	 * @param[in]  hash_interval_turns  Number of turns between state hashes
+	 */
+	CommandRecorder(std::unique_ptr<ICommandTaker> state,
+	                std::unique_ptr<std::ostream> log_stream,
+	                int64_t hash_interval_turns);
+
+	/**
+	 * @see ICommandTaker#MoveUnit
+	 */
+	void MoveUnit(PlayerId player_id, ActorId actor_id,
+	              Vec2D position) override;
+
+	/**
+	 * @see ICommandTaker#MineLocation
+	 */
+	void MineLocation(PlayerId player_id, ActorId villager_id,
+	                  Vec2D mine_location) override;
+
+	/**
+	 * @see ICommandTaker#AttackActor
+	 */
+	void AttackActor(PlayerId player_id, ActorId unit_id,
+	                 ActorId enemy_actor_id) override;
+
+	/**
+	 * @see ICommandTaker#CreateFactory
+	 */
+	void CreateFactory(PlayerId player_id, ActorId villager_id, Vec2D offset,
+	                   ActorType produce_unit) override;
+
+	/**
+	 * @see ICommandTaker#BuildFactory
+	 */
+	void BuildFactory(PlayerId player_id, ActorId villager_id,
+	                  ActorId factory_id) override;
+
+	/**
+	 * @see ICommandTaker#SetFactoryProduction
+	 */
+	void SetFactoryProduction(PlayerId player_id, ActorId factory_id,
+	                          ActorType production) override;
+
+	/**
+	 * @see ICommandTaker#StopOrStartFactory
+	 */
+	void StopOrStartFactory(PlayerId player_id, ActorId factory_id,
+	                        bool should_stop) override;
+
+	/**
+	 * Updates the state, and writes the turn's commands to the log
+	 */
+	void Update() override;
+
+	const std::array<std::vector<Soldier *>, 2> GetSoldiers() override;
+
+	const std::array<std::vector<Villager *>, 2> GetVillagers() override;
+
+	const std::array<std::vector<Factory *>, 2> GetFactories() override;
+
+	const Map *GetMap() override;
+
+	const std::array<int64_t, 2> GetGold() override;
+
+	const std::array<int64_t, 2> GetScores(bool game_over) override;
+
+	int64_t GetInterestingness() override;
+
+	bool IsGameOver(PlayerId &winner) override;
+
+	Actor *FindActorById(PlayerId player_id, ActorId actor_id) override;
+
+	int64_t GetActorBytes() override;
+
+	int64_t GetPathCacheBytes() override;
+};
+} // namespace state
@@ -0,0 +1,95 @@
+/**
+ * @file command_replayer.h
+ * Declares the CommandReplayer class
+ */
+
+#pragma once
+
+#include "state/command_log.h"
+#include "state/interfaces/i_command_taker.h"
+#include "state/state_export.h"
+
+#include <istream>
+
+namespace state {
+
+/**
+ * What came of replaying a turn
+ */
+enum class ReplayStatus {
+	/**
+	 * The turn was replayed, and matches the hash if it has one
+	 */
+	TURN_REPLAYED,
+
+	/**
+	 * There are no more turns in the log
+	 */
+	FINISHED,
+
+	/**
+	 * The turn was replayed, but the state doesn't match the hash
+	 */
+	HASH_MISMATCH,
+
+	/**
+	 * The turn couldn't be read
+	 */
+	MALFORMED
+};
+
+/**
+ * Simulates a game again from its command log, starting from a state just
+ * like the one the game started with
+ */
+class STATE_EXPORT CommandReplayer {
+  private:
+	/**
+	 * The state the commands are given to
+	 */
+	ICommandTaker *state;
+
+	/**
+	 * Stream the command log is read from
+	 */
+	std::istream *log_stream;
+
+	/**
+	 * Number of turns replayed so far
+	 */
+	int64_t turn_no;
+
+	/**
+	 * The turn being replayed, kept to reuse its memory
+	 */
+	CommandLogTurn turn;
+
+  public:
+	/**
+	 * Constructor for CommandReplayer
+	 *
+	 * @param[in]  state       State to replay the game on
+	 * @param[in]  log_stream  Stream to read the command log from
+	 */
+	CommandReplayer(ICommandTaker *state, std::istream &log_stream);
+
+	/**
+	 * Reads the start of the command log
+	 *
+	 * @return     true if the stream holds a command log, false otherwise
+	 */
+	bool Open();
+
+	/**
+	 * Gives the state the next turn's commands and updates it
+	 *
+	 * @return     What came of it
+	 */
+	ReplayStatus ReplayTurn();
+
+	/**
+	 * Returns the number of turns replayed so far
+	 */
+	int64_t GetTurnNo() const;
+};
+} // namespace state
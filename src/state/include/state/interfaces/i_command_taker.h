@@ -173,5 +173,20 @@ class STATE_EXPORT ICommandTaker : public IUpdatable {
 	 * @return Actor*
 	 */
 	virtual Actor *FindActorById(PlayerId player_id, ActorId actor_id) = 0;
+
+	/**
+	 * Get the memory held by the actors, and the lists holding them
+	 *
+	 * @return int64_t Size in bytes
+	 */
+	virtual int64_t GetActorBytes() = 0;
+
+	/**
+	 * Get the memory held by the path planner, which is mostly its cache of
+	 * paths
+	 *
+	 * @return int64_t Size in bytes
+	 */
+	virtual int64_t GetPathCacheBytes() = 0;
 };
 } // namespace state
@@ -35,6 +35,24 @@ class STATE_EXPORT IStateSyncer {
 	virtual void UpdatePlayerStates(
 	    std::array<player_state::State, 2> &player_states) = 0;
 
+	/**
+	 * Method to update a single player's state instance with the new values
+	 * from the updated state, without logging it.
+	 *
+	 * Only reads the main state, so it can run alongside the other player's
+	 * update and LogState.
+	 *
+	 * @param[in]    player_id     Player whose state is updated
+	 * @param[inout] player_state  Reference to the player's state
+	 */
+	virtual void UpdatePlayerState(PlayerId player_id,
+	                               player_state::State &player_state) = 0;
+
+	/**
+	 * Method to log the current main state
+	 */
+	virtual void LogState() = 0;
+
 	/**
 	 * Check if the game is over
 	 *
@@ -59,6 +77,16 @@ class STATE_EXPORT IStateSyncer {
 	 * Returns game interestingness factor
 	 */
 	virtual int64_t GetInterestingness() = 0;
+
+	/**
+	 * Returns the memory held by the main state's actors, in bytes
+	 */
+	virtual int64_t GetActorBytes() = 0;
+
+	/**
+	 * Returns the memory held by the main state's path planner, in bytes
+	 */
+	virtual int64_t GetPathCacheBytes() = 0;
 };
 
 } // namespace state
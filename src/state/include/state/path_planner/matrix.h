@@ -7,6 +7,10 @@
 
 #include "physics/vector.hpp"
 
+#include <climits>
+#include <cstdint>
+#include <vector>
+
 /**
  * 2D matrix alias type
  */
@@ -35,3 +39,32 @@ template <typename T> inline Matrix<T> InitMatrix(T init_value, int64_t size) {
 template <typename T> inline T &GetAt(Matrix<T> &m, Vec2D index) {
 	return m[index.x][index.y];
 }
+
+template <typename T>
+inline const T &GetAt(const Matrix<T> &m, Vec2D index) {
+	return m[index.x][index.y];
+}
+
+/**
+ * Gets the number of bytes a vector has allocated for its elements
+ */
+template <typename T> inline int64_t GetVectorBytes(const std::vector<T> &v) {
+	return v.capacity() * sizeof(T);
+}
+
+inline int64_t GetVectorBytes(const std::vector<bool> &v) {
+	return (v.capacity() + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+/**
+ * Gets the number of bytes a vector of vectors has allocated, along with
+ * everything its rows have, at any depth. Works for matrices of matrices.
+ */
+template <typename T>
+inline int64_t GetVectorBytes(const std::vector<std::vector<T>> &v) {
+	auto bytes = static_cast<int64_t>(v.capacity() * sizeof(std::vector<T>));
+	for (auto const &row : v) {
+		bytes += GetVectorBytes(row);
+	}
+	return bytes;
+}
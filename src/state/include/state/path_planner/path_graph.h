@@ -12,6 +12,10 @@
 
 #include <vector>
 
+namespace player_state {
+struct PathTables;
+}
+
 namespace state {
 
 class PathGraph {
@@ -122,7 +126,26 @@ class PathGraph {
 	 * @param destination Target offset
 	 * @return Vec2D Next offset along the path
 	 */
-	Vec2D GetNextNode(Vec2D source, Vec2D destination);
+	Vec2D GetNextNode(Vec2D source, Vec2D destination) const;
+
+	/**
+	 * Gets the memory the graph holds, which is mostly the path cache
+	 *
+	 * @return int64_t Size in bytes
+	 */
+	int64_t GetMemoryBytes() const;
+
+	/**
+	 * Writes the next offset and the distance between every pair of offsets
+	 * into tables the players can look paths up in. Pairs off the graph, on
+	 * water, or with no path between them are set to PathTables::NONE.
+	 *
+	 * @param[out] path_tables Tables to fill, for a graph of at most MAP_SIZE
+	 * @param is_flipped Whether to fill them in player 2's orientation, with
+	 * the map flipped the way player 2 sees it
+	 */
+	void FillPathTables(player_state::PathTables &path_tables,
+	                    bool is_flipped = false) const;
 };
 
 } // namespace state
@@ -9,6 +9,8 @@
 #include "state/path_planner/interfaces/i_path_planner.h"
 #include "state/path_planner/path_graph.h"
 
+#include <memory>
+
 namespace state {
 
 class PathPlanner : public IPathPlanner {
@@ -19,12 +21,28 @@ class PathPlanner : public IPathPlanner {
 
 	/**
 	 * PathGraph class handles all path calculation algorithms
+	 *
+	 * It's only read after being built, so planners for the same terrain can
+	 * share one
 	 */
-	PathGraph path_graph;
+	std::shared_ptr<const PathGraph> path_graph;
 
   public:
+	/**
+	 * Builds the path graph for the map's terrain
+	 */
 	PathPlanner(Map *map);
 
+	/**
+	 * Reuses a path graph already built for the same terrain
+	 */
+	PathPlanner(Map *map, std::shared_ptr<const PathGraph> path_graph);
+
+	/**
+	 * Get the path graph, to build other planners for the same terrain with
+	 */
+	std::shared_ptr<const PathGraph> GetPathGraph() const;
+
 	/**
 	 * @see IPathPlanner#GetNextPosition
 	 */
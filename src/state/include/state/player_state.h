@@ -12,6 +12,8 @@
 #include "state/utilities.h"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
@@ -311,6 +313,37 @@ inline std::ostream &operator<<(std::ostream &os, TerrainType &t) {
 	return os;
 }
 
+/**
+ * Shortest paths between every pair of offsets on the map. Units step to any
+ * of the 8 offsets around them that are on land, and only cut a corner if both
+ * offsets beside it are land.
+ *
+ * The tables are filled once per map for each player, in that player's
+ * orientation, so player 2's are flipped like its map. They're shared with the
+ * players read only. An offset is indexed as x * MAP_SIZE + y.
+ */
+struct PathTables {
+	static const size_t NUM_OFFSETS = MAP_SIZE * MAP_SIZE;
+
+	/**
+	 * Marks a missing next offset, and the distance to an offset that can't
+	 * be reached
+	 */
+	static const uint16_t NONE = std::numeric_limits<uint16_t>::max();
+
+	/**
+	 * Index of the offset to step to next on the way to a destination, by
+	 * destination and then source
+	 */
+	std::array<std::array<uint16_t, NUM_OFFSETS>, NUM_OFFSETS> next_offsets;
+
+	/**
+	 * Number of steps from a source to a destination, by destination and
+	 * then source
+	 */
+	std::array<std::array<uint16_t, NUM_OFFSETS>, NUM_OFFSETS> distances;
+};
+
 /**
  * Main player state object. One such struct is provided to each player
  */
@@ -330,8 +363,35 @@ struct State {
 
 	Vec2D closest_gold_mine(Vec2D position);
 
+	/**
+	 * Gets the number of steps on the shortest land path between two
+	 * offsets, going around water
+	 *
+	 * Defined in the simulator's library, so it takes only the instructions
+	 * of the call out of the player's budget, however long the path is
+	 *
+	 * @return Number of steps, 0 if the offsets are the same, or -1 if there
+	 * is no path between them
+	 */
+	int64_t path_distance(Vec2D source, Vec2D destination) const;
+
+	/**
+	 * Gets the offset to step to next on the shortest land path from one
+	 * offset to another. Costs the player only the call, like path_distance.
+	 *
+	 * @return Next offset, or Vec2D::null if there is no path, or the offsets
+	 * are the same
+	 */
+	Vec2D next_step(Vec2D source, Vec2D destination) const;
+
 	int64_t score;
 	int64_t gold;
+
+	/**
+	 * Paths between every pair of offsets, mapped read only from the shared
+	 * memory by the player driver. Null if the game didn't share them.
+	 */
+	const PathTables *path_tables = nullptr;
 };
 
 inline std::ostream &operator<<(std::ostream &os, State state) {
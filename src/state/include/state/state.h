@@ -196,6 +196,15 @@ class STATE_EXPORT State : public ICommandTaker {
 	 */
 	std::array<std::vector<std::unique_ptr<Actor>>, 2> actors_to_delete;
 
+	/**
+	 * ID to give the next actor produced in this game
+	 *
+	 * Taken from Actor's counter when the state is constructed, and counted
+	 * up from there by the state alone, so that games running side by side
+	 * don't hand out each other's IDs
+	 */
+	ActorId next_actor_id;
+
 	/**
 	 * Compute scores for this turn, and record them
 	 * Also update the interestingness factor
@@ -204,7 +213,8 @@ class STATE_EXPORT State : public ICommandTaker {
 
   public:
 	/**
-	 * Constructor
+	 * Constructor. Actors produced in the game get IDs from Actor's next ID
+	 * on.
 	 */
 	State(std::unique_ptr<Map> map, std::unique_ptr<GoldManager> gold_manager,
 	      std::unique_ptr<ScoreManager> score_manager,
@@ -306,6 +316,16 @@ class STATE_EXPORT State : public ICommandTaker {
 	 */
 	bool IsGameOver(PlayerId &winner) override;
 
+	/**
+	 * @see ICommandTaker#GetActorBytes
+	 */
+	int64_t GetActorBytes() override;
+
+	/**
+	 * @see ICommandTaker#GetPathCacheBytes
+	 */
+	int64_t GetPathCacheBytes() override;
+
 	/**
 	 * State's update method, to call updates on all actors
 	 */
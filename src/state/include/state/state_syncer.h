@@ -82,6 +82,17 @@ class STATE_EXPORT StateSyncer : public IStateSyncer {
 	void UpdatePlayerStates(
 	    std::array<player_state::State, 2> &player_states) override;
 
+	/**
+	 * @see IStateSyncer#UpdatePlayerState
+	 */
+	void UpdatePlayerState(PlayerId player_id,
+	                       player_state::State &player_state) override;
+
+	/**
+	 * @see IStateSyncer#LogState
+	 */
+	void LogState() override;
+
 	/**
 	 * @see IStateSyncer#IsGameOver
 	 */
@@ -96,6 +107,16 @@ class STATE_EXPORT StateSyncer : public IStateSyncer {
 	 * @see IStateSyncer#GetInterestingness
 	 */
 	int64_t GetInterestingness() override;
+
+	/**
+	 * @see IStateSyncer#GetActorBytes
+	 */
+	int64_t GetActorBytes() override;
+
+	/**
+	 * @see IStateSyncer#GetPathCacheBytes
+	 */
+	int64_t GetPathCacheBytes() override;
 };
 
 } // namespace state
@@ -169,17 +169,15 @@ void CommandGiver::RunCommands(
 
 			// Validating the the soldier id
 			if (soldier.id != state_soldier->GetActorId()) {
-				logger->LogError(Player_Id,
-				                 logger::ErrorType::NO_ALTER_ACTOR_ID,
-				                 "Cannot alter soldier id");
+				logger->LogError(
+				    Player_Id, logger::ErrorMessage::SOLDIER_ID_ALTERED);
 				continue;
 			}
 
 			// Checking if the soldier is attacking and moving at the same time
 			else if (is_attacking && is_moving) {
 				logger->LogError(
-				    Player_Id, logger::ErrorType::NO_MULTIPLE_SOLDIER_TASKS,
-				    "Soldier cannot attack and move at the same time");
+				    Player_Id, logger::ErrorMessage::SOLDIER_ATTACK_AND_MOVE);
 			} else {
 				if (is_attacking) {
 					// Checking if the target is an enemy
@@ -194,26 +192,26 @@ void CommandGiver::RunCommands(
 							case ActorType::SOLDIER:
 								logger->LogError(
 								    Player_Id,
-								    logger::ErrorType::NO_ATTACK_SELF_SOLDIER,
-								    "Soldier is attacking his own soldier");
+								    logger::ErrorMessage::
+								        SOLDIER_ATTACKS_OWN_SOLDIER);
 								break;
 							case ActorType::VILLAGER:
 								logger->LogError(
 								    Player_Id,
-								    logger::ErrorType::NO_ATTACK_SELF_VILLAGER,
-								    "Soldier is attacking his own villager");
+								    logger::ErrorMessage::
+								        SOLDIER_ATTACKS_OWN_VILLAGER);
 								break;
 							case ActorType::FACTORY:
 								logger->LogError(
 								    Player_Id,
-								    logger::ErrorType::NO_ATTACK_SELF_FACTORY,
-								    "Soldier is attacking his own soldier");
+								    logger::ErrorMessage::
+								        SOLDIER_ATTACKS_OWN_FACTORY);
 								break;
 							}
 						} else {
 							logger->LogError(
-							    Player_Id, logger::ErrorType::INVALID_TARGET_ID,
-							    "Invalid target id");
+							    Player_Id,
+							    logger::ErrorMessage::INVALID_TARGET_ID);
 						}
 
 						continue;
@@ -236,8 +234,8 @@ void CommandGiver::RunCommands(
 						MoveUnit(Player_Id, soldier.id, location);
 					} else {
 						logger->LogError(
-						    Player_Id, logger::ErrorType::INVALID_MOVE_POSITION,
-						    "Soldier trying to move to invalid location");
+						    Player_Id,
+						    logger::ErrorMessage::SOLDIER_INVALID_MOVE);
 					}
 				}
 			}
@@ -264,9 +262,8 @@ void CommandGiver::RunCommands(
 
 			// Check if the villager's id is valid
 			if (villager.id != state_villager->GetActorId()) {
-				logger->LogError(Player_id,
-				                 logger::ErrorType::NO_ALTER_ACTOR_ID,
-				                 "Cannot alter villager id");
+				logger->LogError(
+				    Player_id, logger::ErrorMessage::VILLAGER_ID_ALTERED);
 				continue;
 			}
 
@@ -300,8 +297,7 @@ void CommandGiver::RunCommands(
 			                         should_attack, should_mine};
 			if (std::count(checks.begin(), checks.end(), true) > 1) {
 				logger->LogError(
-				    Player_id, logger::ErrorType::NO_MULTIPLE_VILLAGER_TASKS,
-				    "Villager cannot do multiple tasks at the same time");
+				    Player_id, logger::ErrorMessage::VILLAGER_MULTIPLE_TASKS);
 				continue;
 			}
 
@@ -325,10 +321,8 @@ void CommandGiver::RunCommands(
 								if (is_occupied) {
 									logger->LogError(
 									    Player_id,
-									    logger::ErrorType::POSITION_OCCUPIED,
-									    "Villager is trying to build a factory "
-									    "in a position that is already "
-									    "occupied");
+									    logger::ErrorMessage::
+									        POSITION_OCCUPIED);
 								} else {
 									auto build_offset = villager.build_offset;
 									ActorType unit_type;
@@ -349,36 +343,29 @@ void CommandGiver::RunCommands(
 							} else {
 								logger->LogError(
 								    Player_id,
-								    logger::ErrorType::NO_MORE_FACTORIES,
-								    "Trying to build more factories than the "
-								    "factory limit");
+								    logger::ErrorMessage::NO_MORE_FACTORIES);
 							}
 							break;
 						case TerrainType::WATER:
 							logger->LogError(
 							    Player_id,
-							    logger::ErrorType::NO_BUILD_FACTORY_ON_WATER,
-							    "Villager trying to build factory on water");
+							    logger::ErrorMessage::FACTORY_ON_WATER);
 							break;
 						case TerrainType::GOLD_MINE:
-							logger->LogError(Player_id,
-							                 logger::ErrorType::
-							                     NO_BUILD_FACTORY_ON_GOLD_MINE,
-							                 "Villager trying to build factory "
-							                 "on gold mine");
+							logger->LogError(
+							    Player_id,
+							    logger::ErrorMessage::FACTORY_ON_GOLD_MINE);
 							break;
 						}
 					} else {
-						logger->LogError(Player_id,
-						                 logger::ErrorType::INSUFFICIENT_FUNDS,
-						                 "You do not have sufficient gold to "
-						                 "construct a factory");
+						logger->LogError(
+						    Player_id,
+						    logger::ErrorMessage::INSUFFICIENT_FUNDS);
 					}
 				} else {
-					logger->LogError(Player_id,
-					                 logger::ErrorType::INVALID_BUILD_POSITION,
-					                 "Villager cannot build factory in "
-					                 "invalid position");
+					logger->LogError(
+					    Player_id,
+					    logger::ErrorMessage::INVALID_BUILD_POSITION);
 				}
 			}
 
@@ -397,9 +384,7 @@ void CommandGiver::RunCommands(
 					             villager.target_factory_id);
 				} else {
 					logger->LogError(
-					    Player_id,
-					    logger::ErrorType::NO_BUILD_FACTORY_THAT_DOSENT_EXIST,
-					    "Villager trying to build factory that doesn't exist");
+					    Player_id, logger::ErrorMessage::FACTORY_DOESNT_EXIST);
 				}
 			}
 
@@ -418,8 +403,7 @@ void CommandGiver::RunCommands(
 					MoveUnit(Player_id, villager.id, location);
 				} else {
 					logger->LogError(
-					    Player_id, logger::ErrorType::INVALID_MOVE_POSITION,
-					    "Villager cannot move to invalid position");
+					    Player_id, logger::ErrorMessage::VILLAGER_INVALID_MOVE);
 				}
 			}
 
@@ -435,28 +419,27 @@ void CommandGiver::RunCommands(
 						case ActorType::SOLDIER:
 							logger->LogError(
 							    Player_id,
-							    logger::ErrorType::NO_ATTACK_SELF_SOLDIER,
-							    "Villager is attacking his own soldier");
+							    logger::ErrorMessage::
+							        VILLAGER_ATTACKS_OWN_SOLDIER);
 							break;
 						case ActorType::VILLAGER:
 							logger->LogError(
 							    Player_id,
-							    logger::ErrorType::NO_ATTACK_SELF_VILLAGER,
-							    "Villager is attacking his own villager");
+							    logger::ErrorMessage::
+							        VILLAGER_ATTACKS_OWN_VILLAGER);
 							break;
 						case ActorType::FACTORY:
 							logger->LogError(
 							    Player_id,
-							    logger::ErrorType::NO_ATTACK_SELF_FACTORY,
-							    "Villager is attacking his own factory");
+							    logger::ErrorMessage::
+							        VILLAGER_ATTACKS_OWN_FACTORY);
 							break;
 						}
 
 						continue;
 					} else {
-						logger->LogError(Player_id,
-						                 logger::ErrorType::INVALID_TARGET_ID,
-						                 "Invalid target id");
+						logger->LogError(
+						    Player_id, logger::ErrorMessage::INVALID_TARGET_ID);
 					}
 				}
 				AttackActor(Player_id, villager.id, villager.target);
@@ -487,13 +470,12 @@ void CommandGiver::RunCommands(
 						MineLocation(Player_id, villager.id, location.to_int());
 					} else {
 						logger->LogError(
-						    Player_id, logger::ErrorType::INVALID_MINE_POSITION,
-						    "Villager cannot mine in invalid position");
+						    Player_id,
+						    logger::ErrorMessage::INVALID_MINE_POSITION);
 					}
 				} else {
 					logger->LogError(
-					    Player_id, logger::ErrorType::INVALID_MINE_POSITION,
-					    "Villager cannot mine in invalid position");
+					    Player_id, logger::ErrorMessage::INVALID_MINE_POSITION);
 				}
 			}
 		}
@@ -514,9 +496,8 @@ void CommandGiver::RunCommands(
 			// Validating the factory id
 			if (factory.id !=
 			    state_factories[player_id][factory_index]->GetActorId()) {
-				logger->LogError(Player_id,
-				                 logger::ErrorType::NO_ALTER_ACTOR_ID,
-				                 "Cannot alter factory id");
+				logger->LogError(
+				    Player_id, logger::ErrorMessage::FACTORY_ID_ALTERED);
 				continue;
 			}
 
@@ -0,0 +1,295 @@
+/**
+ * @file command_log.cpp
+ * Defines the reading, writing and replaying of command logs
+ */
+
+#include "state/command_log.h"
+
+#include <cstring>
+
+namespace state {
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/**
+ * Hashes values into a running FNV-1a hash
+ */
+class StateHasher {
+  private:
+	uint64_t hash = FNV_OFFSET_BASIS;
+
+  public:
+	void Add(uint64_t value) {
+		for (int i = 0; i < 8; ++i) {
+			hash ^= (value >> (i * 8)) & 0xff;
+			hash *= FNV_PRIME;
+		}
+	}
+
+	void Add(double value) {
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		Add(bits);
+	}
+
+	void Add(DoubleVec2D position) {
+		Add(position.x);
+		Add(position.y);
+	}
+
+	/**
+	 * Adds what every kind of actor has
+	 */
+	void AddActor(Actor *actor) {
+		Add((uint64_t)actor->GetActorId());
+		Add((uint64_t)actor->GetHp());
+		Add((uint64_t)actor->GetAge());
+		Add(actor->GetPosition());
+	}
+
+	uint64_t GetHash() const { return hash; }
+};
+
+void WriteVarint(std::ostream &write_stream, uint64_t value) {
+	while (value >= 0x80) {
+		write_stream.put((char)((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	write_stream.put((char)value);
+}
+
+bool ReadVarint(std::istream &read_stream, uint64_t &value) {
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		auto byte = read_stream.get();
+		if (byte == std::istream::traits_type::eof()) {
+			return false;
+		}
+		value |= (uint64_t)(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Writes a signed value, zigzag encoded so that small negative values are
+ * short too
+ */
+void WriteSigned(std::ostream &write_stream, int64_t value) {
+	WriteVarint(write_stream, (uint64_t)value << 1 ^ (uint64_t)(value >> 63));
+}
+
+bool ReadSigned(std::istream &read_stream, int64_t &value) {
+	uint64_t encoded;
+	if (!ReadVarint(read_stream, encoded)) {
+		return false;
+	}
+	value = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+	return true;
+}
+
+bool ReadCommand(std::istream &read_stream, Command &command) {
+	uint64_t type, player_id;
+	if (!ReadVarint(read_stream, type) ||
+	    type > (uint64_t)CommandType::STOP_OR_START_FACTORY ||
+	    !ReadVarint(read_stream, player_id) || player_id > 1 ||
+	    !ReadSigned(read_stream, command.actor_id)) {
+		return false;
+	}
+	command.type = static_cast<CommandType>(type);
+	command.player_id = static_cast<PlayerId>(player_id);
+
+	uint64_t value = 0;
+	switch (command.type) {
+	case CommandType::MOVE_UNIT:
+	case CommandType::MINE_LOCATION:
+		return ReadSigned(read_stream, command.position.x) &&
+		       ReadSigned(read_stream, command.position.y);
+	case CommandType::ATTACK_ACTOR:
+	case CommandType::BUILD_FACTORY:
+		return ReadSigned(read_stream, command.target_id);
+	case CommandType::CREATE_FACTORY:
+		if (!ReadSigned(read_stream, command.position.x) ||
+		    !ReadSigned(read_stream, command.position.y)) {
+			return false;
+		}
+		// Fall through to the unit type
+	case CommandType::SET_FACTORY_PRODUCTION:
+		if (!ReadVarint(read_stream, value) ||
+		    value > (uint64_t)ActorType::FACTORY) {
+			return false;
+		}
+		command.actor_type = static_cast<ActorType>(value);
+		return true;
+	case CommandType::STOP_OR_START_FACTORY:
+		if (!ReadVarint(read_stream, value)) {
+			return false;
+		}
+		command.should_stop = value != 0;
+		return true;
+	}
+	return false;
+}
+
+void WriteCommand(std::ostream &write_stream, const Command &command) {
+	WriteVarint(write_stream, (uint64_t)command.type);
+	WriteVarint(write_stream, (uint64_t)command.player_id);
+	WriteSigned(write_stream, command.actor_id);
+
+	switch (command.type) {
+	case CommandType::MOVE_UNIT:
+	case CommandType::MINE_LOCATION:
+		WriteSigned(write_stream, command.position.x);
+		WriteSigned(write_stream, command.position.y);
+		break;
+	case CommandType::ATTACK_ACTOR:
+	case CommandType::BUILD_FACTORY:
+		WriteSigned(write_stream, command.target_id);
+		break;
+	case CommandType::CREATE_FACTORY:
+		WriteSigned(write_stream, command.position.x);
+		WriteSigned(write_stream, command.position.y);
+		WriteVarint(write_stream, (uint64_t)command.actor_type);
+		break;
+	case CommandType::SET_FACTORY_PRODUCTION:
+		WriteVarint(write_stream, (uint64_t)command.actor_type);
+		break;
+	case CommandType::STOP_OR_START_FACTORY:
+		WriteVarint(write_stream, command.should_stop);
+		break;
+	}
+}
+} // namespace
+
+void WriteCommandLogHeader(std::ostream &write_stream) {
+	write_stream.write(COMMAND_LOG_MAGIC.data(), COMMAND_LOG_MAGIC.size());
+}
+
+bool ReadCommandLogHeader(std::istream &read_stream) {
+	auto magic = std::string(COMMAND_LOG_MAGIC.size(), '\0');
+	read_stream.read(&magic[0], magic.size());
+	return read_stream && magic == COMMAND_LOG_MAGIC;
+}
+
+void WriteCommandLogTurn(std::ostream &write_stream,
+                         const CommandLogTurn &turn) {
+	// The number of commands and whether there's a hash share a varint
+	WriteVarint(write_stream,
+	            (uint64_t)turn.commands.size() << 1 | turn.has_state_hash);
+	for (auto const &command : turn.commands) {
+		WriteCommand(write_stream, command);
+	}
+	if (turn.has_state_hash) {
+		WriteVarint(write_stream, turn.state_hash);
+	}
+}
+
+bool ReadCommandLogTurn(std::istream &read_stream, CommandLogTurn &turn) {
+	turn.commands.clear();
+
+	// Stop quietly at the end of the log, so that eof() is only set after a
+	// whole turn if the log ends cleanly
+	if (read_stream.peek() == std::istream::traits_type::eof()) {
+		return false;
+	}
+
+	uint64_t header;
+	if (!ReadVarint(read_stream, header)) {
+		read_stream.clear(std::ios::badbit);
+		return false;
+	}
+	turn.has_state_hash = header & 1;
+
+	auto num_commands = header >> 1;
+	for (uint64_t i = 0; i < num_commands; ++i) {
+		Command command{};
+		if (!ReadCommand(read_stream, command)) {
+			read_stream.clear(std::ios::badbit);
+			return false;
+		}
+		turn.commands.push_back(command);
+	}
+
+	turn.state_hash = 0;
+	if (turn.has_state_hash && !ReadVarint(read_stream, turn.state_hash)) {
+		read_stream.clear(std::ios::badbit);
+		return false;
+	}
+	return true;
+}
+
+void ApplyCommand(ICommandTaker *state, const Command &command) {
+	switch (command.type) {
+	case CommandType::MOVE_UNIT:
+		state->MoveUnit(command.player_id, command.actor_id, command.position);
+		break;
+	case CommandType::MINE_LOCATION:
+		state->MineLocation(command.player_id, command.actor_id,
+		                    command.position);
+		break;
+	case CommandType::ATTACK_ACTOR:
+		state->AttackActor(command.player_id, command.actor_id,
+		                   command.target_id);
+		break;
+	case CommandType::CREATE_FACTORY:
+		state->CreateFactory(command.player_id, command.actor_id,
+		                     command.position, command.actor_type);
+		break;
+	case CommandType::BUILD_FACTORY:
+		state->BuildFactory(command.player_id, command.actor_id,
+		                    command.target_id);
+		break;
+	case CommandType::SET_FACTORY_PRODUCTION:
+		state->SetFactoryProduction(command.player_id, command.actor_id,
+		                            command.actor_type);
+		break;
+	case CommandType::STOP_OR_START_FACTORY:
+		state->StopOrStartFactory(command.player_id, command.actor_id,
+		                          command.should_stop);
+		break;
+	}
+}
+
+uint64_t HashState(ICommandTaker *state) {
+	auto hasher = StateHasher{};
+
+	auto soldiers = state->GetSoldiers();
+	auto villagers = state->GetVillagers();
+	auto factories = state->GetFactories();
+	auto gold = state->GetGold();
+	auto scores = state->GetScores(false);
+
+	for (int player_id = 0; player_id < 2; ++player_id) {
+		hasher.Add((uint64_t)soldiers[player_id].size());
+		for (auto *soldier : soldiers[player_id]) {
+			hasher.AddActor(soldier);
+			hasher.Add((uint64_t)soldier->GetState());
+		}
+
+		hasher.Add((uint64_t)villagers[player_id].size());
+		for (auto *villager : villagers[player_id]) {
+			hasher.AddActor(villager);
+			hasher.Add((uint64_t)villager->GetState());
+		}
+
+		hasher.Add((uint64_t)factories[player_id].size());
+		for (auto *factory : factories[player_id]) {
+			hasher.AddActor(factory);
+			hasher.Add((uint64_t)factory->GetState());
+			hasher.Add((uint64_t)factory->GetProductionState());
+			hasher.Add((uint64_t)factory->GetConstructionCompletion());
+		}
+
+		hasher.Add((uint64_t)gold[player_id]);
+		hasher.Add((uint64_t)scores[player_id]);
+	}
+
+	return hasher.GetHash();
+}
+} // namespace state
@@ -0,0 +1,128 @@
+/**
+ * @file command_recorder.cpp
+ * Defines the CommandRecorder class
+ */
+
+#include "state/command_recorder.h"
+
+namespace state {
+
+CommandRecorder::CommandRecorder(std::unique_ptr<ICommandTaker> state,
+                                 std::unique_ptr<std::ostream> log_stream,
+                                 int64_t hash_interval_turns)
+    : state(std::move(state)), log_stream(std::move(log_stream)),
+      hash_interval_turns(hash_interval_turns), turn_no(0), turn() {
+	WriteCommandLogHeader(*this->log_stream);
+}
+
+void CommandRecorder::Record(CommandType type, PlayerId player_id,
+                             ActorId actor_id) {
+	auto command = Command{};
+	command.type = type;
+	command.player_id = player_id;
+	command.actor_id = actor_id;
+	turn.commands.push_back(command);
+}
+
+void CommandRecorder::MoveUnit(PlayerId player_id, ActorId actor_id,
+                               Vec2D position) {
+	state->MoveUnit(player_id, actor_id, position);
+	Record(CommandType::MOVE_UNIT, player_id, actor_id);
+	turn.commands.back().position = position;
+}
+
+void CommandRecorder::MineLocation(PlayerId player_id, ActorId villager_id,
+                                   Vec2D mine_location) {
+	state->MineLocation(player_id, villager_id, mine_location);
+	Record(CommandType::MINE_LOCATION, player_id, villager_id);
+	turn.commands.back().position = mine_location;
+}
+
+void CommandRecorder::AttackActor(PlayerId player_id, ActorId unit_id,
+                                  ActorId enemy_actor_id) {
+	state->AttackActor(player_id, unit_id, enemy_actor_id);
+	Record(CommandType::ATTACK_ACTOR, player_id, unit_id);
+	turn.commands.back().target_id = enemy_actor_id;
+}
+
+void CommandRecorder::CreateFactory(PlayerId player_id, ActorId villager_id,
+                                    Vec2D offset, ActorType produce_unit) {
+	state->CreateFactory(player_id, villager_id, offset, produce_unit);
+	Record(CommandType::CREATE_FACTORY, player_id, villager_id);
+	turn.commands.back().position = offset;
+	turn.commands.back().actor_type = produce_unit;
+}
+
+void CommandRecorder::BuildFactory(PlayerId player_id, ActorId villager_id,
+                                   ActorId factory_id) {
+	state->BuildFactory(player_id, villager_id, factory_id);
+	Record(CommandType::BUILD_FACTORY, player_id, villager_id);
+	turn.commands.back().target_id = factory_id;
+}
+
+void CommandRecorder::SetFactoryProduction(PlayerId player_id,
+                                           ActorId factory_id,
+                                           ActorType production) {
+	state->SetFactoryProduction(player_id, factory_id, production);
+	Record(CommandType::SET_FACTORY_PRODUCTION, player_id, factory_id);
+	turn.commands.back().actor_type = production;
+}
+
+void CommandRecorder::StopOrStartFactory(PlayerId player_id,
+                                         ActorId factory_id,
+                                         bool should_stop) {
+	state->StopOrStartFactory(player_id, factory_id, should_stop);
+	Record(CommandType::STOP_OR_START_FACTORY, player_id, factory_id);
+	turn.commands.back().should_stop = should_stop;
+}
+
+void CommandRecorder::Update() {
+	state->Update();
+	++turn_no;
+
+	turn.has_state_hash = turn_no % hash_interval_turns == 0;
+	turn.state_hash = turn.has_state_hash ? HashState(state.get()) : 0;
+	WriteCommandLogTurn(*log_stream, turn);
+	turn.commands.clear();
+}
+
+const std::array<std::vector<Soldier *>, 2> CommandRecorder::GetSoldiers() {
+	return state->GetSoldiers();
+}
+
+const std::array<std::vector<Villager *>, 2> CommandRecorder::GetVillagers() {
+	return state->GetVillagers();
+}
+
+const std::array<std::vector<Factory *>, 2> CommandRecorder::GetFactories() {
+	return state->GetFactories();
+}
+
+const Map *CommandRecorder::GetMap() { return state->GetMap(); }
+
+const std::array<int64_t, 2> CommandRecorder::GetGold() {
+	return state->GetGold();
+}
+
+const std::array<int64_t, 2> CommandRecorder::GetScores(bool game_over) {
+	return state->GetScores(game_over);
+}
+
+int64_t CommandRecorder::GetInterestingness() {
+	return state->GetInterestingness();
+}
+
+bool CommandRecorder::IsGameOver(PlayerId &winner) {
+	return state->IsGameOver(winner);
+}
+
+Actor *CommandRecorder::FindActorById(PlayerId player_id, ActorId actor_id) {
+	return state->FindActorById(player_id, actor_id);
+}
+
+int64_t CommandRecorder::GetActorBytes() { return state->GetActorBytes(); }
+
+int64_t CommandRecorder::GetPathCacheBytes() {
+	return state->GetPathCacheBytes();
+}
+} // namespace state
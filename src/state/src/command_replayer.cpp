@@ -0,0 +1,35 @@
+/**
+ * @file command_replayer.cpp
+ * Defines the CommandReplayer class
+ */
+
+#include "state/command_replayer.h"
+
+namespace state {
+
+CommandReplayer::CommandReplayer(ICommandTaker *state,
+                                 std::istream &log_stream)
+    : state(state), log_stream(&log_stream), turn_no(0), turn() {}
+
+bool CommandReplayer::Open() { return ReadCommandLogHeader(*log_stream); }
+
+ReplayStatus CommandReplayer::ReplayTurn() {
+	if (!ReadCommandLogTurn(*log_stream, turn)) {
+		return log_stream->eof() ? ReplayStatus::FINISHED
+		                         : ReplayStatus::MALFORMED;
+	}
+
+	for (auto const &command : turn.commands) {
+		ApplyCommand(state, command);
+	}
+	state->Update();
+	++turn_no;
+
+	if (turn.has_state_hash && HashState(state) != turn.state_hash) {
+		return ReplayStatus::HASH_MISMATCH;
+	}
+	return ReplayStatus::TURN_REPLAYED;
+}
+
+int64_t CommandReplayer::GetTurnNo() const { return turn_no; }
+} // namespace state
@@ -4,8 +4,10 @@
  */
 
 #include "state/path_planner/path_graph.h"
+#include "state/player_state.h"
 
 #include <queue>
+#include <vector>
 
 namespace state {
 
@@ -53,6 +55,71 @@ void PathGraph::ComputeAllPathsFromNode(Vec2D node) {
 	}
 }
 
+void PathGraph::FillPathTables(player_state::PathTables &path_tables,
+                               bool is_flipped) const {
+	using player_state::PathTables;
+
+	for (auto &next_offsets : path_tables.next_offsets) {
+		next_offsets.fill(PathTables::NONE);
+	}
+	for (auto &distances : path_tables.distances) {
+		distances.fill(PathTables::NONE);
+	}
+
+	// Every offset is looked up, and stored, in the players' orientation
+	auto get_index = [this, is_flipped](Vec2D offset) {
+		if (is_flipped) {
+			offset = Vec2D{static_cast<int64_t>(size) - 1 - offset.x,
+			               static_cast<int64_t>(size) - 1 - offset.y};
+		}
+		return static_cast<size_t>(offset.x) * MAP_SIZE +
+		       static_cast<size_t>(offset.y);
+	};
+
+	// The cache of each destination is a tree of every node that reaches it,
+	// each pointing at the next node on its way. A node's distance is one
+	// more than its next node's, so the walk from each source stops at the
+	// first node whose distance is known, and fills in the nodes before it.
+	auto walk = std::vector<Vec2D>{};
+	auto num_nodes = static_cast<int64_t>(size);
+	for (int64_t i = 0; i < num_nodes; ++i) {
+		for (int64_t j = 0; j < num_nodes; ++j) {
+			auto destination = Vec2D{i, j};
+			if (not graph[i][j]) {
+				continue;
+			}
+
+			auto destination_index = get_index(destination);
+			auto &next_offsets = path_tables.next_offsets[destination_index];
+			auto &distances = path_tables.distances[destination_index];
+			auto const &next_nodes = GetAt(path_cache, destination);
+			distances[destination_index] = 0;
+
+			for (int64_t x = 0; x < num_nodes; ++x) {
+				for (int64_t y = 0; y < num_nodes; ++y) {
+					auto node = Vec2D{x, y};
+					walk.clear();
+					while (GetAt(next_nodes, node) != Vec2D::null &&
+					       distances[get_index(node)] == PathTables::NONE) {
+						walk.push_back(node);
+						node = GetAt(next_nodes, node);
+					}
+					if (GetAt(next_nodes, node) == Vec2D::null) {
+						continue;
+					}
+
+					auto distance = distances[get_index(node)];
+					for (auto it = walk.rbegin(); it != walk.rend(); ++it) {
+						distances[get_index(*it)] = ++distance;
+						next_offsets[get_index(*it)] =
+						    get_index(GetAt(next_nodes, *it));
+					}
+				}
+			}
+		}
+	}
+}
+
 // void PathGraph::GeneratePathCache() {
 // 	path_cache = InitMatrix(InitMatrix(Vec2D::null, size), size);
 // 	is_path_computed = InitMatrix(InitMatrix(false, size), size);
@@ -78,7 +78,7 @@ bool PathGraph::GetNextSmallestNodeFromOpenList(Vec2D &offset) {
 	return false;
 }
 
-Vec2D PathGraph::GetNextNode(Vec2D source, Vec2D destination) {
+Vec2D PathGraph::GetNextNode(Vec2D source, Vec2D destination) const {
 	// If source or destination are out of bounds...
 	if (source.x < 0 || source.x >= size || source.y < 0 || source.y >= size ||
 	    destination.x < 0 || destination.x >= size || destination.y < 0 ||
@@ -96,10 +96,8 @@ Vec2D PathGraph::GetNextNode(Vec2D source, Vec2D destination) {
 	if (source == destination) {
 		return {};
 	}
-	auto source_matrix = GetAt(path_cache, destination);
-	auto next_node = GetAt(source_matrix, source);
-
-	return next_node;
+	// Look the node up in place, the cache rows are large
+	return GetAt(GetAt(path_cache, destination), source);
 }
 
 std::vector<Vec2D> PathGraph::GetPath(Vec2D start_offset, Vec2D target_offset) {
@@ -242,6 +240,12 @@ std::vector<Vec2D> PathGraph::GetNeighbours(const Vec2D &offset) {
 	return neighbours;
 }
 
+int64_t PathGraph::GetMemoryBytes() const {
+	return sizeof(PathGraph) + GetVectorBytes(graph) +
+	       GetVectorBytes(path_cache) + GetVectorBytes(is_path_computed) +
+	       GetVectorBytes(open_list);
+}
+
 bool PathGraph::IsValidOffset(const Vec2D &offset) {
 	return offset.x >= 0 && offset.x < size && offset.y >= 0 &&
 	       offset.y < size && graph[offset.x][offset.y];
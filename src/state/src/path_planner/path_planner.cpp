@@ -32,7 +32,14 @@ PathPlanner::PathPlanner(Map *map) : map(map) {
 		}
 	}
 
-	path_graph = PathGraph(map_graph);
+	path_graph = std::make_shared<const PathGraph>(map_graph);
+}
+
+PathPlanner::PathPlanner(Map *map, std::shared_ptr<const PathGraph> path_graph)
+    : map(map), path_graph(std::move(path_graph)) {}
+
+std::shared_ptr<const PathGraph> PathPlanner::GetPathGraph() const {
+	return path_graph;
 }
 
 DoubleVec2D PathPlanner::GetNextPosition(DoubleVec2D source,
@@ -56,7 +63,7 @@ DoubleVec2D PathPlanner::GetNextPosition(DoubleVec2D source,
 		if (start_offset == target_offset) {
 			next_offset = start_offset;
 		} else {
-			next_offset = path_graph.GetNextNode(start_offset, target_offset);
+			next_offset = path_graph->GetNextNode(start_offset, target_offset);
 		}
 
 		// If no valid path exists...
@@ -0,0 +1,60 @@
+/**
+ * @file player_state.cpp
+ * Defines the player state helpers that look paths up. They're compiled into
+ * the simulator's library rather than the player's, so the instruction count
+ * doesn't see them.
+ */
+
+#include "state/player_state.h"
+
+namespace player_state {
+
+const size_t PathTables::NUM_OFFSETS;
+
+const uint16_t PathTables::NONE;
+
+namespace {
+
+/**
+ * Gets the index of an offset into the path tables, or NUM_OFFSETS if it's
+ * off the map
+ */
+size_t GetOffsetIndex(Vec2D offset) {
+	if (offset.x < 0 || offset.x >= static_cast<int64_t>(MAP_SIZE) ||
+	    offset.y < 0 || offset.y >= static_cast<int64_t>(MAP_SIZE)) {
+		return PathTables::NUM_OFFSETS;
+	}
+	return static_cast<size_t>(offset.x) * MAP_SIZE +
+	       static_cast<size_t>(offset.y);
+}
+} // namespace
+
+int64_t State::path_distance(Vec2D source, Vec2D destination) const {
+	auto source_index = GetOffsetIndex(source);
+	auto destination_index = GetOffsetIndex(destination);
+	if (path_tables == nullptr || source_index == PathTables::NUM_OFFSETS ||
+	    destination_index == PathTables::NUM_OFFSETS) {
+		return -1;
+	}
+
+	auto distance = path_tables->distances[destination_index][source_index];
+	return distance == PathTables::NONE ? -1 : distance;
+}
+
+Vec2D State::next_step(Vec2D source, Vec2D destination) const {
+	auto source_index = GetOffsetIndex(source);
+	auto destination_index = GetOffsetIndex(destination);
+	if (path_tables == nullptr || source_index == PathTables::NUM_OFFSETS ||
+	    destination_index == PathTables::NUM_OFFSETS) {
+		return Vec2D::null;
+	}
+
+	auto next_offset =
+	    path_tables->next_offsets[destination_index][source_index];
+	if (next_offset == PathTables::NONE) {
+		return Vec2D::null;
+	}
+	return Vec2D{static_cast<int64_t>(next_offset / MAP_SIZE),
+	             static_cast<int64_t>(next_offset % MAP_SIZE)};
+}
+} // namespace player_state
@@ -26,7 +26,8 @@ State::State(std::unique_ptr<Map> map,
       model_soldier(std::move(model_soldier)),
       model_factory(std::move(model_factory)),
       interest_threshold(interest_threshold), was_player1_in_the_lead(false),
-      interestingness(0), scores({0, 0}), actors_to_delete({}) {}
+      interestingness(0), scores({0, 0}), actors_to_delete({}),
+      next_actor_id(Actor::GetNextActorId()) {}
 
 /**
  * Helper function to get the enemy player id
@@ -302,6 +303,39 @@ const std::array<int64_t, 2> State::GetScores(bool game_over) {
 
 int64_t State::GetInterestingness() { return interestingness; }
 
+int64_t State::GetActorBytes() {
+	int64_t bytes = 0;
+	for (int i = 0; i < 2; ++i) {
+		bytes += GetVectorBytes(soldiers[i]) +
+		         soldiers[i].size() * sizeof(Soldier);
+		bytes += GetVectorBytes(villagers[i]) +
+		         villagers[i].size() * sizeof(Villager);
+		bytes += GetVectorBytes(factories[i]) +
+		         factories[i].size() * sizeof(Factory);
+
+		// Actors that died last turn are still held, until this turn is over
+		bytes += GetVectorBytes(actors_to_delete[i]);
+		for (auto const &actor : actors_to_delete[i]) {
+			switch (actor->GetActorType()) {
+			case ActorType::SOLDIER:
+				bytes += sizeof(Soldier);
+				break;
+			case ActorType::VILLAGER:
+				bytes += sizeof(Villager);
+				break;
+			case ActorType::FACTORY:
+				bytes += sizeof(Factory);
+				break;
+			}
+		}
+	}
+	return bytes;
+}
+
+int64_t State::GetPathCacheBytes() {
+	return sizeof(PathPlanner) + path_planner->GetPathGraph()->GetMemoryBytes();
+}
+
 /**
  * Helpers to issue calls for age score rewards
  *
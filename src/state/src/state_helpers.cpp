@@ -36,7 +36,7 @@ std::unique_ptr<Factory> State::FactoryBuilder(PlayerId p_player_id,
 
 	// Create a new Factory, and set the right parameters
 	auto factory = std::make_unique<Factory>(
-	    Actor::GetNextActorId(), p_player_id, model_factory.GetActorType(),
+	    next_actor_id++, p_player_id, model_factory.GetActorType(),
 	    model_factory.GetHp(), model_factory.GetMaxHp(), position,
 	    gold_manager.get(), score_manager.get(),
 	    model_factory.GetConstructionCompletion(),
@@ -50,7 +50,7 @@ std::unique_ptr<Factory> State::FactoryBuilder(PlayerId p_player_id,
 std::unique_ptr<Villager> State::VillagerBuilder(PlayerId p_player_id,
                                                  DoubleVec2D position) {
 	auto new_villager = std::make_unique<Villager>(
-	    Actor::GetNextActorId(), p_player_id, model_villager.GetActorType(),
+	    next_actor_id++, p_player_id, model_villager.GetActorType(),
 	    model_villager.GetHp(), model_villager.GetMaxHp(), position,
 	    gold_manager.get(), score_manager.get(), path_planner.get(),
 	    model_villager.GetSpeed(), model_villager.GetAttackRange(),
@@ -63,7 +63,7 @@ std::unique_ptr<Villager> State::VillagerBuilder(PlayerId p_player_id,
 std::unique_ptr<Soldier> State::SoldierBuilder(PlayerId p_player_id,
                                                DoubleVec2D position) {
 	auto new_soldier = std::make_unique<Soldier>(
-	    Actor::GetNextActorId(), p_player_id, model_soldier.GetActorType(),
+	    next_actor_id++, p_player_id, model_soldier.GetActorType(),
 	    model_soldier.GetHp(), model_soldier.GetMaxHp(), position,
 	    gold_manager.get(), score_manager.get(), path_planner.get(),
 	    model_soldier.GetSpeed(), model_soldier.GetAttackRange(),
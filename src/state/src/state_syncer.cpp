@@ -43,101 +43,99 @@ int64_t StateSyncer::GetPlayerId(int player_id, bool is_enemy) {
 void StateSyncer::UpdatePlayerStates(
     std::array<player_state::State, 2> &player_states) {
 
+	// Iterating through the players
+	for (int64_t player_id = 0; player_id < player_states.size(); ++player_id) {
+		UpdatePlayerState(static_cast<PlayerId>(player_id),
+		                  player_states[player_id]);
+	}
+
+	// Log the current state
+	LogState();
+}
+
+void StateSyncer::UpdatePlayerState(PlayerId p_player_id,
+                                    player_state::State &player_state) {
 	// Getting all information from the main state
-	auto state_soldiers = state->GetSoldiers();
-	auto state_villagers = state->GetVillagers();
-	auto state_factories = state->GetFactories();
 	auto state_money = state->GetGold();
 	auto *map = state->GetMap();
-
-	// Iterating through the players
-	for (int64_t player_id = 0; player_id < player_states.size(); ++player_id) {
-		// Changing map elements from type state::TerrainType to
-		// player_state::TerrainType
-		std::array<std::array<player_state::TerrainType, MAP_SIZE>, MAP_SIZE>
-		    new_map;
-		// Storing the gold mine locations
-		std::vector<Vec2D> gold_mine_offsets;
-		for (int i = 0; i < map->GetSize(); ++i) {
-			for (int j = 0; j < map->GetSize(); ++j) {
-				auto &new_map_element = new_map[i][j];
-				switch (map->GetTerrainTypeByOffset(i, j)) {
-				case TerrainType::LAND:
-					new_map_element = player_state::TerrainType::LAND;
-					break;
-				case TerrainType::WATER:
-					new_map_element = player_state::TerrainType::WATER;
-					break;
-				// Saving the gold mine locations in a vector to add into player
-				// state
-				case TerrainType::GOLD_MINE:
-					new_map_element = player_state::TerrainType::GOLD_MINE;
-					Vec2D gold_mine;
-					if (static_cast<PlayerId>(player_id) != PlayerId::PLAYER1) {
-						gold_mine = Vec2D(map->GetSize() - 1 - i,
-						                  map->GetSize() - 1 - j);
-					} else {
-						gold_mine = Vec2D(i, j);
-					}
-					gold_mine_offsets.push_back(gold_mine);
-					break;
+	auto player_id = static_cast<int64_t>(p_player_id);
+
+	// Changing map elements from type state::TerrainType to
+	// player_state::TerrainType
+	std::array<std::array<player_state::TerrainType, MAP_SIZE>, MAP_SIZE>
+	    new_map;
+	// Storing the gold mine locations
+	std::vector<Vec2D> gold_mine_offsets;
+	for (int i = 0; i < map->GetSize(); ++i) {
+		for (int j = 0; j < map->GetSize(); ++j) {
+			auto &new_map_element = new_map[i][j];
+			switch (map->GetTerrainTypeByOffset(i, j)) {
+			case TerrainType::LAND:
+				new_map_element = player_state::TerrainType::LAND;
+				break;
+			case TerrainType::WATER:
+				new_map_element = player_state::TerrainType::WATER;
+				break;
+			// Saving the gold mine locations in a vector to add into player
+			// state
+			case TerrainType::GOLD_MINE:
+				new_map_element = player_state::TerrainType::GOLD_MINE;
+				Vec2D gold_mine;
+				if (static_cast<PlayerId>(player_id) != PlayerId::PLAYER1) {
+					gold_mine = Vec2D(map->GetSize() - 1 - i,
+					                  map->GetSize() - 1 - j);
+				} else {
+					gold_mine = Vec2D(i, j);
 				}
+				gold_mine_offsets.push_back(gold_mine);
+				break;
 			}
 		}
+	}
 
-		// Creating the enemy id
-		int64_t enemy_id = GetPlayerId(player_id, true);
-
-		// Assinging the default values and positions of the new player states
-		AssignSoldierAttributes(player_id, player_states[player_id].soldiers,
-		                        false);
-		AssignSoldierAttributes(enemy_id,
-		                        player_states[player_id].enemy_soldiers, true);
-		AssignVillagerAttributes(player_id, player_states[player_id].villagers,
-		                         false);
-		AssignVillagerAttributes(
-		    enemy_id, player_states[player_id].enemy_villagers, true);
-		AssignFactoryAttributes(player_id, player_states[player_id].factories,
-		                        false);
-		AssignFactoryAttributes(enemy_id,
-		                        player_states[player_id].enemy_factories, true);
-		// Assigning the gold for each player
-		player_states[player_id].gold = state_money[player_id];
-		// Assigning the map to the player states
-		// Copying data for player 1
-		if (static_cast<PlayerId>(player_id) == PlayerId::PLAYER1) {
-			for (int i = 0; i < map->GetSize(); ++i) {
-				std::copy(new_map[i].begin(), new_map[i].end(),
-				          player_states[player_id].map[i].begin());
-			}
+	// Creating the enemy id
+	int64_t enemy_id = GetPlayerId(player_id, true);
+
+	// Assinging the default values and positions of the new player states
+	AssignSoldierAttributes(player_id, player_state.soldiers, false);
+	AssignSoldierAttributes(enemy_id, player_state.enemy_soldiers, true);
+	AssignVillagerAttributes(player_id, player_state.villagers, false);
+	AssignVillagerAttributes(enemy_id, player_state.enemy_villagers, true);
+	AssignFactoryAttributes(player_id, player_state.factories, false);
+	AssignFactoryAttributes(enemy_id, player_state.enemy_factories, true);
+	// Assigning the gold for each player
+	player_state.gold = state_money[player_id];
+	// Assigning the map to the player states
+	// Copying data for player 1
+	if (static_cast<PlayerId>(player_id) == PlayerId::PLAYER1) {
+		for (int i = 0; i < map->GetSize(); ++i) {
+			std::copy(new_map[i].begin(), new_map[i].end(),
+			          player_state.map[i].begin());
 		}
-		// Moving data the map into player 2's state to save space
-		else {
-			// Flipping the map
-			for (int i = 0; i < map->GetSize(); ++i) {
-				for (int j = 0; j < map->GetSize(); ++j) {
-					player_states[player_id].map[i][j] =
-					    new_map[map->GetSize() - 1 - i][map->GetSize() - 1 - j];
-				}
+	}
+	// Moving data the map into player 2's state to save space
+	else {
+		// Flipping the map
+		for (int i = 0; i < map->GetSize(); ++i) {
+			for (int j = 0; j < map->GetSize(); ++j) {
+				player_state.map[i][j] =
+				    new_map[map->GetSize() - 1 - i][map->GetSize() - 1 - j];
 			}
 		}
-
-		// Assigning the gold mine_locations to the player state
-		if (static_cast<PlayerId>(player_id) == PlayerId::PLAYER1) {
-			player_states[player_id].gold_mine_offsets =
-			    std::move(gold_mine_offsets);
-		} else {
-			// Reverse the list for Player2
-			std::reverse(gold_mine_offsets.begin(), gold_mine_offsets.end());
-			player_states[player_id].gold_mine_offsets =
-			    std::move(gold_mine_offsets);
-		}
 	}
 
-	// Log the current state
-	logger->LogState();
+	// Assigning the gold mine_locations to the player state
+	if (static_cast<PlayerId>(player_id) == PlayerId::PLAYER1) {
+		player_state.gold_mine_offsets = std::move(gold_mine_offsets);
+	} else {
+		// Reverse the list for Player2
+		std::reverse(gold_mine_offsets.begin(), gold_mine_offsets.end());
+		player_state.gold_mine_offsets = std::move(gold_mine_offsets);
+	}
 }
 
+void StateSyncer::LogState() { logger->LogState(); }
+
 std::array<int64_t, 2> StateSyncer::GetScores(bool game_over) {
 	return state->GetScores(game_over);
 }
@@ -146,6 +144,12 @@ int64_t StateSyncer::GetInterestingness() {
 	return state->GetInterestingness();
 }
 
+int64_t StateSyncer::GetActorBytes() { return state->GetActorBytes(); }
+
+int64_t StateSyncer::GetPathCacheBytes() {
+	return state->GetPathCacheBytes();
+}
+
 DoubleVec2D StateSyncer::FlipPosition(const Map *map, DoubleVec2D position) {
 	auto map_size = map->GetSize();
 	auto map_element_size = map->GetElementSize();
@@ -2,6 +2,7 @@
 #include "drivers/main_driver.h"
 #include "drivers/shared_memory_utils/shared_memory_player.h"
 #include "drivers/timer.h"
+#include "drivers/tracer.h"
 #include "drivers/transfer_state.h"
 #include "logger/mocks/logger_mock.h"
 #include "state/mocks/state_syncer_mock.h"
@@ -27,6 +28,8 @@ class MainDriverTest : public testing::Test {
 
 	const static int time_limit_ms;
 
+	const static int turn_time_limit_ms;
+
 	const static int turn_instruction_limit;
 
 	const static int game_instruction_limit;
@@ -34,7 +37,9 @@ class MainDriverTest : public testing::Test {
 	// Returns a new mock main driver
 	static unique_ptr<MainDriver>
 	CreateMockMainDriver(unique_ptr<StateSyncerMock> state_syncer_mock,
-	                     unique_ptr<LoggerMock> v_logger) {
+	                     unique_ptr<LoggerMock> v_logger,
+	                     bool run_players_concurrently = false,
+	                     int game_time_limit_ms = time_limit_ms) {
 		vector<unique_ptr<SharedMemoryMain>> shm;
 		for (const auto &shm_name : shared_memory_names) {
 			// Remove shm if it already exists
@@ -46,8 +51,10 @@ class MainDriverTest : public testing::Test {
 
 		return unique_ptr<MainDriver>(new MainDriver(
 		    move(state_syncer_mock), move(shm), turn_instruction_limit,
-		    game_instruction_limit, num_turns, Timer::Interval(time_limit_ms),
-		    move(v_logger), "game.log"));
+		    game_instruction_limit, num_turns,
+		    Timer::Interval(game_time_limit_ms),
+		    Timer::Interval(turn_time_limit_ms), move(v_logger), "game.log",
+		    run_players_concurrently));
 	}
 
   public:
@@ -58,6 +65,7 @@ const vector<string> MainDriverTest::shared_memory_names = {"ShmTest1",
                                                             "ShmTest2"};
 const int MainDriverTest::num_turns = pow(10, 4);
 const int MainDriverTest::time_limit_ms = 1000;
+const int MainDriverTest::turn_time_limit_ms = 100;
 const int MainDriverTest::turn_instruction_limit = 5;
 const int MainDriverTest::game_instruction_limit = 10;
 
@@ -72,7 +80,10 @@ TEST_F(MainDriverTest, CleanRunByScore) {
 
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns);
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(num_turns);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(num_turns + 1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * num_turns);
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns);
 
 	// Expect scores and interestingness calls
 	EXPECT_CALL(*state_syncer_mock, GetScores(_))
@@ -87,6 +98,8 @@ TEST_F(MainDriverTest, CleanRunByScore) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
 	    .Times(num_turns);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -121,6 +134,77 @@ TEST_F(MainDriverTest, CleanRunByScore) {
 		EXPECT_EQ(result.score, 10);
 		EXPECT_EQ(result.status, PlayerResult::Status::NORMAL);
 	}
+
+	// Every phase was timed every turn, each player's state twice over
+	auto turn_profile = driver->GetTurnProfile();
+	ASSERT_EQ(turn_profile.size(), NUM_TURN_PHASES);
+	for (size_t i = 0; i < NUM_TURN_PHASES; ++i) {
+		auto const &phase_latencies = turn_profile[i];
+		EXPECT_EQ(phase_latencies.phase, TURN_PHASE_NAMES[i]);
+		auto phase = static_cast<TurnPhase>(i);
+		auto per_player = phase == TurnPhase::UPDATE_PLAYER_STATE ||
+		                  phase == TurnPhase::TO_TRANSFER_STATE;
+		EXPECT_EQ(phase_latencies.count,
+		          per_player ? 2 * num_turns : num_turns);
+		EXPECT_LE(phase_latencies.p50_ns, phase_latencies.p99_ns);
+		EXPECT_LE(phase_latencies.p99_ns, phase_latencies.max_ns);
+	}
+}
+
+// Same as CleanRunByScore, but with both players running at the same time
+TEST_F(MainDriverTest, CleanRunByScoreConcurrent) {
+	unique_ptr<StateSyncerMock> state_syncer_mock(new StateSyncerMock());
+
+	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns);
+	EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(num_turns);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * num_turns);
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns);
+
+	EXPECT_CALL(*state_syncer_mock, GetScores(_))
+	    .WillOnce(Return(array<int64_t, 2>{10, 20}));
+	EXPECT_CALL(*state_syncer_mock, GetInterestingness()).WillOnce(Return(69));
+
+	// Instruction counts are still logged once per player per turn
+	unique_ptr<LoggerMock> v_logger(new LoggerMock());
+
+	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER1, _))
+	    .Times(num_turns);
+	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
+	    .Times(num_turns);
+	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
+	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
+
+	driver =
+	    CreateMockMainDriver(move(state_syncer_mock), move(v_logger), true);
+
+	GameResult game_result;
+	thread main_runner([this, &game_result] { game_result = driver->Start(); });
+
+	vector<thread> player_runners;
+	for (int i = 0; i < 2; ++i) {
+		ostringstream command_stream;
+		command_stream << "./main_driver_test_player " << shared_memory_names[i]
+		               << ' ' << time_limit_ms << ' ' << num_turns << ' '
+		               << turn_instruction_limit;
+		string command = command_stream.str();
+		player_runners.emplace_back(
+		    [command] { EXPECT_EQ(system(command.c_str()), 0); });
+	}
+
+	for (auto &runner : player_runners) {
+		runner.join();
+	}
+	main_runner.join();
+
+	EXPECT_EQ(game_result.winner, GameResult::Winner::PLAYER2);
+	EXPECT_EQ(game_result.win_type, GameResult::WinType::SCORE);
+	for (auto const &result : game_result.player_results) {
+		EXPECT_EQ(result.status, PlayerResult::Status::NORMAL);
+	}
 }
 
 TEST_F(MainDriverTest, Player1WinByDeathmatch) {
@@ -129,8 +213,10 @@ TEST_F(MainDriverTest, Player1WinByDeathmatch) {
 
 	// The game will end halfway in, with IsGameOver returning true
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns / 2);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_))
-	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * (num_turns / 2));
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns / 2);
 
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_))
 	    .Times(1)
@@ -156,6 +242,8 @@ TEST_F(MainDriverTest, Player1WinByDeathmatch) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
 	    .Times(num_turns / 2);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -198,8 +286,10 @@ TEST_F(MainDriverTest, Player2WinByDeathmatch) {
 
 	// The game will end halfway in, with IsGameOver returning true
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns / 2);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_))
-	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * (num_turns / 2));
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns / 2);
 
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_))
 	    .Times(1)
@@ -225,6 +315,8 @@ TEST_F(MainDriverTest, Player2WinByDeathmatch) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
 	    .Times(num_turns / 2);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -267,8 +359,10 @@ TEST_F(MainDriverTest, TieByDeathmatch) {
 
 	// The game will end halfway in, with IsGameOver returning true
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns / 2);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_))
-	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * (num_turns / 2));
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns / 2);
 
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_))
 	    .Times(1)
@@ -294,6 +388,8 @@ TEST_F(MainDriverTest, TieByDeathmatch) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
 	    .Times(num_turns / 2);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -331,15 +427,17 @@ TEST_F(MainDriverTest, TieByDeathmatch) {
 }
 
 // Tests for case when player exits/crashes before game ends
-// Main driver should simply time out and exit cleanly
+// Main driver should time out the turns and exit cleanly
 TEST_F(MainDriverTest, EarlyPlayerExit) {
 	unique_ptr<StateSyncerMock> state_syncer_mock(new StateSyncerMock());
 
 	// Expect only half the number of turns to be run
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns / 2);
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(num_turns / 2);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_))
-	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * (num_turns / 2));
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns / 2);
 
 	// Get Scores and interestingness WILL NOT be called
 	EXPECT_CALL(*state_syncer_mock, GetScores(_)).Times(0);
@@ -352,6 +450,8 @@ TEST_F(MainDriverTest, EarlyPlayerExit) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
 	    .Times(num_turns / 2 + 1);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -375,14 +475,71 @@ TEST_F(MainDriverTest, EarlyPlayerExit) {
 	}
 	main_runner.join();
 
-	EXPECT_EQ(game_result.winner, GameResult::Winner::NONE);
-	EXPECT_EQ(game_result.win_type, GameResult::WinType::NONE);
-	// Results are undefined as game didn't complete
+	// Both players overran their turn, and forfeited the game
+	EXPECT_EQ(game_result.winner, GameResult::Winner::TIE);
+	EXPECT_EQ(game_result.win_type, GameResult::WinType::TIMEOUT);
 	for (auto result : game_result.player_results) {
-		EXPECT_EQ(result.status, PlayerResult::Status::UNDEFINED);
+		EXPECT_EQ(result.status, PlayerResult::Status::EXCEEDED_TURN_DURATION);
 	}
 }
 
+// Test for when a player doesn't finish its turn in time
+// The player should forfeit the game, and the opponent should win
+TEST_F(MainDriverTest, TurnDurationExceeded) {
+	unique_ptr<StateSyncerMock> state_syncer_mock(new StateSyncerMock());
+
+	// Expect only half the number of turns to be run
+	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns / 2);
+	EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(num_turns / 2);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * (num_turns / 2));
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns / 2);
+
+	// Get Scores and interestingness WILL NOT be called
+	EXPECT_CALL(*state_syncer_mock, GetScores(_)).Times(0);
+	EXPECT_CALL(*state_syncer_mock, GetInterestingness()).Times(0);
+
+	unique_ptr<LoggerMock> v_logger(new LoggerMock());
+	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER1, _))
+	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
+	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
+	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
+
+	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
+
+	GameResult game_result;
+	thread main_runner([this, &game_result] { game_result = driver->Start(); });
+
+	// Player 1 plays through, while player 2 stops responding halfway in
+	vector<thread> player_runners;
+	for (int i = 0; i < 2; ++i) {
+		ostringstream command_stream;
+		command_stream << "./main_driver_test_player " << shared_memory_names[i]
+		               << ' ' << time_limit_ms << ' '
+		               << (i == 0 ? num_turns : num_turns / 2) << ' '
+		               << turn_instruction_limit;
+		string command = command_stream.str();
+		player_runners.emplace_back(
+		    [command] { EXPECT_EQ(system(command.c_str()), 0); });
+	}
+
+	// The game must be over well before the game timer runs out
+	main_runner.join();
+	for (auto &runner : player_runners) {
+		runner.join();
+	}
+
+	EXPECT_EQ(game_result.winner, GameResult::Winner::PLAYER1);
+	EXPECT_EQ(game_result.win_type, GameResult::WinType::TIMEOUT);
+	EXPECT_EQ(game_result.player_results[1].status,
+	          PlayerResult::Status::EXCEEDED_TURN_DURATION);
+}
+
 // Test for when a player exceeds game instruction limit
 // Main driver should mark the player as having exceeded instruction limit
 TEST_F(MainDriverTest, InstructionLimitReached) {
@@ -391,8 +548,10 @@ TEST_F(MainDriverTest, InstructionLimitReached) {
 	// Expect only half the turns to run
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(num_turns / 2);
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(num_turns / 2);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_))
-	    .Times(num_turns / 2 + 1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+	    .Times(2 * (num_turns / 2));
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns / 2);
 
 	// Get Scores and interestingness WILL NOT be called
 	EXPECT_CALL(*state_syncer_mock, GetScores(_)).Times(0);
@@ -404,6 +563,8 @@ TEST_F(MainDriverTest, InstructionLimitReached) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _))
 	    .Times(num_turns / 2 + 1);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -431,6 +592,8 @@ TEST_F(MainDriverTest, InstructionLimitReached) {
 	for (const auto &shm_name : shared_memory_names) {
 		SharedMemoryPlayer shm_player(shm_name);
 		SharedBuffer *buf = shm_player.GetBuffer();
+		while (!buf->is_player_running)
+			;
 		buf->instruction_counter = game_instruction_limit;
 		buf->is_player_running = false;
 	}
@@ -439,6 +602,8 @@ TEST_F(MainDriverTest, InstructionLimitReached) {
 	for (const auto &shm_name : shared_memory_names) {
 		SharedMemoryPlayer shm_player(shm_name);
 		SharedBuffer *buf = shm_player.GetBuffer();
+		while (!buf->is_player_running)
+			;
 		buf->instruction_counter = game_instruction_limit + 1;
 		buf->is_player_running = false;
 	}
@@ -462,7 +627,9 @@ TEST_F(MainDriverTest, Cancellation) {
 	// Expect only one turn to run
 	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(1);
 	EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(1);
-	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(2);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _)).Times(2);
+	EXPECT_CALL(*state_syncer_mock, LogState()).Times(1);
 
 	// Get Scores and interestingness WILL NOT be called
 	EXPECT_CALL(*state_syncer_mock, GetScores(_)).Times(0);
@@ -472,6 +639,8 @@ TEST_F(MainDriverTest, Cancellation) {
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER1, _)).Times(1);
 	EXPECT_CALL(*v_logger, LogInstructionCount(PlayerId::PLAYER2, _)).Times(1);
 	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
 	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
 
 	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger));
@@ -503,3 +672,73 @@ TEST_F(MainDriverTest, Cancellation) {
 		EXPECT_EQ(result.status, PlayerResult::Status::UNDEFINED);
 	}
 }
+
+// Test for the game timer running out while both players are in their turn
+// Every player still running should be marked as timed out
+TEST_F(MainDriverTest, GameTimeoutConcurrent) {
+	unique_ptr<StateSyncerMock> state_syncer_mock(new StateSyncerMock());
+
+	// No turn is completed
+	EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _)).Times(0);
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+	EXPECT_CALL(*state_syncer_mock, GetScores(_)).Times(0);
+	EXPECT_CALL(*state_syncer_mock, GetInterestingness()).Times(0);
+
+	unique_ptr<LoggerMock> v_logger(new LoggerMock());
+	EXPECT_CALL(*v_logger, LogInstructionCount(_, _)).Times(0);
+	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
+	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
+
+	// The game timer runs out well within a turn
+	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger),
+	                              true, turn_time_limit_ms / 4);
+
+	// Neither player ever finishes its first turn
+	auto game_result = driver->Start();
+
+	EXPECT_EQ(game_result.winner, GameResult::Winner::NONE);
+	EXPECT_EQ(game_result.win_type, GameResult::WinType::TIMEOUT);
+	for (auto result : game_result.player_results) {
+		EXPECT_EQ(result.status, PlayerResult::Status::TIMEOUT);
+	}
+}
+
+// Test for a game that ends partway through a turn while it's traced
+// The turn's span and the players' turn spans should all be closed
+TEST_F(MainDriverTest, EarlyEndClosesTraceSpans) {
+	unique_ptr<StateSyncerMock> state_syncer_mock(new StateSyncerMock());
+	EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+
+	unique_ptr<LoggerMock> v_logger(new LoggerMock());
+	EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+	EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+	EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
+	EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
+
+	driver = CreateMockMainDriver(move(state_syncer_mock), move(v_logger),
+	                              true, turn_time_limit_ms / 4);
+
+	auto &tracer = Tracer::GetInstance();
+	tracer.Enable("test");
+	driver->Start();
+	tracer.Disable();
+
+	ostringstream events_stream;
+	tracer.WriteEvents(events_stream);
+	auto events = events_stream.str();
+	auto count_of = [&events](const string &part) {
+		size_t count = 0;
+		for (auto pos = events.find(part); pos != string::npos;
+		     pos = events.find(part, pos + 1)) {
+			++count;
+		}
+		return count;
+	};
+
+	EXPECT_EQ(count_of(R"("name":"TURN","ph":"B")"), 1);
+	EXPECT_EQ(count_of(R"("name":"TURN","ph":"E")"), 1);
+	EXPECT_EQ(count_of(R"("ph":"b")"), 2);
+	EXPECT_EQ(count_of(R"("ph":"e")"), 2);
+}
@@ -38,13 +38,14 @@ int main(int argc, char *argv[]) {
 	// Run player updates for num_turns
 	for (int i = 0; i < num_turns && !is_time_over; ++i) {
 		// cout << i << endl;
-		while (!buf->is_player_running && !is_time_over)
-			;
+		buf->Wait([buf, &is_time_over] {
+			return buf->is_player_running || is_time_over;
+		});
 		if (i < num_turns / 2)
 			buf->instruction_counter = turn_instruction_limit;
 		else
 			buf->instruction_counter = turn_instruction_limit + 1;
-		buf->is_player_running = false;
+		buf->SetPlayerRunning(false);
 	}
 
 	return 0;
@@ -0,0 +1,130 @@
+#include "drivers/main_driver.h"
+#include "drivers/match_engine.h"
+#include "drivers/timer.h"
+#include "drivers/transfer_state.h"
+#include "logger/mocks/logger_mock.h"
+#include "state/mocks/state_syncer_mock.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace ::testing;
+using namespace std;
+using namespace state;
+using namespace drivers;
+
+class MatchEngineTest : public testing::Test {
+  protected:
+	const static int num_turns;
+
+	const static int time_limit_ms;
+
+	const static int turn_time_limit_ms;
+
+	const static int turn_instruction_limit;
+
+	const static int game_instruction_limit;
+
+	// Returns a main driver for a game that ends by score after num_turns
+	static unique_ptr<MainDriver>
+	CreateMainDriver(const array<string, 2> &shared_memory_names) {
+		unique_ptr<StateSyncerMock> state_syncer_mock(new StateSyncerMock());
+		EXPECT_CALL(*state_syncer_mock, UpdateMainState(_, _))
+		    .Times(num_turns);
+		EXPECT_CALL(*state_syncer_mock, IsGameOver(_)).Times(num_turns);
+		EXPECT_CALL(*state_syncer_mock, UpdatePlayerStates(_)).Times(1);
+		EXPECT_CALL(*state_syncer_mock, UpdatePlayerState(_, _))
+		    .Times(2 * num_turns);
+		EXPECT_CALL(*state_syncer_mock, LogState()).Times(num_turns);
+		EXPECT_CALL(*state_syncer_mock, GetScores(_))
+		    .WillOnce(Return(array<int64_t, 2>{10, 20}));
+		EXPECT_CALL(*state_syncer_mock, GetInterestingness())
+		    .WillOnce(Return(69));
+
+		unique_ptr<LoggerMock> v_logger(new LoggerMock());
+		EXPECT_CALL(*v_logger, LogInstructionCount(_, _)).Times(2 * num_turns);
+		EXPECT_CALL(*v_logger, LogFinalGameParams(_, _, _)).Times(1);
+		EXPECT_CALL(*v_logger, LogTurnProfile(_)).Times(1);
+		EXPECT_CALL(*v_logger, BeginGame(_)).Times(1);
+		EXPECT_CALL(*v_logger, WriteGame(_)).Times(1);
+
+		vector<unique_ptr<SharedMemoryMain>> shm;
+		for (const auto &shm_name : shared_memory_names) {
+			boost::interprocess::shared_memory_object::remove(shm_name.c_str());
+			shm.emplace_back(new SharedMemoryMain(shm_name, false, false, 0,
+			                                      transfer_state::State()));
+		}
+
+		return unique_ptr<MainDriver>(new MainDriver(
+		    move(state_syncer_mock), move(shm), turn_instruction_limit,
+		    game_instruction_limit, num_turns, Timer::Interval(time_limit_ms),
+		    Timer::Interval(turn_time_limit_ms), move(v_logger), "game.log"));
+	}
+
+	// Runs the player of a game in a process of its own
+	static thread StartPlayer(const string &shm_name) {
+		ostringstream command_stream;
+		command_stream << "./main_driver_test_player " << shm_name << ' '
+		               << time_limit_ms << ' ' << num_turns << ' '
+		               << turn_instruction_limit;
+		string command = command_stream.str();
+		return thread([command] { EXPECT_EQ(system(command.c_str()), 0); });
+	}
+};
+
+const int MatchEngineTest::num_turns = 1000;
+const int MatchEngineTest::time_limit_ms = 5000;
+const int MatchEngineTest::turn_time_limit_ms = 1000;
+const int MatchEngineTest::turn_instruction_limit = 5;
+const int MatchEngineTest::game_instruction_limit = 10;
+
+// Two games run side by side, both driven by the one engine thread
+TEST_F(MatchEngineTest, RunsGamesOnOneThread) {
+	auto shared_memory_names = array<array<string, 2>, 2>{
+	    {{"EngineShmTest1", "EngineShmTest2"},
+	     {"EngineShmTest3", "EngineShmTest4"}}};
+
+	MatchEngine engine;
+	thread engine_runner([&engine] { engine.Run(); });
+
+	vector<unique_ptr<MainDriver>> drivers;
+	array<GameResult, 2> game_results;
+	atomic<int> num_games_done(0);
+	for (int i = 0; i < 2; ++i) {
+		drivers.push_back(CreateMainDriver(shared_memory_names[i]));
+		auto &game_result = game_results[i];
+		engine.Add(drivers.back().get(),
+		           [&game_result, &num_games_done](const GameResult &result) {
+			           game_result = result;
+			           num_games_done++;
+		           });
+	}
+
+	vector<thread> player_runners;
+	for (const auto &names : shared_memory_names) {
+		for (const auto &shm_name : names) {
+			player_runners.push_back(StartPlayer(shm_name));
+		}
+	}
+	for (auto &runner : player_runners) {
+		runner.join();
+	}
+
+	// The games are wrapped up after the players are done
+	while (num_games_done < 2) {
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+	engine.Stop();
+	engine_runner.join();
+
+	EXPECT_EQ(num_games_done, 2);
+	for (const auto &game_result : game_results) {
+		EXPECT_EQ(game_result.winner, GameResult::Winner::PLAYER2);
+		EXPECT_EQ(game_result.win_type, GameResult::WinType::SCORE);
+		for (const auto &result : game_result.player_results) {
+			EXPECT_EQ(result.status, PlayerResult::Status::NORMAL);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#include "drivers/memory_account.h"
+#include "gtest/gtest.h"
+#include <sstream>
+
+using namespace std;
+using namespace drivers;
+
+// Every subsystem is in the report, in order, and keeps its peak as it shrinks
+TEST(MemoryAccountTest, CurrentAndPeak) {
+	MemoryAccount memory_account;
+	memory_account.Set(MemorySubsystem::ACTORS, 100);
+	memory_account.Set(MemorySubsystem::ACTORS, 300);
+	memory_account.Set(MemorySubsystem::ACTORS, 200);
+	memory_account.Set(MemorySubsystem::GAME_LOG, 50);
+	EXPECT_EQ(memory_account.Get(MemorySubsystem::ACTORS), 200);
+
+	auto report = memory_account.GetReport();
+	ASSERT_EQ(report.size(), NUM_MEMORY_SUBSYSTEMS);
+	EXPECT_EQ(report[0].subsystem, "PATH_CACHE");
+	EXPECT_EQ(report[0].current_bytes, 0);
+	EXPECT_EQ(report[1].subsystem, "ACTORS");
+	EXPECT_EQ(report[1].current_bytes, 200);
+	EXPECT_EQ(report[1].peak_bytes, 300);
+	EXPECT_EQ(report[2].peak_bytes, 50);
+
+	auto os = ostringstream{};
+	os << report[1];
+	EXPECT_EQ(os.str(), "ACTORS 200 300");
+
+	// A new game starts from nothing
+	memory_account.Reset();
+	EXPECT_EQ(memory_account.GetReport()[1].peak_bytes, 0);
+}
+
+// A player state is counted by what its lists have room for
+TEST(MemoryAccountTest, PlayerStateBytes) {
+	player_state::State state;
+	auto empty_bytes = GetPlayerStateBytes(state);
+	EXPECT_GE(empty_bytes, static_cast<int64_t>(sizeof(player_state::State)));
+
+	state.soldiers.reserve(10);
+	EXPECT_EQ(GetPlayerStateBytes(state) - empty_bytes,
+	          static_cast<int64_t>(10 * sizeof(player_state::Soldier)));
+}
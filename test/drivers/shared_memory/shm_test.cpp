@@ -2,8 +2,11 @@
 #include "drivers/shared_memory_utils/shared_memory_main.h"
 #include "drivers/shared_memory_utils/shared_memory_player.h"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <cstdlib>
+#include <memory>
 #include <stdexcept>
+#include <thread>
 
 using namespace std;
 using namespace drivers;
@@ -56,3 +59,139 @@ TEST(SharedMemoryUtilsTest, InvalidCreate) {
 	    (SharedMemoryMain(shm_name, false, false, 0, transfer_state::State())),
 	    std::exception);
 }
+
+TEST(SharedMemoryUtilsTest, HandoffWakesWaiter) {
+	RemoveShm();
+	SharedMemoryMain shm_main(shm_name, false, false, 0,
+	                          transfer_state::State());
+	SharedBuffer *buf = shm_main.GetBuffer();
+
+	// Hand the turn back and forth, like the main and player drivers do
+	thread player([buf] {
+		for (int i = 0; i < 100; ++i) {
+			buf->Wait([buf] { return bool(buf->is_player_running); });
+			buf->instruction_counter++;
+			buf->SetPlayerRunning(false);
+		}
+	});
+
+	for (int i = 0; i < 100; ++i) {
+		buf->SetPlayerRunning(true);
+		buf->Wait([buf] { return !buf->is_player_running; });
+	}
+	player.join();
+
+	EXPECT_EQ(buf->instruction_counter, 100);
+	EXPECT_EQ(buf->num_waiters, 0);
+}
+
+TEST(SharedMemoryUtilsTest, WaitNoticesUnnotifiedChange) {
+	RemoveShm();
+	SharedMemoryMain shm_main(shm_name, false, false, 0,
+	                          transfer_state::State());
+	SharedBuffer *buf = shm_main.GetBuffer();
+
+	// A flag changed without Notify must still be picked up after a slice
+	atomic_bool is_done(false);
+	thread setter([&is_done] {
+		this_thread::sleep_for(chrono::milliseconds(20));
+		is_done = true;
+	});
+
+	buf->Wait([&is_done] { return bool(is_done); });
+	setter.join();
+
+	EXPECT_TRUE(is_done);
+}
+
+TEST(SharedMemoryUtilsTest, WaitGivesUpAtDeadline) {
+	RemoveShm();
+	SharedMemoryMain shm_main(shm_name, false, false, 0,
+	                          transfer_state::State());
+	SharedBuffer *buf = shm_main.GetBuffer();
+
+	// A condition that never holds must time out, but not before the deadline
+	auto start = chrono::steady_clock::now();
+	auto deadline = start + chrono::milliseconds(20);
+	EXPECT_FALSE(buf->Wait([] { return false; }, deadline));
+	EXPECT_GE(chrono::steady_clock::now(), deadline);
+
+	// One that already holds returns at once
+	EXPECT_TRUE(buf->Wait([] { return true; }, start));
+}
+
+TEST(SharedMemoryUtilsTest, CacheLineLayout) {
+	RemoveShm();
+	SharedMemoryMain shm_main(shm_name, false, false, 0,
+	                          transfer_state::State());
+	SharedBuffer *buf = shm_main.GetBuffer();
+
+	// Control fields must not share cache lines with each other
+	auto line = [](const void *field) {
+		return reinterpret_cast<uintptr_t>(field) / CACHE_LINE_SIZE;
+	};
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(buf) % CACHE_LINE_SIZE, 0);
+	EXPECT_NE(line(&buf->is_player_running), line(&buf->is_game_complete));
+	EXPECT_NE(line(&buf->is_game_complete), line(&buf->instruction_counter));
+	EXPECT_NE(line(&buf->instruction_counter), line(&buf->instruction_limit));
+	EXPECT_NE(line(&buf->instruction_limit), line(&buf->handoff_sequence));
+	EXPECT_NE(line(&buf->handoff_sequence), line(&buf->front_index));
+	EXPECT_NE(line(&buf->front_index), line(&buf->transfer_states));
+
+	EXPECT_GE(SharedMemoryMain::GetSegmentSize(), sizeof(SharedBuffer));
+}
+
+TEST(SharedMemoryUtilsTest, DoubleBufferSwap) {
+	RemoveShm();
+	transfer_state::State initial_state;
+	initial_state.gold = 100;
+	SharedMemoryMain shm_main(shm_name, false, false, 0, initial_state);
+	SharedBuffer *buf = shm_main.GetBuffer();
+
+	// Both copies start out with the initial state
+	EXPECT_EQ(buf->GetFrontTransferState().gold, 100);
+	EXPECT_EQ(buf->GetBackTransferState().gold, 100);
+
+	// Writes to the back copy are only seen by the player after a swap
+	buf->GetBackTransferState().gold = 200;
+	EXPECT_EQ(buf->GetFrontTransferState().gold, 100);
+	buf->SwapTransferStates();
+	EXPECT_EQ(buf->GetFrontTransferState().gold, 200);
+	EXPECT_EQ(buf->GetBackTransferState().gold, 100);
+
+	// The player side sees the same front copy
+	SharedMemoryPlayer shm_player(shm_name);
+	EXPECT_EQ(shm_player.GetBuffer()->GetFrontTransferState().gold, 200);
+}
+
+TEST(SharedMemoryUtilsTest, PathTablesShared) {
+	RemoveShm();
+	auto path_tables = make_unique<player_state::PathTables>();
+	path_tables->distances[1][2] = 3;
+	path_tables->next_offsets[1][2] = 4;
+	SharedMemoryMain shm_main(shm_name, false, false, 0,
+	                          transfer_state::State(), path_tables.get());
+
+	// The player gets its own read only copy, past the buffer's pages
+	SharedMemoryPlayer shm_player(shm_name);
+	auto shared_path_tables = shm_player.GetPathTables();
+	EXPECT_NE(shared_path_tables, path_tables.get());
+	EXPECT_EQ(shared_path_tables->distances[1][2], 3);
+	EXPECT_EQ(shared_path_tables->next_offsets[1][2], 4);
+	EXPECT_GE(SharedMemoryMain::GetSegmentSize(),
+	          SharedMemoryMain::GetPathTablesOffset() +
+	              sizeof(player_state::PathTables));
+}
+
+TEST(SharedMemoryUtilsTest, NoPathTables) {
+	RemoveShm();
+	SharedMemoryMain shm_main(shm_name, false, false, 0,
+	                          transfer_state::State());
+
+	// Without tables, no pair of offsets has a path
+	SharedMemoryPlayer shm_player(shm_name);
+	auto state = player_state::State{};
+	state.path_tables = shm_player.GetPathTables();
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{0, 1}), -1);
+	EXPECT_EQ(state.next_step(Vec2D{0, 0}, Vec2D{0, 1}), Vec2D::null);
+}
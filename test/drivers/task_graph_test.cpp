@@ -0,0 +1,72 @@
+#include "drivers/task_graph.h"
+#include "drivers/task_pool.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+using namespace drivers;
+
+class TaskGraphTest : public testing::Test {
+  protected:
+	// Order in which the tasks ran
+	vector<int> order;
+
+	mutex order_lock;
+
+	// Returns a task that notes when it ran
+	TaskGraph::Function Record(int task) {
+		return [this, task] {
+			lock_guard<mutex> lock(order_lock);
+			order.push_back(task);
+		};
+	}
+
+	// Returns the position of a task in the run order
+	size_t PositionOf(int task) {
+		return find(order.begin(), order.end(), task) - order.begin();
+	}
+};
+
+// Every task runs once per run, after all of its dependencies
+TEST_F(TaskGraphTest, RunsAfterDependencies) {
+	TaskPool pool(3);
+	TaskGraph graph(pool);
+
+	// 0 -> 1, 2 -> 3, and 4 on its own
+	auto first = graph.AddTask(Record(0));
+	auto left = graph.AddTask(Record(1), {first});
+	auto right = graph.AddTask(Record(2), {first});
+	graph.AddTask(Record(3), {left, right});
+	graph.AddTask(Record(4));
+
+	// The same graph can be run over and over
+	for (int run = 0; run < 100; ++run) {
+		order.clear();
+		graph.Run();
+
+		ASSERT_EQ(order.size(), 5);
+		for (int task = 0; task < 5; ++task) {
+			EXPECT_EQ(count(order.begin(), order.end(), task), 1);
+		}
+		EXPECT_LT(PositionOf(0), PositionOf(1));
+		EXPECT_LT(PositionOf(0), PositionOf(2));
+		EXPECT_LT(PositionOf(1), PositionOf(3));
+		EXPECT_LT(PositionOf(2), PositionOf(3));
+	}
+}
+
+// Without workers, tasks run on the caller in the order they were added
+TEST_F(TaskGraphTest, RunsInOrderWithoutWorkers) {
+	TaskPool pool(0);
+	TaskGraph graph(pool);
+
+	auto first = graph.AddTask(Record(0));
+	graph.AddTask(Record(1));
+	graph.AddTask(Record(2), {first});
+
+	graph.Run();
+
+	EXPECT_EQ(order, (vector<int>{0, 1, 2}));
+}
@@ -0,0 +1,106 @@
+#include "drivers/timer_service.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace drivers;
+using namespace std;
+
+const auto tick_duration = chrono::milliseconds(1);
+const int num_slots = 64;
+const int grace_period_ms = 50;
+
+TEST(TimerServiceTest, FiresInDeadlineOrder) {
+	TimerService service(tick_duration, num_slots);
+	mutex order_mutex;
+	vector<int> order;
+
+	// Delays longer than a revolution of the wheel must still fire in order
+	auto delays_ms = vector<int>{90, 10, 150, 40};
+	for (auto delay_ms : delays_ms) {
+		service.Schedule(chrono::milliseconds(delay_ms),
+		                 [&order_mutex, &order, delay_ms] {
+			                 lock_guard<mutex> lock(order_mutex);
+			                 order.push_back(delay_ms);
+		                 });
+	}
+
+	this_thread::sleep_for(chrono::milliseconds(150 + grace_period_ms));
+
+	lock_guard<mutex> lock(order_mutex);
+	EXPECT_EQ(order, (vector<int>{10, 40, 90, 150}));
+}
+
+TEST(TimerServiceTest, DoesNotFireEarly) {
+	TimerService service(tick_duration, num_slots);
+	auto start_time = TimerService::Clock::now();
+	atomic<int64_t> elapsed_ms(-1);
+
+	service.Schedule(chrono::milliseconds(100), [start_time, &elapsed_ms] {
+		elapsed_ms = chrono::duration_cast<chrono::milliseconds>(
+		                 TimerService::Clock::now() - start_time)
+		                 .count();
+	});
+
+	this_thread::sleep_for(chrono::milliseconds(100 + grace_period_ms));
+	EXPECT_GE(elapsed_ms, 100);
+	EXPECT_LT(elapsed_ms, 100 + grace_period_ms);
+}
+
+TEST(TimerServiceTest, DoesNotFireEarlyWithinATick) {
+	// Coarse ticks, with the timer scheduled partway into the first one
+	TimerService service(chrono::milliseconds(50), num_slots);
+	this_thread::sleep_for(chrono::milliseconds(5));
+
+	auto start_time = TimerService::Clock::now();
+	atomic<int64_t> elapsed_ms(-1);
+
+	service.Schedule(chrono::milliseconds(20), [start_time, &elapsed_ms] {
+		elapsed_ms = chrono::duration_cast<chrono::milliseconds>(
+		                 TimerService::Clock::now() - start_time)
+		                 .count();
+	});
+
+	this_thread::sleep_for(chrono::milliseconds(50 + grace_period_ms));
+	EXPECT_GE(elapsed_ms, 20);
+}
+
+TEST(TimerServiceTest, Cancellation) {
+	TimerService service(tick_duration, num_slots);
+	atomic_int count(0);
+
+	auto timer_id =
+	    service.Schedule(chrono::milliseconds(50), [&count] { count++; });
+	service.Schedule(chrono::milliseconds(50), [&count] { count += 10; });
+
+	EXPECT_TRUE(service.Cancel(timer_id));
+	// Cancelling twice does nothing
+	EXPECT_FALSE(service.Cancel(timer_id));
+
+	this_thread::sleep_for(chrono::milliseconds(50 + grace_period_ms));
+	EXPECT_EQ(count, 10);
+}
+
+TEST(TimerServiceTest, CancelWaitsForRunningCallback) {
+	TimerService service(tick_duration, num_slots);
+	atomic_bool is_callback_started(false);
+	atomic_bool is_callback_done(false);
+
+	auto timer_id = service.Schedule(
+	    chrono::milliseconds(0), [&is_callback_started, &is_callback_done] {
+		    is_callback_started = true;
+		    this_thread::sleep_for(chrono::milliseconds(50));
+		    is_callback_done = true;
+	    });
+
+	while (!is_callback_started) {
+		this_thread::yield();
+	}
+
+	// The callback already started, so it can't be cancelled, but Cancel
+	// must not return before it's done
+	EXPECT_FALSE(service.Cancel(timer_id));
+	EXPECT_TRUE(is_callback_done);
+}
@@ -0,0 +1,96 @@
+#include "drivers/tracer.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace std;
+using namespace drivers;
+
+class TracerTest : public testing::Test {
+  protected:
+	Tracer &tracer = Tracer::GetInstance();
+
+	// Tracing is process wide, so it's left off for the other tests
+	void TearDown() override { tracer.Disable(); }
+
+	// Returns the number of times a string is in another
+	static size_t CountOf(const string &text, const string &part) {
+		size_t count = 0;
+		for (auto pos = text.find(part); pos != string::npos;
+		     pos = text.find(part, pos + 1)) {
+			++count;
+		}
+		return count;
+	}
+};
+
+// Nothing is recorded until tracing is enabled
+TEST_F(TracerTest, OffByDefault) {
+	tracer.Begin("IGNORED");
+	tracer.End("IGNORED");
+
+	tracer.Enable("test");
+	tracer.Instant("KEPT");
+	tracer.Disable();
+	tracer.Instant("IGNORED");
+
+	ostringstream events;
+	tracer.WriteEvents(events);
+	EXPECT_EQ(CountOf(events.str(), "IGNORED"), 0);
+	EXPECT_EQ(CountOf(events.str(), R"("name":"KEPT","ph":"i")"), 1);
+	EXPECT_EQ(CountOf(events.str(), R"("args":{"name":"test"})"), 1);
+}
+
+// Events of every thread, and of other processes, end up in one trace
+TEST_F(TracerTest, WritesTrace) {
+	tracer.Enable("main");
+	{
+		TraceScope trace_scope("OUTER");
+		tracer.AsyncBegin("TURN", 7);
+		thread([] { TraceScope trace_scope("WORKER"); }).join();
+		tracer.AsyncEnd("TURN", 7);
+	}
+
+	// Another process's events, written the way it would
+	auto event_file_name = string("tracer_test.trace");
+	{
+		ofstream event_file(event_file_name);
+		event_file << R"({"name":"PLAYER","ph":"i","ts":1.000,"pid":1,)"
+		           << R"("tid":1,"s":"t"},)" << '\n';
+	}
+
+	ostringstream trace;
+	tracer.WriteTrace(trace, {event_file_name, "missing.trace"});
+	remove(event_file_name.c_str());
+
+	auto text = trace.str();
+	EXPECT_EQ(text.find(R"({"traceEvents":[)"), 0);
+	EXPECT_EQ(text.substr(text.size() - 4), "\n]}\n");
+	EXPECT_EQ(CountOf(text, R"("ph":"B")"), 2);
+	EXPECT_EQ(CountOf(text, R"("ph":"E")"), 2);
+	EXPECT_EQ(CountOf(text, R"("cat":"game","id":7)"), 2);
+	EXPECT_EQ(CountOf(text, R"("name":"PLAYER")"), 1);
+
+	// The worker is a thread of its own, and every event but the last is
+	// followed by a comma
+	EXPECT_NE(text.find(R"("name":"WORKER","ph":"B")"), string::npos);
+	EXPECT_EQ(CountOf(text, "},\n"), 7);
+}
+
+// A thread that records too much drops its latest events, and says so
+TEST_F(TracerTest, DropsWhenFull) {
+	tracer.Enable("test");
+	thread([this] {
+		for (int i = 0; i < (1 << 16) + 10; ++i) {
+			tracer.Instant("SPAM");
+		}
+	}).join();
+
+	ostringstream events;
+	tracer.WriteEvents(events);
+	EXPECT_EQ(CountOf(events.str(), "SPAM"), 1 << 16);
+	EXPECT_EQ(CountOf(events.str(), "10 events dropped"), 1);
+}
@@ -0,0 +1,103 @@
+#include "drivers/perf_counters.h"
+#include "drivers/turn_profiler.h"
+#include "gtest/gtest.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+using namespace drivers;
+
+// Percentiles are rounded up to the end of their bucket, by less than an
+// eighth, and never past the longest latency
+TEST(LatencyHistogramTest, Percentiles) {
+	LatencyHistogram histogram;
+	EXPECT_EQ(histogram.GetPercentile(50), nanoseconds(0));
+
+	// 1us to 100us
+	for (int i = 1; i <= 100; ++i) {
+		histogram.Record(microseconds(i));
+	}
+	EXPECT_EQ(histogram.GetCount(), 100);
+	EXPECT_EQ(histogram.GetMax(), microseconds(100));
+
+	auto p50 = histogram.GetPercentile(50);
+	EXPECT_GE(p50, microseconds(50));
+	EXPECT_LT(p50, microseconds(50) * 9 / 8);
+
+	auto p99 = histogram.GetPercentile(99);
+	EXPECT_GE(p99, microseconds(99));
+	EXPECT_LE(p99, microseconds(100));
+	EXPECT_EQ(histogram.GetPercentile(100), microseconds(100));
+}
+
+// Short latencies get a bucket each, and huge ones still fit
+TEST(LatencyHistogramTest, Extremes) {
+	LatencyHistogram histogram;
+	for (int i = 0; i < 8; ++i) {
+		histogram.Record(nanoseconds(i));
+	}
+	EXPECT_EQ(histogram.GetPercentile(50), nanoseconds(3));
+
+	histogram.Record(hours(24 * 365));
+	EXPECT_EQ(histogram.GetPercentile(100), hours(24 * 365));
+
+	// Clocks can't go back, but a negative latency counts as none
+	histogram.Record(nanoseconds(-5));
+	EXPECT_EQ(histogram.GetPercentile(0), nanoseconds(0));
+}
+
+// Only phases that were timed are in the profile, in phase order
+TEST(TurnProfilerTest, Profile) {
+	TurnProfiler turn_profiler;
+	EXPECT_TRUE(turn_profiler.GetProfile().empty());
+
+	turn_profiler.Record(TurnPhase::TURN, milliseconds(2));
+	turn_profiler.Record(TurnPhase::LOG_STATE, microseconds(5));
+	turn_profiler.Record(TurnPhase::TURN, milliseconds(1));
+
+	auto turn_profile = turn_profiler.GetProfile();
+	ASSERT_EQ(turn_profile.size(), 2);
+	EXPECT_EQ(turn_profile[0].phase, "LOG_STATE");
+	EXPECT_EQ(turn_profile[0].count, 1);
+	EXPECT_EQ(turn_profile[0].max_ns, 5000);
+	EXPECT_EQ(turn_profile[1].phase, "TURN");
+	EXPECT_EQ(turn_profile[1].count, 2);
+	EXPECT_EQ(turn_profile[1].max_ns, 2000000);
+	EXPECT_EQ(turn_profile[1].p99_ns, 2000000);
+}
+
+// Hardware events are counted where the kernel allows it, and the turn gets
+// those of its phases but not the overlapping post simulation work
+TEST(TurnProfilerTest, CountsEvents) {
+	TurnProfiler turn_profiler(true);
+	auto turn_start = TurnProfiler::Clock::now();
+
+	auto mark = turn_profiler.GetMark();
+	volatile int64_t sum = 0;
+	for (int i = 0; i < 100000; ++i) {
+		sum += i;
+	}
+	mark = turn_profiler.RecordSince(TurnPhase::UPDATE_MAIN_STATE, mark);
+	turn_profiler.RecordSince(TurnPhase::POST_SIMULATION, mark);
+	turn_profiler.RecordTurn(turn_start);
+
+	auto is_counted = PerfCounters::GetThreadCounters().IsOpen();
+	EXPECT_EQ(mark.has_counters, is_counted);
+	auto turn_profile = turn_profiler.GetProfile();
+	ASSERT_EQ(turn_profile.size(), 3);
+	for (auto const &phase_latencies : turn_profile) {
+		EXPECT_EQ(phase_latencies.has_counters, is_counted);
+	}
+	if (is_counted) {
+		auto const &update = turn_profile[0].counters;
+		auto const &turn = turn_profile[2].counters;
+		EXPECT_GT(update.instructions, 100000);
+		EXPECT_GT(update.cycles, 0);
+		EXPECT_EQ(turn.instructions, update.instructions);
+		EXPECT_EQ(turn.branch_misses, update.branch_misses);
+	}
+
+	// Without counting, marks only have the time
+	TurnProfiler timing_profiler;
+	EXPECT_FALSE(timing_profiler.GetMark().has_counters);
+}
@@ -4,6 +4,7 @@
 #include "player_code/test/player_code_test_0.h"
 #include "player_code/test/player_code_test_1.h"
 #include "player_code/test/player_code_test_2.h"
+#include "player_code/test/player_code_test_3.h"
 #include "player_wrapper/player_code_wrapper.h"
 #include "gtest/gtest.h"
 #include <cstdio>
@@ -260,3 +261,82 @@ TEST_F(LLVMPassTest, DebugLogsTruncated) {
 	log_file.close();
 	EXPECT_EQ(std::remove(this->log_file.c_str()), 0);
 }
+
+// Test to see if optimized counts give the same totals as the naive ones
+TEST_F(LLVMPassTest, OptimizedCountsMatchNaive) {
+	unique_ptr<player_wrapper::IPlayerCode> naive_code(new PlayerCode3());
+	unique_ptr<player_wrapper::IPlayerCode> optimized_code(
+	    new PlayerCode3Optimized());
+
+	// Different amounts of gold give different trip counts
+	for (int64_t gold : {0, 1, 7, 1000}) {
+		player_state::State state;
+		state.gold = gold;
+
+		PlayerDriver::ResetCount();
+		auto naive_state = naive_code->Update(state);
+		auto naive_count = PlayerDriver::GetCount();
+
+		PlayerDriver::ResetCount();
+		auto optimized_state = optimized_code->Update(state);
+		auto optimized_count = PlayerDriver::GetCount();
+
+		EXPECT_GT(naive_count, 0);
+		EXPECT_EQ(naive_count, optimized_count) << "With " << gold << " gold";
+		EXPECT_EQ(naive_state.score, optimized_state.score);
+	}
+}
+
+// Test to see if optimized counts are added once for a whole loop
+TEST_F(LLVMPassTest, OptimizedCountsHoistLoops) {
+	unique_ptr<player_wrapper::IPlayerCode> naive_code(new PlayerCode3());
+	unique_ptr<player_wrapper::IPlayerCode> optimized_code(
+	    new PlayerCode3Optimized());
+
+	// Gets how many times the code adds to the count in a turn
+	auto get_num_increment_calls = [](player_wrapper::IPlayerCode &code,
+	                                  int64_t gold) {
+		player_state::State state;
+		state.gold = gold;
+		PlayerDriver::ResetCount();
+		code.Update(state);
+		return static_cast<int64_t>(PlayerDriver::GetNumIncrementCalls());
+	};
+
+	// Only the call mode adds to the count through IncrementCount
+	if (get_num_increment_calls(*naive_code, 0) == 0) {
+		return;
+	}
+
+	// The extra gold runs the loop over the gold a thousand more times, and
+	// the halving loop 4 more times. Counted per block, every iteration adds
+	// to the count. Hoisted, the loop over the gold adds to it once.
+	auto naive_extra_calls = get_num_increment_calls(*naive_code, 1100) -
+	                         get_num_increment_calls(*naive_code, 100);
+	auto optimized_extra_calls =
+	    get_num_increment_calls(*optimized_code, 1100) -
+	    get_num_increment_calls(*optimized_code, 100);
+	EXPECT_GE(naive_extra_calls, 1000);
+	EXPECT_LT(optimized_extra_calls, 100);
+}
+
+// Test to see if the player is stopped as soon as it goes past the limit
+TEST_F(LLVMPassTest, InstructionLimitExceeded) {
+	SetPlayerDriver<PlayerCode0>(2, 1000, 0);
+
+	buf->instruction_counter = 0;
+	buf->instruction_limit = 1000;
+	buf->is_player_running = true;
+
+	// PlayerCode0 runs for millions of instructions, so the player must exit
+	// midway through its first turn
+	auto exit_code = PlayerDriver::exceeded_instruction_limit_exit_code;
+	EXPECT_EXIT(driver->Start(), ExitedWithCode(exit_code), "");
+
+	// The count and turn are still handed back to the main driver
+	EXPECT_FALSE(buf->is_player_running);
+	EXPECT_GT(buf->instruction_counter, 1000);
+
+	// Delete log file
+	EXPECT_EQ(std::remove(this->log_file.c_str()), 0);
+}
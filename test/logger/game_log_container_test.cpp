@@ -0,0 +1,197 @@
+#include "logger/block_compression.h"
+#include "logger/game_log_container.h"
+#include "logger/game_log_stream.h"
+#include "gtest/gtest.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace logger;
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::util::MessageDifferencer;
+
+class GameLogContainerTest : public testing::Test {
+  protected:
+	proto::Game game;
+
+	// Logs a game in which a few soldiers walk about and fight, and factories
+	// are built, damaged and destroyed along the way
+	GameLogContainerTest() {
+		game.set_map_size(5);
+		game.set_soldier_max_hp(100);
+		game.set_winner(proto::PLAYER2);
+		(*game.mutable_error_map())[0] = "INVALID_MOVE_POSITION: Error";
+
+		for (int turn = 0; turn < 250; ++turn) {
+			auto *state = game.add_states();
+			state->add_gold(turn);
+			state->add_gold(2 * turn);
+
+			for (int id = turn / 50; id < 10; ++id) {
+				auto *soldier = state->add_soldiers();
+				soldier->set_id(id);
+				soldier->set_player_id(id % 2);
+				soldier->set_hp(100 - turn / 10);
+				soldier->set_x((turn + id) % 20);
+				soldier->set_y(id);
+				soldier->set_state(turn % 7 == 0 ? proto::SOLDIER_ATTACK
+				                                 : proto::SOLDIER_MOVE);
+				soldier->set_target_x(turn % 7 == 0 ? id : -1);
+				soldier->set_target_y(-1);
+			}
+
+			// A factory is built every 40 turns, hit 15 turns later and
+			// destroyed 60 turns after it's built
+			auto built = turn / 40;
+			if (turn % 40 == 0) {
+				auto *factory = state->add_factories();
+				factory->set_id(100 + built);
+				factory->set_player_id(built % 2);
+				factory->set_hp(500);
+				factory->set_x(built);
+				factory->set_y(1);
+				factory->set_state(proto::FACTORY_UNBUILT);
+			}
+			if (turn % 40 == 15) {
+				auto *factory = state->add_factories();
+				factory->set_id(100 + built);
+				factory->set_player_id(built % 2);
+				factory->set_hp(400);
+				factory->set_build_percent(100);
+				factory->set_state(proto::FACTORY_IDLE);
+			}
+			if (turn % 40 == 20 && turn > 40) {
+				auto *factory = state->add_factories();
+				factory->set_id(100 + built - 1);
+				factory->set_state(proto::FACTORY_DESTROYED);
+			}
+		}
+	}
+};
+
+// A container reads back into exactly the game that was written
+TEST_F(GameLogContainerTest, ReadsBackWholeGame) {
+	ostringstream container;
+	WriteGameLogContainer(game, container, 32);
+
+	auto whole = game.SerializeAsString();
+	ASSERT_LT(container.str().size(), whole.size() / 4);
+
+	istringstream input(container.str());
+	auto read_game = proto::Game{};
+	ASSERT_TRUE(ReadGameLog(input, read_game));
+	ASSERT_TRUE(MessageDifferencer::Equals(game, read_game));
+}
+
+// A range of turns is the same as in the game, but starts with every factory
+TEST_F(GameLogContainerTest, ReadsTurnRange) {
+	ostringstream container;
+	WriteGameLogContainer(game, container, 32);
+	istringstream input(container.str());
+
+	GameLogContainerReader reader(input);
+	ASSERT_TRUE(reader.Open());
+	ASSERT_EQ(reader.GetNumTurns(), 250);
+
+	auto range = proto::Game{};
+	ASSERT_TRUE(reader.ReadTurns(130, 60, range));
+	ASSERT_EQ(range.states_size(), 60);
+	ASSERT_EQ(range.winner(), proto::PLAYER2);
+	ASSERT_EQ(range.error_map().at(0), "INVALID_MOVE_POSITION: Error");
+
+	for (int i = 1; i < 60; ++i) {
+		ASSERT_TRUE(
+		    MessageDifferencer::Equals(game.states(130 + i), range.states(i)));
+	}
+
+	// By turn 130, only the factories built on turns 80 and 120 are left, and
+	// only the first of them has been hit
+	auto const &first = range.states(0);
+	ASSERT_EQ(first.soldiers_size(), game.states(130).soldiers_size());
+	ASSERT_EQ(first.gold(1), 260);
+	ASSERT_EQ(first.factories_size(), 2);
+	ASSERT_EQ(first.factories(0).id(), 102);
+	ASSERT_EQ(first.factories(0).hp(), 400);
+	ASSERT_EQ(first.factories(0).x(), 2);
+	ASSERT_EQ(first.factories(0).state(), proto::FACTORY_IDLE);
+	ASSERT_EQ(first.factories(1).id(), 103);
+	ASSERT_EQ(first.factories(1).hp(), 500);
+
+	ASSERT_FALSE(reader.ReadTurns(200, 51, range));
+}
+
+// An index that points past the file is an error, rather than an allocation
+// of whatever size it says
+TEST_F(GameLogContainerTest, RejectsCorruptIndex) {
+	ostringstream container;
+	WriteGameLogContainer(game, container, 32);
+	auto const data = container.str();
+
+	uint64_t index_offset;
+	CodedInputStream::ReadLittleEndian64FromArray(
+	    reinterpret_cast<const uint8_t *>(&data[data.size() - 16]),
+	    &index_offset);
+
+	// The index starts with the header block's offset, stored size and size.
+	// Each of the sizes is replaced with one far larger than the file.
+	for (int field = 1; field <= 2; ++field) {
+		CodedInputStream index(
+		    reinterpret_cast<const uint8_t *>(&data[index_offset]),
+		    (int)(data.size() - index_offset));
+		uint64_t value;
+		for (int i = 0; i < field; ++i) {
+			ASSERT_TRUE(index.ReadVarint64(&value));
+		}
+		auto start = index_offset + index.CurrentPosition();
+		ASSERT_TRUE(index.ReadVarint64(&value));
+		auto end = index_offset + index.CurrentPosition();
+
+		uint8_t huge[10];
+		auto huge_end =
+		    CodedOutputStream::WriteVarint64ToArray(uint64_t(1) << 60, huge);
+		auto corrupt = data;
+		corrupt.replace(start, end - start, reinterpret_cast<char *>(huge),
+		                huge_end - huge);
+
+		istringstream input(corrupt);
+		GameLogContainerReader reader(input);
+		ASSERT_FALSE(reader.Open());
+	}
+}
+
+// Blocks come back byte for byte, including ones that don't compress
+TEST(BlockCompressionTest, RoundTrip) {
+	auto inputs = vector<string>{"", "short", string(100000, 'a')};
+
+	auto mixed = string{};
+	uint32_t seed = 1;
+	for (int i = 0; i < 100000; ++i) {
+		seed = seed * 1103515245 + 12345;
+		mixed.push_back(i % 1000 < 500 ? (char)(seed >> 24) : (char)(i % 7));
+	}
+	inputs.push_back(mixed);
+
+	for (auto const &input : inputs) {
+		auto compressed = string{};
+		CompressBlock(input, compressed);
+		auto output = string{};
+		ASSERT_TRUE(DecompressBlock(compressed.data(), compressed.size(),
+		                            input.size(), output));
+		ASSERT_EQ(output, input);
+
+		// Malformed blocks are caught rather than read past
+		if (!input.empty()) {
+			ASSERT_FALSE(DecompressBlock(compressed.data(),
+			                             compressed.size() - 1, input.size(),
+			                             output));
+		}
+	}
+
+	// Runs compress well
+	auto compressed = string{};
+	CompressBlock(inputs[2], compressed);
+	ASSERT_LT(compressed.size(), inputs[2].size() / 100);
+}
@@ -1,9 +1,12 @@
 #include "constants/constants.h"
+#include "logger/async_logger.h"
+#include "logger/game_log_stream.h"
 #include "logger/logger.h"
 #include "simulator_constants/constants.h"
 #include "state/mocks/command_taker_mock.h"
 #include "state/utilities.h"
 #include "gtest/gtest.h"
+#include <google/protobuf/util/message_differencer.h>
 #include <sstream>
 
 using namespace std;
@@ -197,15 +200,11 @@ TEST_F(LoggerTest, WriteReadTest) {
 	logger->LogInstructionCount(PlayerId::PLAYER1, inst_counts[0]);
 	logger->LogInstructionCount(PlayerId::PLAYER2, inst_counts[1]);
 
-	// Log some errors for the first turn
-	logger->LogError(PlayerId::PLAYER1, ErrorType::INVALID_MOVE_POSITION,
-	                 "Error 1");
-	logger->LogError(PlayerId::PLAYER1, ErrorType::INVALID_MOVE_POSITION,
-	                 "Error 2");
-	logger->LogError(PlayerId::PLAYER2, ErrorType::INVALID_MOVE_POSITION,
-	                 "Error 3");
-	logger->LogError(PlayerId::PLAYER2, ErrorType::INVALID_MOVE_POSITION,
-	                 "Error 4");
+	// Log some errors for the first turn, one of them twice
+	logger->LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_INVALID_MOVE);
+	logger->LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_INVALID_MOVE);
+	logger->LogError(PlayerId::PLAYER2, ErrorMessage::INSUFFICIENT_FUNDS);
+	logger->LogError(PlayerId::PLAYER2, ErrorMessage::INSUFFICIENT_FUNDS);
 
 	// Run 3 turns
 	logger->LogState();
@@ -271,26 +270,36 @@ TEST_F(LoggerTest, WriteReadTest) {
 	ASSERT_EQ(game->states(1).instruction_counts(0), 0);
 
 	// Check if the errors got logged on the first turn
-	// Error codes should increment from 0
+	// Errors are logged in the order of their codes
 	// Player 1 errors
 	ASSERT_EQ(game->states(0).player_errors(0).errors_size(), 2);
-	ASSERT_EQ(game->states(0).player_errors(0).errors(0), 0);
-	ASSERT_EQ(game->states(0).player_errors(0).errors(1), 1);
-	// Player 2 errors
+	ASSERT_EQ(game->states(0).player_errors(0).errors(0),
+	          (int64_t)ErrorMessage::SOLDIER_INVALID_MOVE);
+	ASSERT_EQ(game->states(0).player_errors(0).errors(1),
+	          (int64_t)ErrorMessage::VILLAGER_INVALID_MOVE);
+	// Player 2 errors, with the repeated error logged as many times
 	ASSERT_EQ(game->states(0).player_errors(1).errors_size(), 2);
-	ASSERT_EQ(game->states(0).player_errors(1).errors(0), 2);
-	ASSERT_EQ(game->states(0).player_errors(1).errors(1), 3);
+	ASSERT_EQ(game->states(0).player_errors(1).errors(0),
+	          (int64_t)ErrorMessage::INSUFFICIENT_FUNDS);
+	ASSERT_EQ(game->states(0).player_errors(1).errors(1),
+	          (int64_t)ErrorMessage::INSUFFICIENT_FUNDS);
 
-	// Check if the mapping got set and the message string matches
+	// Ensure errors are cleared on next turn
+	ASSERT_EQ(game->states(1).player_errors(0).errors_size(), 0);
+	ASSERT_EQ(game->states(1).player_errors(1).errors_size(), 0);
+
+	// Check if the mapping has every error and the message string matches
 	auto error_map = *game->mutable_error_map();
+	ASSERT_EQ(error_map.size(), NUM_ERROR_MESSAGES);
 	ASSERT_EQ(error_map[game->states(0).player_errors(0).errors(0)],
-	          "INVALID_MOVE_POSITION: Error 1");
+	          "INVALID_MOVE_POSITION: Soldier trying to move to invalid "
+	          "location");
 	ASSERT_EQ(error_map[game->states(0).player_errors(0).errors(1)],
-	          "INVALID_MOVE_POSITION: Error 2");
+	          "INVALID_MOVE_POSITION: Villager cannot move to invalid "
+	          "position");
 	ASSERT_EQ(error_map[game->states(0).player_errors(1).errors(0)],
-	          "INVALID_MOVE_POSITION: Error 3");
-	ASSERT_EQ(error_map[game->states(0).player_errors(1).errors(1)],
-	          "INVALID_MOVE_POSITION: Error 4");
+	          "INSUFFICIENT_FUNDS: You do not have sufficient gold to "
+	          "construct a factory");
 
 	// Check if both factories are there in the first turn
 	ASSERT_EQ(game->states(0).factories(0).id(), factory->GetActorId());
@@ -356,3 +365,175 @@ TEST_F(LoggerTest, WriteReadTest) {
 	delete factory4;
 	delete factory5;
 }
+
+// A streamed log reads back into the same game as a log written as a whole
+TEST_F(LoggerTest, StreamedLogMatchesWholeLog) {
+	Actor::SetActorIdIncrement(0);
+
+	auto soldier = make_unique<Soldier>(
+	    Actor::GetNextActorId(), PlayerId::PLAYER1, ActorType::SOLDIER,
+	    SOLDIER_MAX_HP, SOLDIER_MAX_HP, DoubleVec2D(1, 1), gold_manager.get(),
+	    score_manager.get(), path_planner.get(), 10, 10, 10);
+	auto factory = make_unique<Factory>(
+	    Actor::GetNextActorId(), PlayerId::PLAYER2, ActorType::FACTORY, 1,
+	    FACTORY_MAX_HP, DoubleVec2D(3, 3), gold_manager.get(),
+	    score_manager.get(), 0, 100, ActorType::VILLAGER, villager_frequency,
+	    soldier_frequency, UnitProductionCallback());
+
+	std::array<vector<Soldier *>, 2> soldiers{{{soldier.get()}, {}}};
+	std::array<vector<Factory *>, 2> factories{{{}, {factory.get()}}};
+
+	EXPECT_CALL(*state, GetMap()).WillRepeatedly(Return(map.get()));
+	EXPECT_CALL(*state, GetSoldiers()).WillRepeatedly(Return(soldiers));
+	EXPECT_CALL(*state, GetVillagers())
+	    .WillRepeatedly(Return(std::array<vector<Villager *>, 2>{}));
+	EXPECT_CALL(*state, GetFactories()).WillRepeatedly(Return(factories));
+	EXPECT_CALL(*state, GetGold())
+	    .WillRepeatedly(Return(std::array<int64_t, 2>{{400, 500}}));
+	EXPECT_CALL(*state, GetScores(_))
+	    .WillRepeatedly(Return(std::array<int64_t, 2>{{100, 200}}));
+
+	auto streaming_logger = make_unique<Logger>(
+	    state.get(), PLAYER_INSTRUCTION_LIMIT_TURN,
+	    PLAYER_INSTRUCTION_LIMIT_GAME, SOLDIER_MAX_HP, VILLAGER_MAX_HP,
+	    FACTORY_MAX_HP, true);
+
+	ostringstream whole_stream, streamed_stream;
+	logger->BeginGame(whole_stream);
+	streaming_logger->BeginGame(streamed_stream);
+
+	// Log the same turns to both, with the factory taking damage
+	auto streamed_size = streamed_stream.str().size();
+	for (int turn = 0; turn < 5; ++turn) {
+		for (auto *l : {logger.get(), streaming_logger.get()}) {
+			l->LogInstructionCount(PlayerId::PLAYER1, 100 + turn);
+			l->LogError(PlayerId::PLAYER2, static_cast<ErrorMessage>(turn % 2));
+			l->LogState();
+		}
+		factory->SetHp(FACTORY_MAX_HP - 10 * (turn + 1));
+
+		// Earlier turns are written out as the game goes on
+		if (turn > 0) {
+			ASSERT_GT(streamed_stream.str().size(), streamed_size);
+		}
+		streamed_size = streamed_stream.str().size();
+	}
+	ASSERT_TRUE(whole_stream.str().empty());
+
+	auto turn_profile =
+	    TurnProfile{{"TURN", 5, 1000, 4000, 4200, true, {900, 1200, 7, 30}},
+	                {"LOG_STATE", 5, 10, 20, 20, false, {}}};
+	for (auto *l : {logger.get(), streaming_logger.get()}) {
+		l->LogTurnProfile(turn_profile);
+		l->LogFinalGameParams(PlayerId::PLAYER2, false, {150, 250});
+	}
+	logger->WriteGame(whole_stream);
+	streaming_logger->WriteGame(streamed_stream);
+
+	// The whole log's turn profile is a field that proto::Game doesn't have
+	proto::Game whole_game, streamed_game;
+	ASSERT_TRUE(whole_game.ParseFromString(whole_stream.str()));
+	whole_game.DiscardUnknownFields();
+	istringstream streamed_input(streamed_stream.str());
+	ASSERT_TRUE(ReadGameLog(streamed_input, streamed_game));
+
+	ASSERT_EQ(streamed_game.states_size(), 5);
+	ASSERT_EQ(streamed_game.states(4).scores(1), 250);
+	ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+	    whole_game, streamed_game));
+
+	// Whole logs can be read the same way
+	proto::Game read_whole_game;
+	istringstream whole_input(whole_stream.str());
+	ASSERT_TRUE(ReadGameLog(whole_input, read_whole_game));
+	read_whole_game.DiscardUnknownFields();
+	ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+	    whole_game, read_whole_game));
+
+	// Both logs keep the turn profile
+	for (auto const &log : {streamed_stream.str(), whole_stream.str()}) {
+		TurnProfile read_turn_profile;
+		istringstream profile_input(log);
+		ASSERT_TRUE(ReadTurnProfile(profile_input, read_turn_profile));
+		ASSERT_EQ(read_turn_profile.size(), 2);
+		EXPECT_EQ(read_turn_profile[1].phase, "LOG_STATE");
+		EXPECT_EQ(read_turn_profile[0].p99_ns, 4000);
+		EXPECT_EQ(read_turn_profile[0].max_ns, 4200);
+		EXPECT_TRUE(read_turn_profile[0].has_counters);
+		EXPECT_EQ(read_turn_profile[0].counters.cache_misses, 7);
+		EXPECT_FALSE(read_turn_profile[1].has_counters);
+	}
+
+	// A log cut short keeps the turns before the cut, but isn't complete
+	auto cut_log = streamed_stream.str();
+	cut_log.resize(cut_log.size() - 1);
+	istringstream cut_input(cut_log);
+	ASSERT_FALSE(ReadGameLog(cut_input, streamed_game));
+	ASSERT_EQ(streamed_game.states_size(), 5);
+}
+
+// Logging off the calling thread gives the same log, even when the log falls
+// behind by more turns than there are buffers
+TEST_F(LoggerTest, AsyncLogMatchesSyncLog) {
+	Actor::SetActorIdIncrement(0);
+
+	auto villager = make_unique<Villager>(
+	    Actor::GetNextActorId(), PlayerId::PLAYER1, ActorType::VILLAGER,
+	    VILLAGER_MAX_HP, VILLAGER_MAX_HP, DoubleVec2D(1, 2), gold_manager.get(),
+	    score_manager.get(), path_planner.get(), 10, 10, 10, 10, 10, 10);
+	auto factory = make_unique<Factory>(
+	    Actor::GetNextActorId(), PlayerId::PLAYER2, ActorType::FACTORY, 1,
+	    FACTORY_MAX_HP, DoubleVec2D(3, 3), gold_manager.get(),
+	    score_manager.get(), 0, 100, ActorType::VILLAGER, villager_frequency,
+	    soldier_frequency, UnitProductionCallback());
+
+	std::array<vector<Villager *>, 2> villagers{{{villager.get()}, {}}};
+	std::array<vector<Factory *>, 2> factories{{{}, {factory.get()}}};
+
+	EXPECT_CALL(*state, GetMap()).WillRepeatedly(Return(map.get()));
+	EXPECT_CALL(*state, GetSoldiers())
+	    .WillRepeatedly(Return(std::array<vector<Soldier *>, 2>{}));
+	EXPECT_CALL(*state, GetVillagers()).WillRepeatedly(Return(villagers));
+	EXPECT_CALL(*state, GetFactories()).WillRepeatedly(Return(factories));
+	EXPECT_CALL(*state, GetGold())
+	    .WillRepeatedly(Return(std::array<int64_t, 2>{{400, 500}}));
+	EXPECT_CALL(*state, GetScores(_))
+	    .WillRepeatedly(Return(std::array<int64_t, 2>{{100, 200}}));
+
+	auto async_logger = make_unique<AsyncLogger>(
+	    make_unique<Logger>(state.get(), PLAYER_INSTRUCTION_LIMIT_TURN,
+	                        PLAYER_INSTRUCTION_LIMIT_GAME, SOLDIER_MAX_HP,
+	                        VILLAGER_MAX_HP, FACTORY_MAX_HP),
+	    2);
+
+	auto loggers = vector<ILogger *>{logger.get(), async_logger.get()};
+
+	ostringstream sync_stream, async_stream;
+	logger->BeginGame(sync_stream);
+	async_logger->BeginGame(async_stream);
+
+	// The state changes right after every turn is logged
+	for (int turn = 0; turn < 20; ++turn) {
+		for (auto *l : loggers) {
+			l->LogInstructionCount(PlayerId::PLAYER2, 100 + turn);
+			l->LogError(PlayerId::PLAYER1, static_cast<ErrorMessage>(turn % 3));
+			l->LogState();
+		}
+		villager->SetHp(VILLAGER_MAX_HP - turn - 1);
+		factory->SetHp(FACTORY_MAX_HP - 10 * (turn / 5 + 1));
+	}
+
+	for (auto *l : loggers) {
+		l->LogFinalGameParams(PlayerId::PLAYER1, true, {300, 50});
+	}
+	logger->WriteGame(sync_stream);
+	async_logger->WriteGame(async_stream);
+
+	proto::Game sync_game, async_game;
+	ASSERT_TRUE(sync_game.ParseFromString(sync_stream.str()));
+	ASSERT_TRUE(async_game.ParseFromString(async_stream.str()));
+	ASSERT_EQ(async_game.states_size(), 20);
+	ASSERT_EQ(async_game.states(19).villagers(0).hp(), VILLAGER_MAX_HP - 19);
+	ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+	    sync_game, async_game));
+}
@@ -16,11 +16,19 @@ using namespace state;
 
 class LoggerMock : public ILogger {
   public:
+	MOCK_METHOD1(BeginGame, void(std::ostream &));
 	MOCK_METHOD0(LogState, void());
 	MOCK_METHOD2(LogInstructionCount, void(PlayerId, int64_t));
-	MOCK_METHOD3(LogError, void(PlayerId, ErrorType, string));
+	MOCK_METHOD2(LogError, void(PlayerId, ErrorMessage));
+	MOCK_METHOD1(LogTurnProfile, void(const TurnProfile &));
 	MOCK_METHOD3(LogFinalGameParams,
 	             void(PlayerId player_id, bool was_deathmatch,
 	                  std::array<int64_t, 2> final_scores));
 	MOCK_METHOD1(WriteGame, void(std::ostream &));
+	MOCK_CONST_METHOD0(GetLogBytes, int64_t());
+
+	LoggerMock() {
+		// Memory is measured every turn, which tests needn't expect
+		EXPECT_CALL(*this, GetLogBytes()).Times(::testing::AnyNumber());
+	}
 };
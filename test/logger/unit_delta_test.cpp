@@ -0,0 +1,94 @@
+#include "logger/unit_delta.h"
+#include "gtest/gtest.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace logger;
+using google::protobuf::io::CodedInputStream;
+
+class UnitDeltaTest : public testing::Test {
+  protected:
+	UnitDeltaEncoder encoder;
+	UnitDeltaDecoder decoder;
+
+	// Encodes a turn, checks that it decodes back to the same units, and
+	// returns its encoded size
+	size_t RoundTrip(const vector<UnitRecord> &units) {
+		auto encoded = string{};
+		encoder.Encode(units, encoded);
+
+		CodedInputStream input(
+		    reinterpret_cast<const uint8_t *>(encoded.data()),
+		    encoded.size());
+		auto decoded = vector<UnitRecord>{};
+		EXPECT_TRUE(decoder.Decode(input, decoded));
+		EXPECT_EQ(input.CurrentPosition(), encoded.size());
+
+		EXPECT_EQ(decoded.size(), units.size());
+		for (size_t i = 0; i < units.size() && i < decoded.size(); ++i) {
+			EXPECT_EQ(decoded[i].id, units[i].id);
+			EXPECT_EQ(decoded[i].player_id, units[i].player_id);
+			EXPECT_EQ(decoded[i].hp, units[i].hp);
+			EXPECT_EQ(decoded[i].x, units[i].x);
+			EXPECT_EQ(decoded[i].y, units[i].y);
+			EXPECT_EQ(decoded[i].state, units[i].state);
+			EXPECT_EQ(decoded[i].target_x, units[i].target_x);
+			EXPECT_EQ(decoded[i].target_y, units[i].target_y);
+		}
+
+		return encoded.size();
+	}
+};
+
+// Units coming, going, changing and changing back to 0 all survive the trip
+TEST_F(UnitDeltaTest, RoundTrip) {
+	auto units = vector<UnitRecord>{
+	    {0, 0, 100, 0, 0, 0, -1, -1},
+	    {1, 0, 100, 5, 5, 1, 7, 7},
+	    {2, 1, 100, 9, 9, 0, -1, -1},
+	};
+	RoundTrip(units);
+
+	// Nothing changed, which costs only the end of the turn
+	ASSERT_EQ(RoundTrip(units), 1);
+
+	// Moves, targets dropped, and fields going to 0
+	units[1].x = 6;
+	units[1].target_x = -1;
+	units[1].target_y = -1;
+	units[2].hp = 0;
+	units[2].x = 0;
+	RoundTrip(units);
+
+	// A death in the middle and births at the end
+	units.erase(units.begin() + 1);
+	units.push_back({3, 0, 100, 1, 1, 0, -1, -1});
+	units.push_back({4, 1, 100, 2, 2, 0, -1, -1});
+	RoundTrip(units);
+
+	// Out of order, with a birth in the middle and the rest gone
+	units = {units[3], units[0], {5, 1, 50, 3, 3, 2, 4, 4}};
+	RoundTrip(units);
+
+	// Everything gone, then back
+	RoundTrip({});
+	RoundTrip(units);
+}
+
+// A large army that barely changes takes a few bytes a turn
+TEST_F(UnitDeltaTest, SmallWhenFewChange) {
+	auto units = vector<UnitRecord>{};
+	for (int64_t id = 0; id < 1000; ++id) {
+		units.push_back({id, id % 2, 100, id % 50, id / 50, 0, -1, -1});
+	}
+	auto first_size = RoundTrip(units);
+
+	for (int turn = 0; turn < 10; ++turn) {
+		units[turn * 10].x += 1;
+		units[turn * 10 + 1].hp -= 10;
+		ASSERT_LT(RoundTrip(units), 20);
+	}
+	ASSERT_GT(first_size, 1000);
+}
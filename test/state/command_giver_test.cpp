@@ -278,7 +278,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Making soldiers attack each other and move at the same time
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_SOLDIER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ATTACK_AND_MOVE));
 	this->player_states[0].soldiers[0].target =
 	    this->player_states[0].enemy_soldiers[0].id;
 	this->player_states[0].soldiers[0].destination =
@@ -288,7 +288,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 
 	// Soldier trying to attack soldiers after changing id
 	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1, ErrorType::NO_ALTER_ACTOR_ID, _));
+	            LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ID_ALTERED));
 	this->player_states[0].soldiers[0].id = 69;
 	this->player_states[0].soldiers[0].target =
 	    this->player_states[0].enemy_soldiers[0].id;
@@ -297,7 +297,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 
 	// Soldier trying to attack villagers after changing id
 	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1, ErrorType::NO_ALTER_ACTOR_ID, _));
+	            LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ID_ALTERED));
 	this->player_states[0].soldiers[0].id = 69;
 	this->player_states[0].soldiers[0].target =
 	    this->player_states[0].enemy_villagers[0].id;
@@ -306,7 +306,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 
 	// Soldier trying to attack factories after changing id
 	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1, ErrorType::NO_ALTER_ACTOR_ID, _));
+	            LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ID_ALTERED));
 	state_factories[1].push_back(state_factory2);
 	this->player_states[0].soldiers[0].id = 69;
 	this->player_states[0].soldiers[0].target = state_factory2->GetActorId();
@@ -315,8 +315,9 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	state_factories[1].clear();
 
 	// Soldier trying to attack own soldier
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::NO_ATTACK_SELF_SOLDIER, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ATTACKS_OWN_SOLDIER));
 	EXPECT_CALL(*this->command_taker, FindActorById)
 	    .WillOnce(Return(nullptr))
 	    .WillOnce(Return(state_soldier1));
@@ -326,8 +327,9 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	                        this->player_states, ActorType::SOLDIER);
 
 	// Soldier trying to attack own villager
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::NO_ATTACK_SELF_VILLAGER, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ATTACKS_OWN_VILLAGER));
 	EXPECT_CALL(*this->command_taker, FindActorById)
 	    .WillOnce(Return(nullptr))
 	    .WillOnce(Return(state_villager1));
@@ -337,8 +339,9 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	                        this->player_states, ActorType::SOLDIER);
 
 	// Soldier trying to attack own factory
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::NO_ATTACK_SELF_FACTORY, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_ATTACKS_OWN_FACTORY));
 	state_factories[0].push_back(state_factory1);
 	EXPECT_CALL(*this->command_taker, FindActorById)
 	    .WillOnce(Return(nullptr))
@@ -349,8 +352,9 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	state_factories[0].clear();
 
 	// Soldier trying to move out of the map
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::INVALID_MOVE_POSITION, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::SOLDIER_INVALID_MOVE));
 	this->player_states[0].soldiers[0].destination =
 	    Vec2D(this->map_size * this->ele_size, this->map_size * this->ele_size);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
@@ -360,7 +364,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 
 	// Villager trying to attack soldiers after changing id
 	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1, ErrorType::NO_ALTER_ACTOR_ID, _));
+	            LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_ID_ALTERED));
 	this->player_states[0].villagers[0].id =
 	    this->player_states[0].villagers[0].id + 1;
 	this->player_states[0].villagers[0].target =
@@ -370,7 +374,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 
 	// Villager trying to attack villagers after changing id
 	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1, ErrorType::NO_ALTER_ACTOR_ID, _));
+	            LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_ID_ALTERED));
 	this->player_states[0].villagers[0].id =
 	    this->player_states[0].villagers[0].id + 1;
 	this->player_states[0].villagers[0].target =
@@ -381,7 +385,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to attack factories after changing id
 	state_factories[1].push_back(state_factory2);
 	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1, ErrorType::NO_ALTER_ACTOR_ID, _));
+	            LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_ID_ALTERED));
 	this->player_states[0].villagers[0].id = 69;
 	this->player_states[0].villagers[0].target = state_factory2->GetActorId();
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
@@ -391,7 +395,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to attack and move
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	this->player_states[0].villagers[0].target =
 	    this->player_states[0].enemy_villagers[0].id;
 	this->player_states[0].villagers[0].destination =
@@ -402,7 +406,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to attack and mine gold
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	this->player_states[0].villagers[0].target =
 	    this->player_states[0].enemy_soldiers[0].id;
 	this->player_states[0].villagers[0].mine_target =
@@ -413,7 +417,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to attack and create factory at the same time
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	this->player_states[0].villagers[0].target =
 	    this->player_states[0].enemy_soldiers[0].id;
 	this->player_states[0].villagers[0].build_offset =
@@ -424,7 +428,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to attack and build factory
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	state_factories[0].push_back(state_factory1);
 	this->player_states[0].villagers[0].target =
 	    this->player_states[0].enemy_soldiers[0].id;
@@ -437,7 +441,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to move and mine gold
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	this->player_states[0].villagers[0].destination =
 	    Vec2D(this->ele_size, this->ele_size);
 	this->player_states[0].villagers[0].mine_target =
@@ -448,7 +452,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to move and create factory
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	this->player_states[0].villagers[0].destination =
 	    Vec2D(this->ele_size, this->ele_size);
 	this->player_states[0].villagers[0].build_offset =
@@ -459,7 +463,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to move and build factory
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	state_factories[0].push_back(state_factory1);
 	this->player_states[0].villagers[0].destination =
 	    Vec2D(this->ele_size, this->ele_size);
@@ -472,7 +476,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to mine target and create factory
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	this->player_states[0].villagers[0].mine_target =
 	    Vec2D(this->ele_size, this->ele_size);
 	this->player_states[0].villagers[0].build_offset =
@@ -483,7 +487,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to mine target and build factory
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	state_factories[0].push_back(state_factory1);
 	this->player_states[0].villagers[0].mine_target =
 	    Vec2D(this->ele_size, this->ele_size);
@@ -496,7 +500,7 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	// Villager trying to create factory and build factory
 	EXPECT_CALL(
 	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_MULTIPLE_VILLAGER_TASKS, _));
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_MULTIPLE_TASKS));
 	state_factories[0].push_back(state_factory1);
 	this->player_states[0].villagers[0].build_offset =
 	    Vec2D(this->ele_size, this->ele_size);
@@ -507,25 +511,26 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	state_factories[0].clear();
 
 	// Making villager go out of the map
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::INVALID_MOVE_POSITION, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::VILLAGER_INVALID_MOVE));
 	this->player_states[0].villagers[0].destination =
 	    Vec2D(this->map_size * this->ele_size, this->map_size * this->ele_size);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
 
 	// Making villager create a factory outside map
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::INVALID_BUILD_POSITION, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::INVALID_BUILD_POSITION));
 	this->player_states[0].villagers[0].build_offset =
 	    Vec2D(this->map_size * this->ele_size, this->map_size * this->ele_size);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
 
 	// Making villager create a factory on water
-	EXPECT_CALL(
-	    *this->logger,
-	    LogError(PlayerId::PLAYER1, ErrorType::NO_BUILD_FACTORY_ON_WATER, _));
+	EXPECT_CALL(*this->logger,
+	            LogError(PlayerId::PLAYER1, ErrorMessage::FACTORY_ON_WATER));
 	// (0, 0) is a water tile
 	this->player_states[0].villagers[0].build_offset = Vec2D(0, 0);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
@@ -537,9 +542,8 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	EXPECT_CALL(*this->command_taker, GetGold)
 	    .WillRepeatedly(Return(player_gold2));
 
-	EXPECT_CALL(
-	    *this->logger,
-	    LogError(PlayerId::PLAYER1, logger::ErrorType::INSUFFICIENT_FUNDS, _));
+	EXPECT_CALL(*this->logger,
+	            LogError(PlayerId::PLAYER1, ErrorMessage::INSUFFICIENT_FUNDS));
 	this->player_states[0].villagers[0].build_offset = Vec2D(3, 0);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
@@ -548,32 +552,34 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	    .WillRepeatedly(Return(this->player_gold)); // Reset player gold
 
 	// Making villagers try and mine outside map
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::INVALID_MINE_POSITION, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::INVALID_MINE_POSITION));
 	this->player_states[0].villagers[0].mine_target =
 	    Vec2D(this->map_size * this->ele_size, this->map_size * this->ele_size);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
 
 	// Making villagers mine land
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::INVALID_MINE_POSITION, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::INVALID_MINE_POSITION));
 	this->player_states[0].villagers[0].mine_target = Vec2D(1, 0);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
 
 	// Making villager mine water
-	EXPECT_CALL(*this->logger, LogError(PlayerId::PLAYER1,
-	                                    ErrorType::INVALID_MINE_POSITION, _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::INVALID_MINE_POSITION));
 	this->player_states[0].villagers[0].mine_target = Vec2D(1, 1);
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
 
 	// Making villager build factory that dosen't exist
-	EXPECT_CALL(*this->logger,
-	            LogError(PlayerId::PLAYER1,
-	                     logger::ErrorType::NO_BUILD_FACTORY_THAT_DOSENT_EXIST,
-	                     _));
+	EXPECT_CALL(
+	    *this->logger,
+	    LogError(PlayerId::PLAYER1, ErrorMessage::FACTORY_DOESNT_EXIST));
 	this->player_states[0].villagers[0].target_factory_id = 69;
 	ManageActorExpectations(state_soldiers, state_villagers, state_factories,
 	                        this->player_states, ActorType::VILLAGER);
@@ -581,9 +587,8 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	/// ----- FACTORY TESTS -----
 
 	// Making a factory change it's actor id
-	EXPECT_CALL(
-	    *this->logger,
-	    LogError(PlayerId::PLAYER1, logger::ErrorType::NO_ALTER_ACTOR_ID, _));
+	EXPECT_CALL(*this->logger,
+	            LogError(PlayerId::PLAYER1, ErrorMessage::FACTORY_ID_ALTERED));
 	state_factories[0].push_back(state_factory1);
 	this->player_states[0].factories.push_back(player_state::Factory{});
 	this->player_states[0].factories[0].id = 69; // Changed id
@@ -593,9 +598,8 @@ TEST_F(CommandGiverTest, CommandExecutionTest) {
 	this->player_states[0].factories.clear();
 
 	// Creating 50 factories to trigger maximum limit on number of factories
-	EXPECT_CALL(
-	    *this->logger,
-	    LogError(PlayerId::PLAYER1, logger::ErrorType::NO_MORE_FACTORIES, _));
+	EXPECT_CALL(*this->logger,
+	            LogError(PlayerId::PLAYER1, ErrorMessage::NO_MORE_FACTORIES));
 	vector<Factory *> state_max_factories;
 	for (int i = 0; i < MAX_NUM_FACTORIES; ++i) {
 		auto new_factory = CreateStateFactory(
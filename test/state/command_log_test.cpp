@@ -0,0 +1,132 @@
+#include "state/command_log.h"
+#include "state/command_recorder.h"
+#include "state/command_replayer.h"
+#include "state/mocks/command_taker_mock.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace state;
+using namespace testing;
+
+class CommandLogTest : public Test {
+  protected:
+	// The state the game is recorded from, owned by the recorder
+	NiceMock<CommandTakerMock> *recorded_state;
+
+	// Stream the recorder writes the log to, owned by the recorder
+	ostringstream *log_stream;
+
+	unique_ptr<CommandRecorder> recorder;
+
+	CommandLogTest() {
+		recorded_state = new NiceMock<CommandTakerMock>;
+		log_stream = new ostringstream;
+		ON_CALL(*recorded_state, GetGold())
+		    .WillByDefault(Return(array<int64_t, 2>{100, 200}));
+
+		// Hashes go in every second turn
+		recorder = make_unique<CommandRecorder>(
+		    unique_ptr<ICommandTaker>(recorded_state),
+		    unique_ptr<ostream>(log_stream), 2);
+	}
+
+	// Plays three turns of commands through the recorder
+	void RecordGame() {
+		recorder->MoveUnit(PlayerId::PLAYER1, 1, Vec2D(10, 20));
+		recorder->AttackActor(PlayerId::PLAYER2, 5, 3);
+		recorder->Update();
+
+		recorder->CreateFactory(PlayerId::PLAYER1, 2, Vec2D(3, 4),
+		                        ActorType::SOLDIER);
+		recorder->BuildFactory(PlayerId::PLAYER2, 6, 7);
+		recorder->MineLocation(PlayerId::PLAYER2, 8, Vec2D(-1, 0));
+		recorder->Update();
+
+		recorder->SetFactoryProduction(PlayerId::PLAYER1, 9,
+		                               ActorType::VILLAGER);
+		recorder->StopOrStartFactory(PlayerId::PLAYER1, 9, true);
+		recorder->Update();
+	}
+};
+
+TEST_F(CommandLogTest, RecorderPassesCommandsOn) {
+	EXPECT_CALL(*recorded_state,
+	            MoveUnit(PlayerId::PLAYER1, 1, Vec2D(10, 20)))
+	    .Times(1);
+	EXPECT_CALL(*recorded_state, Update()).Times(3);
+
+	RecordGame();
+}
+
+TEST_F(CommandLogTest, ReplayGivesTheSameCommands) {
+	RecordGame();
+	auto log = istringstream(log_stream->str());
+
+	NiceMock<CommandTakerMock> replayed_state;
+	ON_CALL(replayed_state, GetGold())
+	    .WillByDefault(Return(array<int64_t, 2>{100, 200}));
+	{
+		InSequence commands;
+		EXPECT_CALL(replayed_state,
+		            MoveUnit(PlayerId::PLAYER1, 1, Vec2D(10, 20)));
+		EXPECT_CALL(replayed_state,
+		            AttackActor(PlayerId::PLAYER2, 5, (ActorId)3));
+		EXPECT_CALL(replayed_state, Update());
+		EXPECT_CALL(replayed_state,
+		            CreateFactory(PlayerId::PLAYER1, 2, Vec2D(3, 4),
+		                          ActorType::SOLDIER));
+		EXPECT_CALL(replayed_state, BuildFactory(PlayerId::PLAYER2, 6, 7));
+		EXPECT_CALL(replayed_state,
+		            MineLocation(PlayerId::PLAYER2, 8, Vec2D(-1, 0)));
+		EXPECT_CALL(replayed_state, Update());
+		EXPECT_CALL(replayed_state,
+		            SetFactoryProduction(PlayerId::PLAYER1, 9,
+		                                 ActorType::VILLAGER));
+		EXPECT_CALL(replayed_state,
+		            StopOrStartFactory(PlayerId::PLAYER1, 9, true));
+		EXPECT_CALL(replayed_state, Update());
+	}
+
+	CommandReplayer replayer(&replayed_state, log);
+	ASSERT_TRUE(replayer.Open());
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::TURN_REPLAYED);
+	}
+	EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::FINISHED);
+	EXPECT_EQ(replayer.GetTurnNo(), 3);
+}
+
+TEST_F(CommandLogTest, ReplayCatchesDivergence) {
+	RecordGame();
+	auto log = istringstream(log_stream->str());
+
+	// The replayed state ends up with different gold, which only the hash on
+	// the second turn shows
+	NiceMock<CommandTakerMock> replayed_state;
+	ON_CALL(replayed_state, GetGold())
+	    .WillByDefault(Return(array<int64_t, 2>{100, 201}));
+
+	CommandReplayer replayer(&replayed_state, log);
+	ASSERT_TRUE(replayer.Open());
+	EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::TURN_REPLAYED);
+	EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::HASH_MISMATCH);
+	EXPECT_EQ(replayer.GetTurnNo(), 2);
+}
+
+TEST_F(CommandLogTest, ReplayCatchesTruncatedLog) {
+	RecordGame();
+	auto contents = log_stream->str();
+	auto log = istringstream(contents.substr(0, contents.size() - 1));
+
+	NiceMock<CommandTakerMock> replayed_state;
+	ON_CALL(replayed_state, GetGold())
+	    .WillByDefault(Return(array<int64_t, 2>{100, 200}));
+
+	CommandReplayer replayer(&replayed_state, log);
+	ASSERT_TRUE(replayer.Open());
+	EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::TURN_REPLAYED);
+	EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::TURN_REPLAYED);
+	EXPECT_EQ(replayer.ReplayTurn(), ReplayStatus::MALFORMED);
+}
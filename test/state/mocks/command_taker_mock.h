@@ -38,4 +38,6 @@ class CommandTakerMock : public ICommandTaker {
 	             void(PlayerId player_id, ActorId factory_id,
 	                  bool should_stop));
 	MOCK_METHOD2(FindActorById, Actor *(PlayerId player_id, ActorId actor_id));
+	MOCK_METHOD0(GetActorBytes, int64_t());
+	MOCK_METHOD0(GetPathCacheBytes, int64_t());
 };
@@ -12,9 +12,24 @@ class StateSyncerMock : public state::IStateSyncer {
 	MOCK_METHOD1(UpdatePlayerStates,
 	             void(std::array<player_state::State, 2> &player_states));
 
+	MOCK_METHOD2(UpdatePlayerState, void(PlayerId player_id,
+	                                     player_state::State &player_state));
+
+	MOCK_METHOD0(LogState, void());
+
 	MOCK_METHOD1(IsGameOver, bool(PlayerId &winner));
 
 	MOCK_METHOD1(GetScores, std::array<int64_t, 2>(bool game_over));
 
 	MOCK_METHOD0(GetInterestingness, int64_t());
+
+	MOCK_METHOD0(GetActorBytes, int64_t());
+
+	MOCK_METHOD0(GetPathCacheBytes, int64_t());
+
+	StateSyncerMock() {
+		// Memory is measured every turn, which tests needn't expect
+		EXPECT_CALL(*this, GetActorBytes()).Times(::testing::AnyNumber());
+		EXPECT_CALL(*this, GetPathCacheBytes()).Times(::testing::AnyNumber());
+	}
 };
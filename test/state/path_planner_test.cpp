@@ -166,3 +166,34 @@ TEST_F(PathPlannerTest, SymmetryTest) {
 
 	ASSERT_EQ(source_to_dest_count, dest_to_source_count);
 }
+
+TEST_F(PathPlannerTest, SharedPathGraphTest) {
+	// A planner reusing another's path graph must take the same path
+
+	// clang-format off
+	auto map_matrix = vector<vector<TerrainType>>{
+		{L, L, L, L, L},
+		{L, L, L, L, L},
+		{L, W, W, W, W},
+		{L, W, L, L, L},
+		{L, L, L, W, L}
+	};
+	// clang-format on
+	InitPathPlanner(map_matrix, ELEMENT_SIZE);
+	auto other_map =
+	    make_unique<Map>(map_matrix, map_matrix.size(), ELEMENT_SIZE);
+	auto other_path_planner =
+	    make_unique<PathPlanner>(other_map.get(), path_planner->GetPathGraph());
+	EXPECT_EQ(other_path_planner->GetPathGraph(), path_planner->GetPathGraph());
+
+	auto map_size = map_matrix.size();
+	auto target =
+	    DoubleVec2D(map_size * ELEMENT_SIZE - 1, map_size * ELEMENT_SIZE - 1);
+	auto pos = DoubleVec2D{0, 0};
+	while (pos != target) {
+		auto other_pos = other_path_planner->GetNextPosition(pos, target, 5);
+		pos = path_planner->GetNextPosition(pos, target, 5);
+		ASSERT_NE(pos, DoubleVec2D::null);
+		EXPECT_EQ(other_pos, pos);
+	}
+}
@@ -0,0 +1,109 @@
+#include "state/path_planner/path_planner.h"
+#include "state/player_state.h"
+#include "gtest/gtest.h"
+#include <memory>
+
+using namespace std;
+using namespace state;
+
+const auto L = TerrainType::LAND;
+const auto W = TerrainType::WATER;
+
+TEST(PathTablesTest, SameAsPathGraph) {
+	// The tables must hold the same paths the units take, with distances
+
+	// clang-format off
+	auto map_matrix = vector<vector<TerrainType>>{
+		{L, L, L, L, L},
+		{L, L, L, L, L},
+		{L, W, W, W, W},
+		{L, W, L, L, L},
+		{L, L, L, W, L}
+	};
+	// clang-format on
+	Map map(map_matrix, map_matrix.size(), ELEMENT_SIZE);
+	auto path_graph = PathPlanner(&map).GetPathGraph();
+	auto path_tables = make_unique<player_state::PathTables>();
+	path_graph->FillPathTables(*path_tables);
+
+	auto state = player_state::State{};
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{4, 4}), -1);
+	state.path_tables = path_tables.get();
+
+	// Down the left side and around the water, without cutting its corners
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{4, 4}), 10);
+	EXPECT_EQ(state.next_step(Vec2D{0, 0}, Vec2D{4, 4}), (Vec2D{1, 0}));
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{1, 4}), 4);
+	EXPECT_EQ(state.path_distance(Vec2D{3, 3}, Vec2D{3, 3}), 0);
+	EXPECT_EQ(state.next_step(Vec2D{3, 3}, Vec2D{3, 3}), Vec2D::null);
+
+	// Water, and offsets off the map, have no paths
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{2, 2}), -1);
+	EXPECT_EQ(state.next_step(Vec2D{2, 2}, Vec2D{0, 0}), Vec2D::null);
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{-1, 0}), -1);
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{0, 5}), -1);
+
+	// Every step is the graph's, and brings the destination one step closer
+	for (int64_t i = 0; i < 25; ++i) {
+		for (int64_t j = 0; j < 25; ++j) {
+			auto source = Vec2D{i / 5, i % 5};
+			auto destination = Vec2D{j / 5, j % 5};
+			auto distance = state.path_distance(source, destination);
+			if (distance <= 0) {
+				continue;
+			}
+			auto next_step = state.next_step(source, destination);
+			EXPECT_EQ(next_step, path_graph->GetNextNode(source, destination));
+			EXPECT_EQ(state.path_distance(next_step, destination),
+			          distance - 1);
+		}
+	}
+}
+
+TEST(PathTablesTest, FlippedForPlayer2) {
+	// Player 2's tables must take and give offsets on its flipped map
+
+	// clang-format off
+	auto map_matrix = vector<vector<TerrainType>>{
+		{L, L, L, L, L},
+		{L, W, W, W, L},
+		{L, L, L, W, L},
+		{W, W, L, W, L},
+		{L, L, L, W, L}
+	};
+	// clang-format on
+	Map map(map_matrix, map_matrix.size(), ELEMENT_SIZE);
+	auto path_graph = PathPlanner(&map).GetPathGraph();
+	auto path_tables = make_unique<player_state::PathTables>();
+	path_graph->FillPathTables(*path_tables, true);
+
+	auto state = player_state::State{};
+	state.path_tables = path_tables.get();
+	auto flip = [](Vec2D offset) { return Vec2D{4 - offset.x, 4 - offset.y}; };
+
+	// Player 2's {0, 0} is the simulator's {4, 4}, from where the path goes up
+	// the right side and around the water to the simulator's {4, 0}
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{0, 4}), 16);
+	EXPECT_EQ(state.next_step(Vec2D{0, 0}, Vec2D{0, 4}), (Vec2D{1, 0}));
+	EXPECT_EQ(state.path_distance(Vec2D{4, 4}, Vec2D{4, 0}), 4);
+	EXPECT_EQ(state.next_step(Vec2D{4, 4}, Vec2D{4, 0}), (Vec2D{4, 3}));
+	EXPECT_EQ(state.path_distance(Vec2D{0, 0}, Vec2D{3, 3}), -1);
+
+	// Every step is the graph's flipped, and brings the destination one step
+	// closer
+	for (int64_t i = 0; i < 25; ++i) {
+		for (int64_t j = 0; j < 25; ++j) {
+			auto source = Vec2D{i / 5, i % 5};
+			auto destination = Vec2D{j / 5, j % 5};
+			auto distance = state.path_distance(source, destination);
+			if (distance <= 0) {
+				continue;
+			}
+			auto next_step = state.next_step(source, destination);
+			EXPECT_EQ(next_step, flip(path_graph->GetNextNode(
+			                         flip(source), flip(destination))));
+			EXPECT_EQ(state.path_distance(next_step, destination),
+			          distance - 1);
+		}
+	}
+}
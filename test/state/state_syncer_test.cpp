@@ -298,15 +298,15 @@ TEST_F(StateSyncerTest, UpdationTest) {
 	EXPECT_CALL(*this->command_taker, GetVillagers())
 	    .WillRepeatedly(Return(villagers));
 	EXPECT_CALL(*this->command_taker, GetFactories())
-	    .Times(5)
+	    .Times(4)
 	    .WillRepeatedly(Return(factories))
 	    .RetiresOnSaturation();
 	EXPECT_CALL(*this->command_taker, GetFactories())
-	    .Times(5)
+	    .Times(4)
 	    .WillRepeatedly(Return(factories2))
 	    .RetiresOnSaturation();
 	EXPECT_CALL(*this->command_taker, GetFactories())
-	    .Times(5)
+	    .Times(4)
 	    .WillRepeatedly(Return(factories3))
 	    .RetiresOnSaturation();
 